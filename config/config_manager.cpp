@@ -4,12 +4,16 @@
 #include <QDebug>
 #include <QCoreApplication>
 #include <QDir>
+#include <QMutexLocker>
 
 QJsonObject ConfigManager::s_config;
 bool ConfigManager::s_loaded = false;
 QString ConfigManager::s_configPath;
+// 爬虫车道线程与 GUI 线程都会读写配置；getter 内可能触发 loadConfig，因此用递归锁
+QRecursiveMutex ConfigManager::s_mutex;
 
 bool ConfigManager::loadConfig(const QString& configPath) {
+    QMutexLocker locker(&s_mutex);
     QString resolved = configPath;
     if (configPath == "config.json") {
         resolved = getConfigFilePath(configPath);
@@ -69,6 +73,7 @@ QString ConfigManager::getConfigFilePath(const QString& hint) {
 }
 
 bool ConfigManager::saveConfig() {
+    QMutexLocker locker(&s_mutex);
     QString path = s_configPath;
     if (path.isEmpty()) {
         path = getConfigFilePath();
@@ -87,6 +92,7 @@ bool ConfigManager::saveConfig() {
 }
 
 QString ConfigManager::getZhipinCookie() {
+    QMutexLocker locker(&s_mutex);
     if (!s_loaded) {
         qDebug() << "[ConfigManager] 警告: 配置未加载，尝试自动加载...";
         loadConfig();
@@ -109,6 +115,7 @@ QString ConfigManager::getZhipinCookie() {
 
 
 QString ConfigManager::getNowcodeCookie() {
+    QMutexLocker locker(&s_mutex);
     if (!s_loaded) {
         loadConfig();
     }
@@ -124,10 +131,12 @@ QString ConfigManager::getNowcodeCookie() {
 }
 
 bool ConfigManager::isLoaded() {
+    QMutexLocker locker(&s_mutex);
     return s_loaded;
 }
 
 bool ConfigManager::getSaveAndVectorize(bool defaultValue) {
+    QMutexLocker locker(&s_mutex);
     if (!s_loaded) {
         loadConfig();
     }
@@ -145,6 +154,7 @@ bool ConfigManager::getSaveAndVectorize(bool defaultValue) {
 }
 
 QJsonObject ConfigManager::getEmailSenderConfig() {
+    QMutexLocker locker(&s_mutex);
     if (!s_loaded) loadConfig();
     if (s_config.contains("email") && s_config["email"].isObject()) {
         QJsonObject email = s_config["email"].toObject();
@@ -156,6 +166,7 @@ QJsonObject ConfigManager::getEmailSenderConfig() {
 }
 
 QString ConfigManager::getEmailReceiver() {
+    QMutexLocker locker(&s_mutex);
     if (!s_loaded) loadConfig();
     if (s_config.contains("email") && s_config["email"].isObject()) {
         QJsonObject email = s_config["email"].toObject();
@@ -165,6 +176,7 @@ QString ConfigManager::getEmailReceiver() {
 }
 
 bool ConfigManager::getSendAlert(bool defaultValue) {
+    QMutexLocker locker(&s_mutex);
     if (!s_loaded) loadConfig();
     if (s_config.contains("email") && s_config["email"].isObject()) {
         QJsonObject email = s_config["email"].toObject();
@@ -181,7 +193,40 @@ bool ConfigManager::getSendAlert(bool defaultValue) {
     return defaultValue;
 }
 
+QString ConfigManager::getSqlBackend(const QString &defaultValue) {
+    QMutexLocker locker(&s_mutex);
+    if (!s_loaded) loadConfig();
+    const auto v = s_config.value("sqlBackend");
+    if (v.isString() && !v.toString().trimmed().isEmpty()) {
+        return v.toString().trimmed().toLower();
+    }
+    return defaultValue;
+}
+
+bool ConfigManager::getIncrementalCrawl(bool defaultValue) {
+    QMutexLocker locker(&s_mutex);
+    if (!s_loaded) loadConfig();
+    const QJsonObject incremental = s_config.value("incrementalCrawl").toObject();
+    const auto v = incremental.value("enabled");
+    if (v.isBool()) return v.toBool();
+    if (v.isDouble()) return v.toDouble() != 0.0;
+    if (v.isString()) {
+        QString s = v.toString().toLower();
+        return (s == "1" || s == "true" || s == "yes" || s == "on");
+    }
+    return defaultValue;
+}
+
+int ConfigManager::getKnownPagesToStop(int defaultValue) {
+    QMutexLocker locker(&s_mutex);
+    if (!s_loaded) loadConfig();
+    const QJsonObject incremental = s_config.value("incrementalCrawl").toObject();
+    const int pages = incremental.value("knownPagesToStop").toInt(defaultValue);
+    return pages > 0 ? pages : defaultValue;
+}
+
 void ConfigManager::setSaveAndVectorize(bool enabled) {
+    QMutexLocker locker(&s_mutex);
     if (!s_loaded && !loadConfig()) {
         s_config = QJsonObject();
         s_configPath = getConfigFilePath();
@@ -191,6 +236,7 @@ void ConfigManager::setSaveAndVectorize(bool enabled) {
 }
 
 void ConfigManager::setSendAlert(bool enabled) {
+    QMutexLocker locker(&s_mutex);
     if (!s_loaded && !loadConfig()) {
         s_config = QJsonObject();
         s_configPath = getConfigFilePath();
@@ -202,6 +248,7 @@ void ConfigManager::setSendAlert(bool enabled) {
 }
 
 void ConfigManager::setEmailReceiver(const QString &receiver) {
+    QMutexLocker locker(&s_mutex);
     if (!s_loaded && !loadConfig()) {
         s_config = QJsonObject();
         s_configPath = getConfigFilePath();
@@ -4,6 +4,7 @@
 #include <QString>
 #include <QJsonObject>
 #include <QJsonDocument>
+#include <QRecursiveMutex>
 
 /**
  * @brief 配置文件管理类
@@ -51,6 +52,12 @@ public:
     static QString getEmailReceiver();
     // Whether to actually send alerts when triggered (default true)
     static bool getSendAlert(bool defaultValue = true);
+    // Storage backend name from "sqlBackend": "qtsql" (default) or "native"
+    static QString getSqlBackend(const QString &defaultValue = "qtsql");
+    // Incremental crawl ("incrementalCrawl": {"enabled", "knownPagesToStop"}): stop a source / city /
+    // recruit type after that many consecutive pages whose jobs are all already stored and unchanged
+    static bool getIncrementalCrawl(bool defaultValue = false);
+    static int getKnownPagesToStop(int defaultValue = 2);
 
     // Mutators for runtime updates from UI
     static void setSaveAndVectorize(bool enabled);
@@ -61,6 +68,7 @@ private:
     static QJsonObject s_config;
     static bool s_loaded;
     static QString s_configPath;
+    static QRecursiveMutex s_mutex;
 };
 
 #endif // CONFIG_MANAGER_H
@@ -3,6 +3,10 @@
 
 #include <QString>
 #include <QVector>
+#include <QMap>
+#include <QVariant>
+#include <QDateTime>
+#include <limits>
 
 /**
  * @file db_types.h
@@ -35,7 +39,7 @@ struct SalaryRange {
 struct JobInfo {
     long long jobId;           // 职位ID（64位）
     QString jobName;           // 职位名称
-    int companyId;             // 公司ID
+    long long companyId;       // 公司ID（64位）
     int recruitTypeId;         // 招聘类型ID (1=校招, 2=实习, 3=社招)
     int cityId;                // 城市ID
     int sourceId;              // 数据来源ID（外键关联Source表）
@@ -53,7 +57,7 @@ struct JobInfo {
 struct JobInfoPrint {
     long long jobId;           // 职位ID（64位）
     QString jobName;           // 职位名称
-    int companyId;             // 公司ID
+    long long companyId;       // 公司ID（64位）
     QString companyName;       // 公司名称（解析自Company表）
     int recruitTypeId;         // 招聘类型ID (1=校招, 2=实习, 3=社招)
     QString recruitTypeName;   // 招聘类型名称（解析自RecruitType）
@@ -68,10 +72,141 @@ struct JobInfoPrint {
     QString createTime;        // 创建时间
     QString updateTime;        // 更新时间
     QString hrLastLoginTime;   // HR最后登录时间
+    qint64 createEpoch = 0;       // 创建时间（秒级 epoch，读自 Job.createEpoch；未知为 0）
+    qint64 updateEpoch = 0;       // 更新时间（同上）
+    qint64 hrLastLoginEpoch = 0;  // HR最后登录时间（同上）
+    long long canonicalJobId = 0; // 近重复分组：所属组的规范职位ID（0 表示自身即规范职位，见 Job.canonicalJobId）
     QVector<int> tagIds;       // 标签ID列表（原始ID）
     QVector<QString> tagNames; // 标签名称列表（解析自JobTag）
 };
 
+// 下推到 SQL 的分页查询条件（语义与 PresenterTask::queryJobsWithPaging 的输入一致）
+struct JobPageQuery {
+    QString query;                                // 单字符串查询（纯数字时按 jobId 精确匹配）
+    QMap<QString, QVector<QString>> fieldFilters; // 字段 -> 候选值（字段间 AND，字段内 OR）
+    QString sortField;                            // 排序字段（空表示按 jobId）
+    bool asc = true;                              // 是否升序
+    int pageSize = 20;                            // 每页条数
+    // keyset 游标：上一页最后一行的 (sortKey, jobId)；hasCursor=false 表示第一页
+    bool hasCursor = false;
+    QVariant afterSortKey;
+    long long afterJobId = 0;
+    bool withTotal = true;                        // 是否同时统计总条数
+};
+
+// 分页查询结果：当前页 + 总数 + 下一页游标
+struct JobPage {
+    QVector<JobInfoPrint> rows;  // 当前页数据
+    int totalCount = -1;         // 满足条件的总条数（withTotal=false 时为 -1）
+    bool hasMore = false;        // 是否还有下一页
+    QVariant lastSortKey;        // 本页最后一行的排序键（作为下一页 afterSortKey）
+    long long lastJobId = 0;     // 本页最后一行的 jobId（作为下一页 afterJobId）
+};
+
+// ==================== 薪资区间筛选 ====================
+// 原始薪资单位随招聘类型不同：实习（recruitTypeId=2）为 元/天，校招 / 社招为 K/月。
+// 区间筛选统一换算为月薪（元/月）后比较：
+// - 下限 = salaryMin，上限 = max(salaryMin, salaryMax)（与 salarySlabId 的取值口径一致）
+// - 上限为 0 视为无薪资信息（面议），不参与任何区间条件
+// 筛选字段（字段内多个值为 OR）：
+// - monthlySalaryMin：值 X，月薪下限 ≥ X
+// - monthlySalaryMax：值 Y，月薪上限 ≤ Y
+// - monthlySalaryOverlap：值 "X-Y"，月薪区间与 [X, Y] 有交集（任一端可省略，如 "8000-"）
+
+// 实习日薪折算月薪的计薪天数
+constexpr double kInternWorkDaysPerMonth = 21.75;
+
+inline double monthlySalary(double value, int recruitTypeId) {
+    return recruitTypeId == 2 ? value * kInternWorkDaysPerMonth : value * 1000.0;
+}
+
+inline bool isSalaryRangeField(const QString &field) {
+    return field == "monthlySalaryMin" || field == "monthlySalaryMax" || field == "monthlySalaryOverlap";
+}
+
+// 一个筛选值换算出的约束：lowMin ≤ 月薪下限 ≤ lowMax 且 highMin ≤ 月薪上限 ≤ highMax（另要求上限 > 0）
+struct SalaryBounds {
+    double lowMin = -std::numeric_limits<double>::infinity();
+    double lowMax = std::numeric_limits<double>::infinity();
+    double highMin = -std::numeric_limits<double>::infinity();
+    double highMax = std::numeric_limits<double>::infinity();
+};
+
+// 区间筛选字段的一个取值 -> 约束；字段未知或取值非法时返回 false（该值不命中任何行）
+inline bool salaryBounds(const QString &field, const QString &value, SalaryBounds *out) {
+    SalaryBounds b;
+    bool ok = false;
+    if (field == "monthlySalaryMin") {
+        b.lowMin = value.trimmed().toDouble(&ok);
+    } else if (field == "monthlySalaryMax") {
+        b.highMax = value.trimmed().toDouble(&ok);
+    } else if (field == "monthlySalaryOverlap") {
+        const int dash = value.indexOf('-');
+        if (dash < 0) return false;
+        const QString left = value.left(dash).trimmed();
+        const QString right = value.mid(dash + 1).trimmed();
+        bool okLo = true, okHi = true;
+        if (!left.isEmpty()) b.highMin = left.toDouble(&okLo);
+        if (!right.isEmpty()) b.lowMax = right.toDouble(&okHi);
+        ok = okLo && okHi;
+    }
+    if (ok) *out = b;
+    return ok;
+}
+
+// low / high 为换算后的月薪下限 / 上限
+inline bool salaryInBounds(double low, double high, const SalaryBounds &b) {
+    return high > 0 && low >= b.lowMin && low <= b.lowMax && high >= b.highMin && high <= b.highMax;
+}
+
+// ==================== 时间列 ====================
+// 时间以本地时间字符串 "yyyy-MM-dd HH:mm:ss" 入库，写入时同时存一份秒级 epoch（Job.createEpoch 等，迁移 10），
+// 排序与时间范围筛选只比较整数；字符串只在显示时由 epoch 格式化。
+
+// 时间字符串（本地时间 "yyyy-MM-dd HH:mm:ss"，或 ISO 8601）-> 秒级 epoch；无法解析为 0
+inline qint64 timeEpoch(const QString &text) {
+    if (text.isEmpty()) return 0;
+    QDateTime dt = QDateTime::fromString(text, "yyyy-MM-dd HH:mm:ss");
+    if (!dt.isValid()) dt = QDateTime::fromString(text, Qt::ISODate);
+    return dt.isValid() ? dt.toSecsSinceEpoch() : 0;
+}
+
+// 秒级 epoch -> 本地时间 "yyyy-MM-dd HH:mm:ss"；0 为空串
+inline QString formatEpoch(qint64 epoch) {
+    return epoch > 0 ? QDateTime::fromSecsSinceEpoch(epoch).toString("yyyy-MM-dd HH:mm:ss") : QString();
+}
+
+// 时间范围筛选字段（值为天数 N，字段内多个值为 OR；时间未知的职位不命中）：
+// - postedWithinDays：createEpoch ≥ now - N 天
+// - hrActiveWithinDays：hrLastLoginEpoch ≥ now - N 天
+inline bool isRecencyField(const QString &field) {
+    return field == "postedWithinDays" || field == "hrActiveWithinDays";
+}
+
+// 天数取值 -> 最早的 epoch；取值非法（非数字或为负）时返回 false
+inline bool recencyCutoff(const QString &value, qint64 now, qint64 *cutoff) {
+    bool ok = false;
+    const double days = value.trimmed().toDouble(&ok);
+    if (!ok || days < 0) return false;
+    *cutoff = now - static_cast<qint64>(days * 86400);
+    return true;
+}
+
+// ==================== 近重复折叠 ====================
+// 同一职位常以不同 jobId 出现在多个来源，入库时按 MinHash + LSH 归入近重复组（见 sqlinterface_dedup.cpp），
+// 组内最早入库的职位为规范职位（canonicalJobId = 0），其余记录规范职位的 jobId。
+// 筛选字段 collapseDuplicates：值 "1" 只保留规范职位（每组一条）；其他取值不做限制
+inline bool isCollapseField(const QString &field) {
+    return field == "collapseDuplicates";
+}
+
+inline bool collapseEnabled(const QVector<QString> &vals) {
+    for (const auto &v : vals) {
+        if (v.trimmed() == "1") return true;
+    }
+    return false;
+}
+
 } // namespace SQLNS
 
 #endif // DB_TYPES_H
@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include <cstdint>
+#include <functional>
 #include <unordered_map>
 
 /**
@@ -34,12 +35,18 @@ struct JobInfo {
     std::string create_time;      // 创建时间 (format: "yyyy-MM-dd hh:mm:ss")
     std::string update_time;      // 更新时间
     std::string hr_last_login;    // HR最后登录时间
-    int company_id;               // 公司ID
+    int64_t company_id;           // 公司ID（字符串键的来源为 stable_synthetic_id）
     std::string company_name;     // 公司名称（来自JSON data.identity.companyName）
     std::vector<std::string> tag_names; // 标签内容列表（来自JSON data.pcTagInfo.jobInfoTagList）
     std::vector<int> tag_ids;     // 标签ID列表（如JSON提供）
+    // 旧版本以 std::hash 生成的 ID（公司ID 当时被截断为 int），仅用于把旧数据重映射到稳定 ID；0 表示无
+    int64_t legacy_info_id = 0;
+    int64_t legacy_company_id = 0;
 };
 
+// 增量爬取时传给解析器的已知职位判定：(岗位ID, job_fingerprint) 已在库中且内容未变时返回 true
+using KnownJobFilter = std::function<bool(int64_t jobId, uint64_t fingerprint)>;
+
 // 招聘类型信息
 struct TypeInfo {
     int type_id;
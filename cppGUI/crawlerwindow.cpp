@@ -15,6 +15,9 @@
 #include <QListWidget>
 #include <QCheckBox>
 #include <QMessageBox>
+#include <QScrollBar>
+#include <QLocale>
+#include <algorithm>
 #include "tasks/presenter_task.h"
 #include "tasks/crawler_task.h"
 #include "db/sqlinterface.h"
@@ -33,6 +36,7 @@ CrawlerWindow::CrawlerWindow(QWidget *parent) : QMainWindow(parent), currentPage
     fieldMap["薪资"] = "salaryMin";
     fieldMap["来源"] = "sourceName";
     fieldMap["Tags"] = "tagNames";
+    fieldMap["发布时间"] = "createTime";
 
     QWidget *central = new QWidget;
     QVBoxLayout *mainLayout = new QVBoxLayout(central);
@@ -47,7 +51,9 @@ CrawlerWindow::CrawlerWindow(QWidget *parent) : QMainWindow(parent), currentPage
     searchButton = new QPushButton("搜索");
     refreshButton = new QPushButton("刷新");
     crawlButton = new QPushButton("爬取");
+    searchStatusLabel = new QLabel;
     topLayout->addWidget(searchLineEdit);
+    topLayout->addWidget(searchStatusLabel);
     topLayout->addWidget(searchButton);
     topLayout->addWidget(refreshButton);
     topLayout->addWidget(crawlButton);
@@ -76,23 +82,51 @@ CrawlerWindow::CrawlerWindow(QWidget *parent) : QMainWindow(parent), currentPage
     connect(sourceFilter, &QPushButton::clicked, this, [this]() { showFilterDialog("sourceName", sourceFilter); });
     filterLayout->addWidget(sourceFilter);
 
+    timeFilter = new QPushButton("时间筛选");
+    connect(timeFilter, &QPushButton::clicked, this, &CrawlerWindow::showTimeFilterDialog);
+    filterLayout->addWidget(timeFilter);
+
+    // 多个来源重复发布的同一职位只显示一条（近重复组的规范职位）
+    collapseCheck = new QCheckBox("合并重复职位");
+    connect(collapseCheck, &QCheckBox::toggled, this, [this](bool checked) {
+        if (checked) {
+            currentFilters["collapseDuplicates"] = { "1" };
+        } else {
+            currentFilters.remove("collapseDuplicates");
+        }
+        onSearchClicked(false);
+    });
+    filterLayout->addWidget(collapseCheck);
+
     clearFilterButton = new QPushButton("清除筛选");
     connect(clearFilterButton, &QPushButton::clicked, this, &CrawlerWindow::onClearFilters);
     filterLayout->addWidget(clearFilterButton);
 
     mainLayout->addLayout(filterLayout);
 
-    // table
-    table = new QTableWidget;
-    table->setColumnCount(8);
-    table->setHorizontalHeaderLabels({"jobId", "工作名称", "招聘类型", "城市", "薪资", "来源", "Tags", "查看"});
-    table->setSortingEnabled(false); // disable auto sort
+    // table：虚拟化视图，行数据由 JobTableModel 按需从快照物化
+    table = new QTableView;
+    tableModel = new JobTableModel(this);
+    table->setModel(tableModel);
+    table->setSortingEnabled(false); // 排序由 PresenterTask 完成
+    table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
     QHeaderView *header = table->horizontalHeader();
     // make columns stretch to fill available width
     header->setSectionResizeMode(QHeaderView::Stretch);
+    // 固定行高，视图无需逐行测量即可定位任意行
+    table->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    table->verticalHeader()->setDefaultSectionSize(34);
     table->setAlternatingRowColors(true);
     table->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
     connect(header, &QHeaderView::sectionClicked, this, &CrawlerWindow::onHeaderClicked);
+    connect(table->verticalScrollBar(), &QScrollBar::valueChanged, this, [this]() { onTableScrolled(); });
+    connect(table, &QTableView::clicked, this, [this](const QModelIndex &index) {
+        if (index.column() == JobTableModel::ColView) showJobDetail(tableModel->jobAt(index.row()));
+    });
+    connect(table, &QTableView::doubleClicked, this, [this](const QModelIndex &index) {
+        if (index.column() != JobTableModel::ColView) showJobDetail(tableModel->jobAt(index.row()));
+    });
     mainLayout->addWidget(table);
 
     // page
@@ -114,6 +148,13 @@ CrawlerWindow::CrawlerWindow(QWidget *parent) : QMainWindow(parent), currentPage
     pageSizeSpin->setValue(pageSize);
     pageLayout->addWidget(pageSizeLabel);
     pageLayout->addWidget(pageSizeSpin);
+    // 快照 / 索引构建进度（仅在构建时显示）
+    buildProgressBar = new QProgressBar;
+    buildProgressBar->setMaximumWidth(240);
+    buildProgressBar->setFormat("建立索引 %v/%m");
+    buildProgressBar->hide();
+    pageLayout->addStretch();
+    pageLayout->addWidget(buildProgressBar);
     mainLayout->addLayout(pageLayout);
 
     setCentralWidget(central);
@@ -163,18 +204,7 @@ CrawlerWindow::CrawlerWindow(QWidget *parent) : QMainWindow(parent), currentPage
         QPushButton#danger:hover {
             background-color: #c0392b;
         }
-        QPushButton#viewCellButton {
-            background: transparent;
-            color: #3498db;
-            border: none;
-            padding: 0 6px;
-            min-height: 0;
-            min-width: 0;
-        }
-        QPushButton#viewCellButton:hover {
-            text-decoration: underline;
-        }
-        QTableWidget {
+        QTableView {
             background: #ffffff;
             border: 1px solid #ecf0f1;
             border-radius: 12px;
@@ -198,7 +228,7 @@ CrawlerWindow::CrawlerWindow(QWidget *parent) : QMainWindow(parent), currentPage
             border-right: 1px solid #e1e6eb;
             color: #000000;
         }
-        QTableWidget::item {
+        QTableView::item {
             padding: 6px;
             color: #000000;
         }
@@ -207,6 +237,31 @@ CrawlerWindow::CrawlerWindow(QWidget *parent) : QMainWindow(parent), currentPage
         }
     )");
 
+    // 查询在后台线程执行；输入停止 250ms 后自动搜索（search-as-you-type）
+    searchTask = new SearchTask(this);
+    buildProgressTimer = new QTimer(this);
+    buildProgressTimer->setInterval(100);
+    connect(buildProgressTimer, &QTimer::timeout, this, &CrawlerWindow::updateBuildProgress);
+    connect(searchTask, &SearchTask::searchStarted, this, [this]() {
+        searchStatusLabel->setText("搜索中...");
+        buildProgressTimer->start();
+    });
+    connect(searchTask, &SearchTask::searchFinished, this, &CrawlerWindow::onSearchFinished);
+    connect(searchTask, &SearchTask::firstPageReady, this, [this](const QVector<SQLNS::JobInfoPrint> &rows) {
+        // 完整结果先到时丢弃预览
+        if (hasFullResult) return;
+        tableModel->setPreviewRows(rows);
+        totalLabel->setText("/ ...");
+    });
+    searchDebounce = new QTimer(this);
+    searchDebounce->setSingleShot(true);
+    searchDebounce->setInterval(250);
+    connect(searchDebounce, &QTimer::timeout, this, [this]() {
+        currentPage = 1;
+        onSearchClicked(false);
+    });
+    connect(searchLineEdit, &QLineEdit::textEdited, this, [this]() { searchDebounce->start(); });
+
     // connect
     connect(searchButton, &QPushButton::clicked, this, [this]() { onSearchClicked(true); });
     connect(refreshButton, &QPushButton::clicked, this, [this]() { onSearchClicked(true); });
@@ -223,10 +278,27 @@ CrawlerWindow::CrawlerWindow(QWidget *parent) : QMainWindow(parent), currentPage
         onSearchClicked(true);
     });
 
-    // Initial load
+    // 渐进加载：先用带 LIMIT 的 SQL 显示首屏，同时在后台构建完整快照与索引，完成后无缝替换
+    SearchRequest firstPage;
+    firstPage.sortField = sortField;
+    firstPage.asc = asc;
+    firstPage.pageSize = pageSize;
+    searchTask->submitFirstPage(firstPage);
     onSearchClicked(true);
 }
 
+void CrawlerWindow::updateBuildProgress() {
+    const TaskNS::BuildProgress progress = PresenterTask::buildProgress();
+    if (progress.running) {
+        buildProgressBar->setRange(0, qMax(progress.total, progress.loaded));
+        buildProgressBar->setValue(progress.loaded);
+        buildProgressBar->show();
+        return;
+    }
+    buildProgressBar->hide();
+    if (!searchTask->isBusy()) buildProgressTimer->stop();
+}
+
 void CrawlerWindow::onCrawlButtonClicked() {
     QDialog dialog(this);
     dialog.setWindowTitle("爬取设置");
@@ -302,35 +374,71 @@ void CrawlerWindow::onCrawlButtonClicked() {
 }
 
 void CrawlerWindow::onSearchClicked(bool refresh) {
-    PresenterTask presenterTask;
-    auto result = presenterTask.queryJobsWithPaging(searchLineEdit->text(), getFieldFilters(), sortField, asc, currentPage, pageSize, refresh);
-    allJobs = result.allData;
-    fillTable(result.pageData);
-    populateFilters(allJobs);
-    pageSpin->setMaximum(result.totalPage);
+    // 显式触发时不再等待防抖
+    searchDebounce->stop();
+    SearchRequest request;
+    request.query = searchLineEdit->text();
+    request.fieldFilters = getFieldFilters();
+    request.sortField = sortField;
+    request.asc = asc;
+    request.page = currentPage;
+    request.pageSize = pageSize;
+    request.refresh = refresh;
+    searchTask->submit(request);
+}
+
+void CrawlerWindow::onSearchFinished(quint64 ticket, const TaskNS::PagingResult &result) {
+    Q_UNUSED(ticket);
+    hasFullResult = true;
+    searchStatusLabel->clear();
+    // 整个命中集合交给模型，滚动即可浏览全部结果；页码只用于定位
+    tableModel->setSelection(result.view);
+    populateFilters(result.facetCounts);
+    pageSpin->blockSignals(true);
+    pageSpin->setMaximum(qMax(result.totalPage, 1));
     pageSpin->setValue(result.currentPage);
+    pageSpin->blockSignals(false);
     totalLabel->setText(QString("/ %1").arg(result.totalPage));
+    table->scrollTo(tableModel->index((result.currentPage - 1) * pageSize, 0), QAbstractItemView::PositionAtTop);
+    onTableScrolled();
 }
 
 void CrawlerWindow::onPrevPage() {
-    if (currentPage > 1) {
-        currentPage--;
-        onSearchClicked(false);
-    }
+    if (currentPage > 1) pageSpin->setValue(currentPage - 1);
 }
 
 void CrawlerWindow::onNextPage() {
-    currentPage++;
-    onSearchClicked(false);
+    if (currentPage < pageSpin->maximum()) pageSpin->setValue(currentPage + 1);
 }
 
 void CrawlerWindow::onPageChanged(int page) {
+    // 结果已全部在模型中，翻页只是滚动到该页首行，不再重新查询
     currentPage = page;
-    onSearchClicked(false);
+    const QModelIndex first = tableModel->index((page - 1) * pageSize, 0);
+    if (first.isValid()) table->scrollTo(first, QAbstractItemView::PositionAtTop);
+}
+
+void CrawlerWindow::onTableScrolled() {
+    const int rows = tableModel->rowCount();
+    if (rows == 0) return;
+    const int first = qMax(table->rowAt(0), 0);
+    int last = table->rowAt(table->viewport()->height() - 1);
+    if (last < 0) last = rows - 1;
+    // 预取视口上下各一屏
+    const int span = last - first + 1;
+    tableModel->prefetch(first - span, last + span);
+
+    const int page = first / pageSize + 1;
+    if (page != currentPage) {
+        currentPage = page;
+        pageSpin->blockSignals(true);
+        pageSpin->setValue(page);
+        pageSpin->blockSignals(false);
+    }
 }
 
 void CrawlerWindow::onHeaderClicked(int logicalIndex) {
-    QString headerText = table->horizontalHeaderItem(logicalIndex)->text();
+    QString headerText = tableModel->headerData(logicalIndex, Qt::Horizontal).toString();
     QString newSortField = fieldMap.value(headerText, "");
     if (newSortField.isEmpty()) return;
     if (sortField == newSortField) {
@@ -339,48 +447,15 @@ void CrawlerWindow::onHeaderClicked(int logicalIndex) {
         sortField = newSortField;
         asc = true;
     }
+    table->horizontalHeader()->setSortIndicatorShown(true);
+    table->horizontalHeader()->setSortIndicator(logicalIndex, asc ? Qt::AscendingOrder : Qt::DescendingOrder);
+    currentPage = 1;
     onSearchClicked(false);
 }
 
-void CrawlerWindow::fillTable(const QVector<SQLNS::JobInfoPrint> &jobs) {
-    table->setRowCount(jobs.size());
-    for (int i = 0; i < jobs.size(); ++i) {
-        const auto &job = jobs[i];
-        table->setItem(i, 0, new QTableWidgetItem(QString::number(job.jobId)));
-        table->setItem(i, 1, new QTableWidgetItem(job.jobName));
-        table->setItem(i, 2, new QTableWidgetItem(job.recruitTypeName));
-        table->setItem(i, 3, new QTableWidgetItem(job.cityName));
-        QString salary = (job.salaryMin == 0) ? "面议" : QString("%1-%2").arg(job.salaryMin).arg(job.salaryMax);
-        table->setItem(i, 4, new QTableWidgetItem(salary));
-        table->setItem(i, 5, new QTableWidgetItem(job.sourceName));
-        QString tags = job.tagNames.mid(0, 3).join(", ");
-        table->setItem(i, 6, new QTableWidgetItem(tags));
-        QPushButton *viewButton = new QPushButton("查看");
-        viewButton->setObjectName("viewCellButton");
-        viewButton->setMinimumWidth(56);
-        viewButton->setMaximumWidth(80);
-        viewButton->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Minimum);
-        connect(viewButton, &QPushButton::clicked, this, [this, job]() { showJobDetail(job); });
-        table->setCellWidget(i, 7, viewButton);
-    }
-}
-
-void CrawlerWindow::populateFilters(const QVector<SQLNS::JobInfoPrint> &jobs) {
-    QSet<QString> salaries, tags, cities, recruitTypes, sources;
-    for (const auto &job : jobs) {
-        // use salarySlabId for filtering
-        salaries.insert(QString::number(job.salarySlabId));
-        for (const auto &tag : job.tagNames) tags.insert(tag);
-        cities.insert(job.cityName);
-        recruitTypes.insert(job.recruitTypeName);
-        sources.insert(job.sourceName);
-    }
-
-    filterOptions["salary"] = salaries;
-    filterOptions["tagNames"] = tags;
-    filterOptions["cityName"] = cities;
-    filterOptions["recruitTypeName"] = recruitTypes;
-    filterOptions["sourceName"] = sources;
+void CrawlerWindow::populateFilters(const QMap<QString, QMap<QString, int>> &counts) {
+    // 计数由 PresenterTask 在分面位图上按当前选择算出（salary 的键为 salarySlabId），打开对话框时无需再遍历职位
+    facetCounts = counts;
 }
 
 QMap<QString, QVector<QString>> CrawlerWindow::getFieldFilters() {
@@ -407,6 +482,39 @@ void CrawlerWindow::showFilterDialog(const QString &field, QPushButton *button)
     searchEdit->setPlaceholderText("搜索...");
     layout->addWidget(searchEdit);
 
+    // 薪资对话框：档位复选之外提供按月薪（元/月，实习日薪已折算）的区间条件，0 表示不限
+    QSpinBox *salaryFromSpin = nullptr;
+    QSpinBox *salaryToSpin = nullptr;
+    QCheckBox *overlapCheck = nullptr;
+    if (field == "salary") {
+        auto makeSpin = [](int value) {
+            QSpinBox *spin = new QSpinBox;
+            spin->setRange(0, 1000000);
+            spin->setSingleStep(1000);
+            spin->setSpecialValueText("不限");
+            spin->setValue(value);
+            return spin;
+        };
+        int from = currentFilters.value("monthlySalaryMin").value(0).toInt();
+        int to = currentFilters.value("monthlySalaryMax").value(0).toInt();
+        const QString overlap = currentFilters.value("monthlySalaryOverlap").value(0);
+        if (!overlap.isEmpty()) {
+            from = overlap.section('-', 0, 0).toInt();
+            to = overlap.section('-', 1, 1).toInt();
+        }
+        salaryFromSpin = makeSpin(from);
+        salaryToSpin = makeSpin(to);
+        overlapCheck = new QCheckBox("与区间有交集即可");
+        overlapCheck->setChecked(!overlap.isEmpty());
+        QHBoxLayout *rangeLayout = new QHBoxLayout;
+        rangeLayout->addWidget(new QLabel("月薪(元)"));
+        rangeLayout->addWidget(salaryFromSpin);
+        rangeLayout->addWidget(new QLabel("至"));
+        rangeLayout->addWidget(salaryToSpin);
+        layout->addLayout(rangeLayout);
+        layout->addWidget(overlapCheck);
+    }
+
     QCheckBox *selectAll = new QCheckBox("全选");
     layout->addWidget(selectAll);
 
@@ -415,11 +523,19 @@ void CrawlerWindow::showFilterDialog(const QString &field, QPushButton *button)
     layout->addWidget(listWidget);
 
     // Populate listWidget with custom widgets (keeps checkboxes visible/stylable)
-    const QSet<QString> &optionsSet = filterOptions.value(field);
-    QStringList optionsList;
-    for (const QString &opt : optionsSet) optionsList << opt;
-    optionsList.sort(Qt::CaseInsensitive);
+    // 按命中数降序、同数按名称排列；已勾选但当前计数为 0 的取值也保留，便于取消
+    QMap<QString, int> counts = facetCounts.value(field);
     QVector<QString> currentChecked = currentFilters.value(field);
+    for (const QString &opt : currentChecked) {
+        if (!counts.contains(opt)) counts.insert(opt, 0);
+    }
+    QStringList optionsList = counts.keys();
+    std::stable_sort(optionsList.begin(), optionsList.end(), [&counts](const QString &a, const QString &b) {
+        const int ca = counts.value(a), cb = counts.value(b);
+        if (ca != cb) return ca > cb;
+        return a.compare(b, Qt::CaseInsensitive) < 0;
+    });
+    const QLocale numberLocale(QLocale::English);
     // helper: convert salary slab id -> human readable label
     auto salaryLabel = [](int slabId) -> QString {
         if (slabId == 0) return QStringLiteral("薪资面议");
@@ -439,19 +555,17 @@ void CrawlerWindow::showFilterDialog(const QString &field, QPushButton *button)
         QWidget *w = new QWidget;
         QHBoxLayout *h = new QHBoxLayout(w);
         h->setContentsMargins(6, 2, 6, 2);
-        QCheckBox *cb = nullptr;
-        // If this is the salary field, show readable label but keep slab id as data
+        // 显示 "北京 (1,234)"，原始取值（salary 为档位 id）放在 value 属性中
+        QString label = option;
         if (field == "salary") {
             bool ok = false;
             int slab = option.toInt(&ok);
-            QString label = ok ? salaryLabel(slab) : option;
-            cb = new QCheckBox(label);
-            cb->setProperty("value", option); // keep original id string
-            cb->setChecked(currentChecked.contains(option));
-        } else {
-            cb = new QCheckBox(option);
-            cb->setChecked(currentChecked.contains(option));
+            if (ok) label = salaryLabel(slab);
         }
+        label += QString(" (%1)").arg(numberLocale.toString(counts.value(option)));
+        QCheckBox *cb = new QCheckBox(label);
+        cb->setProperty("value", option);
+        cb->setChecked(currentChecked.contains(option));
         h->addWidget(cb);
         h->addStretch();
         item->setSizeHint(w->sizeHint());
@@ -488,7 +602,7 @@ void CrawlerWindow::showFilterDialog(const QString &field, QPushButton *button)
     layout->addLayout(buttonLayout);
 
     connect(cancelBtn, &QPushButton::clicked, &dialog, &QDialog::reject);
-    connect(okBtn, &QPushButton::clicked, &dialog, [this, &dialog, listWidget, field]() {
+    connect(okBtn, &QPushButton::clicked, &dialog, [this, &dialog, listWidget, field, salaryFromSpin, salaryToSpin, overlapCheck]() {
         QVector<QString> checked;
         for (int i = 0; i < listWidget->count(); ++i) {
             QListWidgetItem *item = listWidget->item(i);
@@ -496,14 +610,25 @@ void CrawlerWindow::showFilterDialog(const QString &field, QPushButton *button)
             if (!w) continue;
             QCheckBox *cb = w->findChild<QCheckBox *>();
             if (cb && cb->isChecked()) {
-                if (field == "salary" && cb->property("value").isValid()) {
-                    checked.append(cb->property("value").toString());
-                } else {
-                    checked.append(cb->text());
-                }
+                checked.append(cb->property("value").toString());
             }
         }
         currentFilters[field] = checked;
+        if (salaryFromSpin) {
+            // 未勾选"有交集"时：下限 ≥ 起点、上限 ≤ 终点；勾选时：与 [起点, 终点] 有交集
+            currentFilters.remove("monthlySalaryMin");
+            currentFilters.remove("monthlySalaryMax");
+            currentFilters.remove("monthlySalaryOverlap");
+            const int from = salaryFromSpin->value();
+            const int to = salaryToSpin->value();
+            if (overlapCheck->isChecked() && (from > 0 || to > 0)) {
+                currentFilters["monthlySalaryOverlap"] = { QString("%1-%2").arg(from > 0 ? QString::number(from) : QString(),
+                                                                               to > 0 ? QString::number(to) : QString()) };
+            } else {
+                if (from > 0) currentFilters["monthlySalaryMin"] = { QString::number(from) };
+                if (to > 0) currentFilters["monthlySalaryMax"] = { QString::number(to) };
+            }
+        }
         onSearchClicked(false);
         dialog.accept();
     });
@@ -511,6 +636,52 @@ void CrawlerWindow::showFilterDialog(const QString &field, QPushButton *button)
     dialog.exec();
 }
 
+void CrawlerWindow::showTimeFilterDialog() {
+    QDialog dialog(this);
+    dialog.setWindowTitle(timeFilter->text());
+    dialog.setStyleSheet(R"(
+        QDialog { background: #ffffff; }
+        QLabel { color: #000000; }
+        QPushButton { background-color: #3498db; color: #ffffff; border: none; border-radius: 8px; padding: 6px 12px; }
+        QPushButton:hover { background-color: #2980b9; }
+    )");
+    QVBoxLayout *layout = new QVBoxLayout(&dialog);
+
+    // 天数为 0 表示不限；条件由 JobStore 在时间列的排序索引上二分求出
+    auto addDaysRow = [this, layout](const QString &label, const QString &field) {
+        QHBoxLayout *row = new QHBoxLayout;
+        QSpinBox *spin = new QSpinBox;
+        spin->setRange(0, 3650);
+        spin->setSpecialValueText("不限");
+        spin->setSuffix(" 天内");
+        spin->setValue(currentFilters.value(field).value(0).toInt());
+        row->addWidget(new QLabel(label));
+        row->addWidget(spin);
+        layout->addLayout(row);
+        return spin;
+    };
+    QSpinBox *postedSpin = addDaysRow("发布于", "postedWithinDays");
+    QSpinBox *hrActiveSpin = addDaysRow("HR活跃于", "hrActiveWithinDays");
+
+    QDialogButtonBox *buttonBox = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel);
+    layout->addWidget(buttonBox);
+    connect(buttonBox, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+    connect(buttonBox, &QDialogButtonBox::accepted, &dialog, [this, &dialog, postedSpin, hrActiveSpin]() {
+        auto apply = [this](const QString &field, int days) {
+            if (days > 0) {
+                currentFilters[field] = { QString::number(days) };
+            } else {
+                currentFilters.remove(field);
+            }
+        };
+        apply("postedWithinDays", postedSpin->value());
+        apply("hrActiveWithinDays", hrActiveSpin->value());
+        onSearchClicked(false);
+        dialog.accept();
+    });
+    dialog.exec();
+}
+
 void CrawlerWindow::showJobDetail(const SQLNS::JobInfoPrint &job) {
     QDialog dialog(this);
     dialog.setWindowTitle("职位详情");
@@ -522,8 +693,15 @@ void CrawlerWindow::showJobDetail(const SQLNS::JobInfoPrint &job) {
     layout->addWidget(new QLabel(QString("招聘类型: %1").arg(job.recruitTypeName)));
     layout->addWidget(new QLabel(QString("城市: %1").arg(job.cityName)));
     layout->addWidget(new QLabel(QString("来源: %1").arg(job.sourceName)));
+    if (job.canonicalJobId != 0) {
+        layout->addWidget(new QLabel(QString("重复职位: 与职位ID %1 为同一职位").arg(job.canonicalJobId)));
+    }
     layout->addWidget(new QLabel(QString("薪资: %1-%2").arg(job.salaryMin).arg(job.salaryMax)));
-    layout->addWidget(new QLabel(QString("要求: %1").arg(job.requirements)));
+    // 列表数据不含岗位要求，打开详情时按 jobId 读取
+    const QString requirements = job.requirements.isEmpty() ? PresenterTask::jobRequirements(job.jobId) : job.requirements;
+    QLabel *requirementsLabel = new QLabel(QString("要求: %1").arg(requirements));
+    requirementsLabel->setWordWrap(true);
+    layout->addWidget(requirementsLabel);
     layout->addWidget(new QLabel(QString("标签: %1").arg(job.tagNames.join(", "))));
     layout->addWidget(new QLabel(QString("创建时间: %1").arg(job.createTime)));
     layout->addWidget(new QLabel(QString("更新时间: %1").arg(job.updateTime)));
@@ -536,6 +714,10 @@ void CrawlerWindow::showJobDetail(const SQLNS::JobInfoPrint &job) {
 
 void CrawlerWindow::onClearFilters() {
     currentFilters.clear();
+    {
+        const QSignalBlocker blocker(collapseCheck);
+        collapseCheck->setChecked(false);
+    }
     onSearchClicked(false);
 }
 
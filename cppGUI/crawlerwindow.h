@@ -3,16 +3,22 @@
 
 #include <QMainWindow>
 #include <QLineEdit>
-#include <QTableWidget>
+#include <QTableView>
 #include <QComboBox>
 #include <QPushButton>
 #include <QSpinBox>
+#include <QCheckBox>
 #include <QLabel>
 #include <QStandardItemModel>
 #include <QMap>
 #include <QVector>
 #include <QMenu>
+#include <QSet>
 #include "constants/db_types.h"
+#include "jobtablemodel.h"
+#include "tasks/search_task.h"
+#include <QTimer>
+#include <QProgressBar>
 
 class CrawlerWindow : public QMainWindow {
     Q_OBJECT
@@ -21,7 +27,9 @@ public:
     CrawlerWindow(QWidget *parent = nullptr);
 
 private slots:
+    // 提交异步查询（不阻塞界面），结果由 onSearchFinished 应用
     void onSearchClicked(bool refresh = true);
+    void onSearchFinished(quint64 ticket, const TaskNS::PagingResult &result);
     void onCrawlButtonClicked();
     void onPrevPage();
     void onNextPage();
@@ -29,6 +37,8 @@ private slots:
     void onHeaderClicked(int logicalIndex);
     void showJobDetail(const SQLNS::JobInfoPrint &job);
     void showFilterDialog(const QString &field, QPushButton *button);
+    // 发布时间 / HR 活跃时间（N 天内）筛选
+    void showTimeFilterDialog();
     void onClearFilters();
 
 signals:
@@ -38,20 +48,27 @@ protected:
     void closeEvent(QCloseEvent *event) override;
 
 private:
-    void fillTable(const QVector<SQLNS::JobInfoPrint> &jobs);
-    void populateFilters(const QVector<SQLNS::JobInfoPrint> &jobs);
+    // 表格滚动后：预取视口附近的行，并同步页码
+    void onTableScrolled();
+    // 轮询 PresenterTask::buildProgress，更新进度条
+    void updateBuildProgress();
+    void populateFilters(const QMap<QString, QMap<QString, int>> &counts);
     QMap<QString, QVector<QString>> getFieldFilters();
 
     QLineEdit *searchLineEdit;
     QPushButton *searchButton;
     QPushButton *refreshButton;
     QPushButton *crawlButton;
-    QTableWidget *table;
+    QLabel *searchStatusLabel;
+    QTableView *table;
+    JobTableModel *tableModel;
     QPushButton *salaryFilter;
     QPushButton *tagFilter;
     QPushButton *cityFilter;
     QPushButton *recruitTypeFilter;
     QPushButton *sourceFilter;
+    QPushButton *timeFilter;
+    QCheckBox *collapseCheck;
     QPushButton *clearFilterButton;
     QPushButton *prevButton;
     QSpinBox *pageSpin;
@@ -63,10 +80,14 @@ private:
     int pageSize;
     QString sortField;
     bool asc;
-    QVector<SQLNS::JobInfoPrint> allJobs;
     QMap<QString, QString> fieldMap;
     QMap<QString, QVector<QString>> currentFilters;
-    QMap<QString, QSet<QString>> filterOptions;
+    QMap<QString, QMap<QString, int>> facetCounts;   // 字段 -> 取值 -> 命中数
+    SearchTask *searchTask;
+    bool hasFullResult = false;     // 是否已显示过完整快照上的结果（之后不再接受首屏预览）
+    QProgressBar *buildProgressBar; // 快照 / 索引构建进度
+    QTimer *buildProgressTimer;
+    QTimer *searchDebounce;   // 输入防抖：停止输入一段时间后才提交查询
 };
 
 #endif // CRAWLERWINDOW_H
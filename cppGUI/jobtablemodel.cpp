@@ -0,0 +1,91 @@
+#include "jobtablemodel.h"
+#include <QColor>
+
+JobTableModel::JobTableModel(QObject *parent) : QAbstractTableModel(parent) {
+    m_blocks.setMaxCost(kCachedBlocks);
+}
+
+void JobTableModel::setSelection(const JobSelection &selection) {
+    beginResetModel();
+    m_selection = selection;
+    m_preview.clear();
+    m_previewMode = false;
+    m_blocks.clear();
+    endResetModel();
+}
+
+void JobTableModel::setPreviewRows(const QVector<SQLNS::JobInfoPrint> &rows) {
+    beginResetModel();
+    m_selection = JobSelection();
+    m_preview = rows;
+    m_previewMode = true;
+    m_blocks.clear();
+    endResetModel();
+}
+
+int JobTableModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : rowTotal();
+}
+
+int JobTableModel::columnCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+const QVector<SQLNS::JobInfoPrint> *JobTableModel::block(int blockIndex) const {
+    if (QVector<SQLNS::JobInfoPrint> *cached = m_blocks.object(blockIndex)) return cached;
+    // 物化一整块；对于尚未排好的位置，JobSelection 会先接续 top-k 排序（预览行已物化，只做切片）
+    auto *rows = new QVector<SQLNS::JobInfoPrint>(m_previewMode
+        ? m_preview.mid(blockIndex * kBlockRows, kBlockRows)
+        : m_selection.materialize(blockIndex * kBlockRows, kBlockRows));
+    m_blocks.insert(blockIndex, rows);
+    return rows;
+}
+
+void JobTableModel::prefetch(int first, int last) const {
+    first = qMax(first, 0);
+    last = qMin(last, rowTotal() - 1);
+    if (first > last) return;
+    for (int b = first / kBlockRows; b <= last / kBlockRows; ++b) block(b);
+}
+
+SQLNS::JobInfoPrint JobTableModel::jobAt(int row) const {
+    if (row < 0 || row >= rowTotal()) return {};
+    const QVector<SQLNS::JobInfoPrint> *rows = block(row / kBlockRows);
+    return rows->value(row % kBlockRows);
+}
+
+QVariant JobTableModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= rowTotal()) return {};
+    if (role == Qt::ForegroundRole && index.column() == ColView) return QColor("#3498db");
+    if (role != Qt::DisplayRole && role != Qt::ToolTipRole) return {};
+
+    const QVector<SQLNS::JobInfoPrint> *rows = block(index.row() / kBlockRows);
+    const int offset = index.row() % kBlockRows;
+    if (offset >= rows->size()) return {};
+    const SQLNS::JobInfoPrint &job = rows->at(offset);
+
+    switch (index.column()) {
+    case ColJobId: return QString::number(job.jobId);
+    case ColJobName: return job.jobName;
+    case ColRecruitType: return job.recruitTypeName;
+    case ColCity: return job.cityName;
+    case ColSalary:
+        return (job.salaryMin == 0) ? QString("面议") : QString("%1-%2").arg(job.salaryMin).arg(job.salaryMax);
+    case ColSource: return job.sourceName;
+    case ColTags:
+        // 单元格只显示前三个标签，提示中显示全部
+        return role == Qt::ToolTipRole ? job.tagNames.join(", ") : job.tagNames.mid(0, 3).join(", ");
+    case ColPosted:
+        // 时间字符串由块物化时从 epoch 格式化，单元格只显示日期
+        return role == Qt::ToolTipRole ? job.createTime : job.createTime.left(10);
+    case ColView: return role == Qt::DisplayRole ? QVariant(QString("查看")) : QVariant();
+    default: return {};
+    }
+}
+
+QVariant JobTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (role != Qt::DisplayRole) return {};
+    if (orientation == Qt::Vertical) return section + 1;
+    static const QStringList labels = {"jobId", "工作名称", "招聘类型", "城市", "薪资", "来源", "Tags", "发布时间", "查看"};
+    return labels.value(section);
+}
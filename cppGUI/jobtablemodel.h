@@ -0,0 +1,54 @@
+#ifndef JOBTABLEMODEL_H
+#define JOBTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QCache>
+#include <QVector>
+#include <QString>
+#include "presenter/job_store.h"
+#include "constants/db_types.h"
+
+// 职位表格模型：直接以 PresenterTask 返回的 JobSelection（快照 + 行号）为数据源
+// - rowCount 为全部命中数，单元格数据按块（kBlockRows 行）懒物化，LRU 缓存最近的块
+// - 不为行分配任何 QTableWidgetItem / 控件；滚动时由视图调用 prefetch 预取视口附近的块
+// - 排序仍由 PresenterTask 完成（JobStore 预计算排列 + top-k），视图按需接续
+class JobTableModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    enum Column { ColJobId = 0, ColJobName, ColRecruitType, ColCity, ColSalary, ColSource, ColTags, ColPosted, ColView, ColumnCount };
+
+    explicit JobTableModel(QObject *parent = nullptr);
+
+    // 替换数据源（整表重置，丢弃缓存块与预览行）
+    void setSelection(const JobSelection &selection);
+    const JobSelection &selection() const { return m_selection; }
+    // 预览：直接显示已物化的少量行（快照构建完成前的首屏），之后由 setSelection 替换
+    void setPreviewRows(const QVector<SQLNS::JobInfoPrint> &rows);
+    bool isPreview() const { return m_previewMode; }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    // 行 row 对应的职位（详情对话框用）
+    SQLNS::JobInfoPrint jobAt(int row) const;
+    // 预取 [first, last] 覆盖的块（越界部分忽略）
+    void prefetch(int first, int last) const;
+
+private:
+    static constexpr int kBlockRows = 64;
+    static constexpr int kCachedBlocks = 64;
+
+    const QVector<SQLNS::JobInfoPrint> *block(int blockIndex) const;
+
+    int rowTotal() const { return m_previewMode ? m_preview.size() : m_selection.size(); }
+
+    JobSelection m_selection;
+    QVector<SQLNS::JobInfoPrint> m_preview;
+    bool m_previewMode = false;
+    mutable QCache<int, QVector<SQLNS::JobInfoPrint>> m_blocks;
+};
+
+#endif // JOBTABLEMODEL_H
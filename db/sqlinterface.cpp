@@ -6,6 +6,64 @@
 #include <QVariant>
 #include <QDebug>
 #include <QThread>
+#include <QSet>
+#include <atomic>
+
+namespace {
+std::atomic<int> s_backend{static_cast<int>(SQLInterface::Backend::QtSql)};
+std::atomic<int> s_connectionCount{0};
+
+// The current thread's QtSql connection, cached so the hot path never goes
+// through QSqlDatabase::contains()/database() (both lock Qt's global
+// connection registry). Removed from the registry on disconnect() or, at the
+// latest, when the thread exits and this thread_local is destroyed.
+struct ThreadConnection {
+	QString name;
+	QSqlDatabase db;
+
+	~ThreadConnection() { release(); }
+
+	void release() {
+		if (name.isEmpty()) return;
+		const QString connName = name;
+		if (db.isOpen()) db.close();
+		db = QSqlDatabase(); // drop our copy before removeDatabase()
+		name.clear();
+		QSqlDatabase::removeDatabase(connName);
+		--s_connectionCount;
+	}
+};
+
+thread_local ThreadConnection t_connection;
+
+// Registers the current thread's connection on first use (takes the registry lock once per thread)
+QSqlDatabase &threadDatabase() {
+	if (t_connection.name.isEmpty()) {
+		t_connection.name = QStringLiteral("crawler_conn_%1").arg((quintptr)QThread::currentThreadId());
+		t_connection.db = QSqlDatabase::addDatabase("QSQLITE", t_connection.name);
+		++s_connectionCount;
+	}
+	return t_connection.db;
+}
+}
+
+int SQLInterface::connectionCount() {
+	return s_connectionCount.load();
+}
+
+bool SQLInterface::setBackend(Backend backend) {
+	if (backend == Backend::NativeSqlite && !nativeBackendAvailable()) {
+		qDebug() << "Native SQLite backend not built in; keeping QtSql.";
+		s_backend = static_cast<int>(Backend::QtSql);
+		return false;
+	}
+	s_backend = static_cast<int>(backend);
+	return true;
+}
+
+SQLInterface::Backend SQLInterface::backend() {
+	return static_cast<Backend>(s_backend.load());
+}
 
 SQLInterface::SQLInterface() {}
 SQLInterface::~SQLInterface() { disconnect(); }
@@ -15,13 +73,7 @@ bool SQLInterface::openSqliteConnection(const QString &dbFilePath) {
 	// store DB path for lazy per-thread connection creation
 	m_dbFilePath = dbFilePath;
 	// create a connection for the current thread as an initial connection
-	const QString connName = QStringLiteral("crawler_conn_%1").arg((quintptr)QThread::currentThreadId());
-	QSqlDatabase db;
-	if (QSqlDatabase::contains(connName)) {
-		db = QSqlDatabase::database(connName);
-	} else {
-		db = QSqlDatabase::addDatabase("QSQLITE", connName);
-	}
+	QSqlDatabase &db = threadDatabase();
 	db.setDatabaseName(dbFilePath);
 	if (!db.open()) {
 		qDebug() << "SQLite open failed:" << db.lastError().text();
@@ -31,37 +83,90 @@ bool SQLInterface::openSqliteConnection(const QString &dbFilePath) {
 }
 
 bool SQLInterface::connectSqlite(const QString &dbFilePath) {
-	return openSqliteConnection(dbFilePath);
+	if (!openSqliteConnection(dbFilePath)) return false;
+	// QtSql stays open for schema/paging/search; the native handle serves the hot paths
+	m_useNative = backend() == Backend::NativeSqlite && openNativeConnection();
+	return true;
 }
 
 bool SQLInterface::isConnected() const {
 	// Ensure there is a DB file path configured
 	if (m_dbFilePath.isEmpty()) return false;
-	// Attempt to get or create a connection for this thread.
-	// NOTE: databaseForCurrentThread() is non-const; create a temporary non-const pointer to call it.
-	SQLInterface *self = const_cast<SQLInterface*>(this);
-	QSqlDatabase db;
-	try {
-		db = self->databaseForCurrentThread();
-	} catch (...) {
-		return false;
-	}
+	// Reopens the thread's connection lazily if another instance disconnected it
+	const QSqlDatabase db = const_cast<SQLInterface*>(this)->databaseForCurrentThread();
 	return db.isValid() && db.isOpen();
 }
 
 void SQLInterface::disconnect() {
+	if (m_useNative) {
+		closeNativeConnection();
+		m_useNative = false;
+	}
 	// Only remove the connection for the current thread. The previous
 	// implementation removed all connections that matched the prefix,
 	// which could close/remove connections belonging to other threads
 	// while they were still in use.
-	const QString connName = QStringLiteral("crawler_conn_%1").arg((quintptr)QThread::currentThreadId());
-	if (QSqlDatabase::contains(connName)) {
-		{
-			QSqlDatabase db = QSqlDatabase::database(connName);
-			if (db.isOpen()) db.close();
-		}
-		QSqlDatabase::removeDatabase(connName);
+	t_connection.release();
+}
+
+bool SQLInterface::beginTransaction() {
+	if (!isConnected()) return false;
+	if (m_useNative) return nativeExec("BEGIN");
+	QSqlDatabase db = databaseForCurrentThread();
+	if (!db.transaction()) {
+		qDebug() << "Begin transaction failed:" << db.lastError().text();
+		return false;
+	}
+	return true;
+}
+
+bool SQLInterface::commitTransaction() {
+	if (!isConnected()) return false;
+	if (m_useNative) {
+		if (nativeExec("COMMIT")) return true;
+		nativeExec("ROLLBACK");
+		return false;
+	}
+	QSqlDatabase db = databaseForCurrentThread();
+	if (!db.commit()) {
+		qDebug() << "Commit failed:" << db.lastError().text();
+		db.rollback();
+		return false;
+	}
+	return true;
+}
+
+void SQLInterface::rollbackTransaction() {
+	if (!isConnected()) return;
+	if (m_useNative) {
+		nativeExec("ROLLBACK");
+		return;
+	}
+	QSqlDatabase db = databaseForCurrentThread();
+	db.rollback();
+}
+
+qint64 SQLInterface::dataGeneration() {
+	if (!isConnected()) return -1;
+	QSqlDatabase db = databaseForCurrentThread();
+	QSqlQuery q(db);
+	if (q.exec("SELECT value FROM DbMeta WHERE key = 'generation'") && q.next()) {
+		return q.value(0).toLongLong();
+	}
+	return -1;
+}
+
+bool SQLInterface::bumpDataGeneration() {
+	if (!isConnected()) return false;
+	// Same handle as the inserts, so the bump joins an open transaction
+	if (m_useNative) return nativeExec("UPDATE DbMeta SET value = value + 1 WHERE key = 'generation'");
+	QSqlDatabase db = databaseForCurrentThread();
+	QSqlQuery q(db);
+	if (!q.exec("UPDATE DbMeta SET value = value + 1 WHERE key = 'generation'")) {
+		qDebug() << "Bump data generation failed:" << q.lastError().text();
+		return false;
 	}
+	return true;
 }
 
 bool SQLInterface::createAllTables() {
@@ -144,6 +249,10 @@ bool SQLInterface::createAllTables() {
 		" createTime TEXT,"
 		" updateTime TEXT,"
 		" hrLastLoginTime TEXT,"
+		" createEpoch INTEGER,"
+		" updateEpoch INTEGER,"
+		" hrLastLoginEpoch INTEGER,"
+		" canonicalJobId INTEGER NOT NULL DEFAULT 0,"
 		" FOREIGN KEY(sourceId) REFERENCES Source(sourceId)"
 		")")) {
 		qDebug() << "Create Job failed:" << q.lastError().text();
@@ -161,25 +270,9 @@ bool SQLInterface::createAllTables() {
 		return false;
 	}
 
-	// Database migration: Add sourceId column to Job table if not exists
-	if (q.exec("PRAGMA table_info(Job)")) {
-		bool hasSourceId = false;
-		while (q.next()) {
-			QString columnName = q.value(1).toString();
-			if (columnName == "sourceId") {
-				hasSourceId = true;
-				break;
-			}
-		}
-		
-		if (!hasSourceId) {
-			qDebug() << "[Migration] Adding sourceId column to Job table...";
-			if (!q.exec("ALTER TABLE Job ADD COLUMN sourceId INTEGER")) {
-				qDebug() << "Failed to add sourceId column:" << q.lastError().text();
-				return false;
-			}
-			qDebug() << "[Migration] sourceId column added successfully.";
-		}
+	// Versioned migrations (PRAGMA user_version); already-applied steps are skipped
+	if (!runMigrations()) {
+		return false;
 	}
 
 	// Initialize RecruitType enum values if empty
@@ -338,15 +431,16 @@ QVector<SQLNS::Source> SQLInterface::queryEnabledSources() {
 	return sources;
 }
 
-int SQLInterface::insertCompany(int companyId, const QString &companyName) {
+long long SQLInterface::insertCompany(long long companyId, const QString &companyName) {
 	if (!isConnected()) return -1;
+	if (m_useNative) return nativeInsertCompany(companyId, companyName);
 	QSqlDatabase db = databaseForCurrentThread();
 
 	// Insert or ignore if the company already exists (avoid UNIQUE constraint errors)
 	{
 		QSqlQuery q(db);
 		q.prepare("INSERT OR IGNORE INTO Company(companyId, companyName) VALUES(:id, :name)");
-		q.bindValue(":id", companyId);
+		q.bindValue(":id", QVariant::fromValue<qlonglong>(companyId));
 		q.bindValue(":name", companyName);
 		q.exec(); // ignore duplicates silently
 	}
@@ -355,14 +449,14 @@ int SQLInterface::insertCompany(int companyId, const QString &companyName) {
 	if (!companyName.isEmpty()) {
 		QSqlQuery qs(db);
 		qs.prepare("SELECT companyName FROM Company WHERE companyId = :id");
-		qs.bindValue(":id", companyId);
+		qs.bindValue(":id", QVariant::fromValue<qlonglong>(companyId));
 		if (qs.exec() && qs.next()) {
 			const QString existingName = qs.value(0).toString();
 			if (existingName != companyName) {
 				QSqlQuery qu(db);
 				qu.prepare("UPDATE Company SET companyName = :name WHERE companyId = :id");
 				qu.bindValue(":name", companyName);
-				qu.bindValue(":id", companyId);
+				qu.bindValue(":id", QVariant::fromValue<qlonglong>(companyId));
 				qu.exec();
 			}
 			return companyId;
@@ -373,7 +467,7 @@ int SQLInterface::insertCompany(int companyId, const QString &companyName) {
 	{
 		QSqlQuery qv(db);
 		qv.prepare("SELECT companyId FROM Company WHERE companyId = :id");
-		qv.bindValue(":id", companyId);
+		qv.bindValue(":id", QVariant::fromValue<qlonglong>(companyId));
 		if (qv.exec() && qv.next()) {
 			return companyId;
 		}
@@ -384,6 +478,7 @@ int SQLInterface::insertCompany(int companyId, const QString &companyName) {
 
 int SQLInterface::insertCity(const QString &cityName) {
 	if (!isConnected()) return -1;
+	if (m_useNative) return nativeInsertCity(cityName);
 	QSqlDatabase db = databaseForCurrentThread();
 	QSqlQuery q(db);
 	q.prepare("INSERT OR IGNORE INTO JobCity(cityName) VALUES(:name)");
@@ -399,6 +494,7 @@ int SQLInterface::insertCity(const QString &cityName) {
 
 int SQLInterface::insertTag(const QString &tagName) {
 	if (!isConnected()) return -1;
+	if (m_useNative) return nativeInsertTag(tagName);
 	QSqlDatabase db = databaseForCurrentThread();
 	QSqlQuery q(db);
 	q.prepare("INSERT OR IGNORE INTO JobTag(tagName) VALUES(:name)");
@@ -412,19 +508,37 @@ int SQLInterface::insertTag(const QString &tagName) {
 	return -1;
 }
 
-int SQLInterface::insertJob(const SQLNS::JobInfo &job) {
+long long SQLInterface::insertJob(const SQLNS::JobInfo &job) {
 	if (!isConnected()) return -1;
+	if (m_useNative) return nativeInsertJob(job);
 	QSqlDatabase db = databaseForCurrentThread();
 	{
 		QSqlQuery q(db);
+		// A re-crawled job (content changed) overwrites its list fields; createTime and a
+		// non-empty stored requirements text survive, and unchanged rows are not rewritten
+		// (so the FTS / bigram triggers only fire on real changes)
 		q.prepare(
-			"INSERT OR IGNORE INTO Job(jobId, jobName, companyId, recruitTypeId, cityId, sourceId, "
-			"requirements, salaryMin, salaryMax, salarySlabId, createTime, updateTime, hrLastLoginTime) "
+			"INSERT INTO Job(jobId, jobName, companyId, recruitTypeId, cityId, sourceId, "
+			"requirements, salaryMin, salaryMax, salarySlabId, createTime, updateTime, hrLastLoginTime, "
+			"createEpoch, updateEpoch, hrLastLoginEpoch) "
 			"VALUES(:jobId, :jobName, :companyId, :recruitTypeId, :cityId, :sourceId, "
-			":requirements, :salaryMin, :salaryMax, :salarySlabId, :createTime, :updateTime, :hrLastLoginTime)");
+			":requirements, :salaryMin, :salaryMax, :salarySlabId, :createTime, :updateTime, :hrLastLoginTime, "
+			":createEpoch, :updateEpoch, :hrLastLoginEpoch) "
+			"ON CONFLICT(jobId) DO UPDATE SET jobName = excluded.jobName, companyId = excluded.companyId, "
+			"recruitTypeId = excluded.recruitTypeId, cityId = excluded.cityId, sourceId = excluded.sourceId, "
+			"requirements = COALESCE(NULLIF(excluded.requirements, ''), requirements), "
+			"salaryMin = excluded.salaryMin, salaryMax = excluded.salaryMax, salarySlabId = excluded.salarySlabId, "
+			"updateTime = excluded.updateTime, hrLastLoginTime = excluded.hrLastLoginTime, "
+			"updateEpoch = excluded.updateEpoch, hrLastLoginEpoch = excluded.hrLastLoginEpoch "
+			"WHERE jobName IS NOT excluded.jobName OR companyId IS NOT excluded.companyId "
+			"OR recruitTypeId IS NOT excluded.recruitTypeId OR cityId IS NOT excluded.cityId "
+			"OR sourceId IS NOT excluded.sourceId OR salaryMin IS NOT excluded.salaryMin "
+			"OR salaryMax IS NOT excluded.salaryMax OR salarySlabId IS NOT excluded.salarySlabId "
+			"OR updateTime IS NOT excluded.updateTime OR hrLastLoginTime IS NOT excluded.hrLastLoginTime "
+			"OR (excluded.requirements <> '' AND requirements IS NOT excluded.requirements)");
 		q.bindValue(":jobId", QVariant::fromValue<qlonglong>(job.jobId));
 		q.bindValue(":jobName", job.jobName);
-		q.bindValue(":companyId", job.companyId);
+		q.bindValue(":companyId", QVariant::fromValue<qlonglong>(job.companyId));
 		q.bindValue(":recruitTypeId", job.recruitTypeId);
 		q.bindValue(":cityId", job.cityId);
 		q.bindValue(":sourceId", job.sourceId);
@@ -435,6 +549,10 @@ int SQLInterface::insertJob(const SQLNS::JobInfo &job) {
 		q.bindValue(":createTime", job.createTime);
 		q.bindValue(":updateTime", job.updateTime);
 		q.bindValue(":hrLastLoginTime", job.hrLastLoginTime);
+		// epoch columns are derived from the time strings here so every ingest path fills them
+		q.bindValue(":createEpoch", QVariant::fromValue<qlonglong>(SQLNS::timeEpoch(job.createTime)));
+		q.bindValue(":updateEpoch", QVariant::fromValue<qlonglong>(SQLNS::timeEpoch(job.updateTime)));
+		q.bindValue(":hrLastLoginEpoch", QVariant::fromValue<qlonglong>(SQLNS::timeEpoch(job.hrLastLoginTime)));
 		if (!q.exec()) {
 			qDebug() << "Insert Job failed:" << q.lastError().text();
 			qDebug() << "Query:" << q.lastQuery();
@@ -444,13 +562,13 @@ int SQLInterface::insertJob(const SQLNS::JobInfo &job) {
 		}
 	}
 
-	// Ensure the row exists (either newly inserted or pre-existing)
+	// Ensure the row exists (newly inserted, updated or already up to date)
 	{
 		QSqlQuery q2(db);
 		q2.prepare("SELECT jobId FROM Job WHERE jobId = :jobId");
 		q2.bindValue(":jobId", QVariant::fromValue<qlonglong>(job.jobId));
 		if (q2.exec() && q2.next()) {
-			return static_cast<int>(job.jobId);
+			return job.jobId;
 		} else {
 			qDebug() << "Insert Job: verify select failed:" << q2.lastError().text();
 			return -1;
@@ -460,6 +578,7 @@ int SQLInterface::insertJob(const SQLNS::JobInfo &job) {
 
 bool SQLInterface::insertJobTagMapping(long long jobId, int tagId) {
 	if (!isConnected()) return false;
+	if (m_useNative) return nativeInsertJobTagMapping(jobId, tagId);
 	QSqlDatabase db = databaseForCurrentThread();
 	QSqlQuery q(db);
 	q.prepare("INSERT OR IGNORE INTO JobTagMapping(jobId, tagId) VALUES(:jobId, :tagId)");
@@ -468,11 +587,87 @@ bool SQLInterface::insertJobTagMapping(long long jobId, int tagId) {
 	return q.exec();
 }
 
+bool SQLInterface::replaceJobTags(long long jobId, const QVector<int> &tagIds) {
+	if (!isConnected()) return false;
+	if (m_useNative) return nativeReplaceJobTags(jobId, tagIds);
+	QSqlDatabase db = databaseForCurrentThread();
+	QSet<int> stale;
+	{
+		QSqlQuery q(db);
+		q.setForwardOnly(true);
+		q.prepare("SELECT tagId FROM JobTagMapping WHERE jobId = :jobId");
+		q.bindValue(":jobId", QVariant::fromValue<qlonglong>(jobId));
+		if (!q.exec()) {
+			qDebug() << "Select JobTagMapping failed:" << q.lastError().text();
+			return false;
+		}
+		while (q.next()) stale.insert(q.value(0).toInt());
+	}
+	QVector<int> missing;
+	for (int tagId : tagIds) {
+		if (!stale.remove(tagId)) missing.append(tagId);
+	}
+	QSqlQuery del(db);
+	del.prepare("DELETE FROM JobTagMapping WHERE jobId = :jobId AND tagId = :tagId");
+	for (int tagId : stale) {
+		del.bindValue(":jobId", QVariant::fromValue<qlonglong>(jobId));
+		del.bindValue(":tagId", tagId);
+		if (!del.exec()) {
+			qDebug() << "Delete JobTagMapping failed:" << del.lastError().text();
+			return false;
+		}
+	}
+	bool ok = true;
+	for (int tagId : missing) ok = insertJobTagMapping(jobId, tagId) && ok;
+	return ok;
+}
+
+bool SQLInterface::updateJobFingerprint(long long jobId, quint64 fingerprint) {
+	if (!isConnected()) return false;
+	// written right after insertJob on every store: same handle, so it joins its transaction
+	if (m_useNative) return nativeUpdateJobFingerprint(jobId, fingerprint);
+	QSqlDatabase db = databaseForCurrentThread();
+	QSqlQuery q(db);
+	// stored as the signed bit pattern (SQLite INTEGER is 64-bit signed)
+	q.prepare("UPDATE Job SET fingerprint = :fingerprint WHERE jobId = :jobId");
+	q.bindValue(":fingerprint", QVariant::fromValue<qlonglong>(static_cast<qlonglong>(fingerprint)));
+	q.bindValue(":jobId", QVariant::fromValue<qlonglong>(jobId));
+	if (!q.exec()) {
+		qDebug() << "Update Job.fingerprint failed:" << q.lastError().text();
+		return false;
+	}
+	return true;
+}
+
+QVector<QPair<long long, quint64>> SQLInterface::queryJobFingerprints(int sourceId, bool *ok) {
+	QVector<QPair<long long, quint64>> entries;
+	if (ok) *ok = false;
+	if (!isConnected()) return entries;
+	if (m_useNative) return nativeQueryJobFingerprints(sourceId, ok);
+	QSqlDatabase db = databaseForCurrentThread();
+	QSqlQuery q(db);
+	q.setForwardOnly(true);
+	// answered from idx_job_source_fingerprint alone
+	q.prepare("SELECT jobId, fingerprint FROM Job WHERE sourceId = :sourceId AND fingerprint IS NOT NULL ORDER BY jobId");
+	q.bindValue(":sourceId", sourceId);
+	if (!q.exec()) {
+		qDebug() << "Select Job fingerprints failed:" << q.lastError().text();
+		return entries;
+	}
+	while (q.next()) {
+		entries.append({q.value(0).toLongLong(), static_cast<quint64>(q.value(1).toLongLong())});
+	}
+	if (ok) *ok = true;
+	return entries;
+}
+
 QVector<SQLNS::JobInfo> SQLInterface::queryAllJobs() {
 	QVector<SQLNS::JobInfo> jobs;
 	if (!isConnected()) return jobs;
+	if (m_useNative) return nativeQueryAllJobs();
 	QSqlDatabase db = databaseForCurrentThread();
 	QSqlQuery q(db);
+	q.setForwardOnly(true);
 	if (!q.exec("SELECT jobId, jobName, companyId, recruitTypeId, cityId, sourceId, requirements, "
 				"salaryMin, salaryMax, salarySlabId, createTime, updateTime, hrLastLoginTime "
 				"FROM Job ORDER BY jobId ASC")) {
@@ -483,7 +678,7 @@ QVector<SQLNS::JobInfo> SQLInterface::queryAllJobs() {
 		SQLNS::JobInfo job;
 		job.jobId = q.value(0).toLongLong();
 		job.jobName = q.value(1).toString();
-		job.companyId = q.value(2).toInt();
+		job.companyId = q.value(2).toLongLong();
 		job.recruitTypeId = q.value(3).toInt();
 		job.cityId = q.value(4).toInt();
 		job.sourceId = q.value(5).toInt();
@@ -494,112 +689,46 @@ QVector<SQLNS::JobInfo> SQLInterface::queryAllJobs() {
 		job.createTime = q.value(10).toString();
 		job.updateTime = q.value(11).toString();
 		job.hrLastLoginTime = q.value(12).toString();
-
-		// Query tags for this job
-		QSqlQuery tagQuery(db);
-		tagQuery.prepare("SELECT t.tagId FROM JobTag t "
-						"JOIN JobTagMapping m ON t.tagId = m.tagId "
-						"WHERE m.jobId = :jobId");
-		tagQuery.bindValue(":jobId", job.jobId);
-		if (tagQuery.exec()) {
-			while (tagQuery.next()) {
-				job.tagIds.append(tagQuery.value(0).toInt());
-			}
-		}
-
 		jobs.append(job);
 	}
 
-	
+	// Tags: one query ordered by jobId, merged into the (also jobId-ordered) job list in a single pass
+	QSqlQuery tagQuery(db);
+	tagQuery.setForwardOnly(true);
+	if (!tagQuery.exec("SELECT jobId, tagId FROM JobTagMapping ORDER BY jobId ASC")) {
+		qDebug() << "Select JobTagMapping failed:" << tagQuery.lastError().text();
+		return jobs;
+	}
+	int idx = 0;
+	while (tagQuery.next()) {
+		const long long jobId = tagQuery.value(0).toLongLong();
+		while (idx < jobs.size() && jobs[idx].jobId < jobId) ++idx;
+		if (idx >= jobs.size()) break;
+		if (jobs[idx].jobId == jobId) {
+			jobs[idx].tagIds.append(tagQuery.value(1).toInt());
+		}
+	}
 	return jobs;
 }
 
 QVector<SQLNS::JobInfoPrint> SQLInterface::queryAllJobsPrint() {
+	// Same two set-based statements as the streaming cursor (LEFT JOINed names + jobId-ordered tags),
+	// collected into one vector for callers that need the whole table
 	QVector<SQLNS::JobInfoPrint> jobs;
-	if (!isConnected()) return jobs;
-	QSqlDatabase db = databaseForCurrentThread();
-	QSqlQuery q(db);
-	if (!q.exec("SELECT jobId, jobName, companyId, recruitTypeId, cityId, sourceId, requirements, "
-				"salaryMin, salaryMax, salarySlabId, createTime, updateTime, hrLastLoginTime "
-				"FROM Job ORDER BY jobId ASC")) {
-		qDebug() << "Select Job failed:" << q.lastError().text();
-		return jobs;
-	}
-	while (q.next()) {
-		SQLNS::JobInfoPrint job;
-		job.jobId = q.value(0).toLongLong();
-		job.jobName = q.value(1).toString();
-		job.companyId = q.value(2).toInt();
-		job.recruitTypeId = q.value(3).toInt();
-		job.cityId = q.value(4).toInt();
-		job.sourceId = q.value(5).toInt();
-		job.requirements = q.value(6).toString();
-		job.salaryMin = q.value(7).toDouble();
-		job.salaryMax = q.value(8).toDouble();
-		job.salarySlabId = q.value(9).toInt();
-		job.createTime = q.value(10).toString();
-		job.updateTime = q.value(11).toString();
-		job.hrLastLoginTime = q.value(12).toString();
-
-		// Resolve company name
-		QSqlQuery qc(db);
-		qc.prepare("SELECT companyName FROM Company WHERE companyId = :id");
-		qc.bindValue(":id", job.companyId);
-		if (qc.exec() && qc.next()) {
-			job.companyName = qc.value(0).toString();
-		}
-
-		// Resolve recruit type name
-		QSqlQuery qr(db);
-		qr.prepare("SELECT typeName FROM RecruitType WHERE recruitTypeId = :id");
-		qr.bindValue(":id", job.recruitTypeId);
-		if (qr.exec() && qr.next()) {
-			job.recruitTypeName = qr.value(0).toString();
-		}
-
-		// Resolve city name
-		QSqlQuery qcity(db);
-		qcity.prepare("SELECT cityName FROM JobCity WHERE cityId = :id");
-		qcity.bindValue(":id", job.cityId);
-		if (qcity.exec() && qcity.next()) {
-			job.cityName = qcity.value(0).toString();
-		}
-
-		// Resolve source info
-		QSqlQuery qs(db);
-		qs.prepare("SELECT sourceName FROM Source WHERE sourceId = :id");
-		qs.bindValue(":id", job.sourceId);
-		if (qs.exec() && qs.next()) {
-			job.sourceName = qs.value(0).toString();
-		}
-
-		// Query tags (IDs and names)
-		QSqlQuery tagQuery(db);
-		tagQuery.prepare("SELECT t.tagId, t.tagName FROM JobTag t "
-						 "JOIN JobTagMapping m ON t.tagId = m.tagId "
-						 "WHERE m.jobId = :jobId");
-		tagQuery.bindValue(":jobId", job.jobId);
-		if (tagQuery.exec()) {
-			while (tagQuery.next()) {
-				job.tagIds.append(tagQuery.value(0).toInt());
-				job.tagNames.append(tagQuery.value(1).toString());
-			}
-		}
-
+	forEachJobPrint([&jobs](const SQLNS::JobInfoPrint &job) {
 		jobs.append(job);
-	}
+		return true;
+	});
 	return jobs;
 }
 
 QSqlDatabase SQLInterface::databaseForCurrentThread() {
-	QString connName = QStringLiteral("crawler_conn_%1").arg((quintptr)QThread::currentThreadId());
-	if (QSqlDatabase::contains(connName)) {
-		return QSqlDatabase::database(connName);
-	}
-	QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
-	db.setDatabaseName(m_dbFilePath);
-	if (!db.open()) {
-		qDebug() << "Failed to open DB for thread:" << connName << db.lastError().text();
+	QSqlDatabase &db = threadDatabase();
+	if (!db.isOpen()) {
+		db.setDatabaseName(m_dbFilePath);
+		if (!db.open()) {
+			qDebug() << "Failed to open DB for thread:" << t_connection.name << db.lastError().text();
+		}
 	}
 	return db;
-}
\ No newline at end of file
+}
@@ -4,13 +4,71 @@
 #include <QString>
 #include <QVector>
 #include <QMap>
+#include <QHash>
 
 // 数据结构定义
 #include "constants/db_types.h"
 #include <QSqlDatabase>
+#include <QSqlQuery>
+#include <functional>
+#include <memory>
+
+// sqlite3 C API reader used by the native backend (sqlinterface_native.cpp)
+class NativeJobReader;
+
+// Forward-only cursor over all jobs (JobInfoPrint rows, jobId ascending).
+// Holds two open statements (jobs + tags) and merges them row by row, so
+// memory stays constant regardless of table size. Obtain via
+// SQLInterface::openJobCursor(); destroy before disconnecting.
+class JobPrintCursor {
+public:
+    ~JobPrintCursor();
+    JobPrintCursor(const JobPrintCursor &) = delete;
+    JobPrintCursor &operator=(const JobPrintCursor &) = delete;
+    // Reads the next row into job; returns false at end or on error
+    bool next(SQLNS::JobInfoPrint &job);
+    bool isValid() const { return m_valid; }
+    // True once next() stopped on a failed step rather than at the end of the table
+    bool hasError() const { return m_error; }
+
+private:
+    friend class SQLInterface;
+    // native == nullptr: read through QtSql on db; otherwise takes ownership of native
+    JobPrintCursor(const QSqlDatabase &db, NativeJobReader *native, bool withRequirements);
+    bool advanceTag();
+    bool nextNative(SQLNS::JobInfoPrint &job);
+
+    QSqlQuery m_jobs;
+    QSqlQuery m_tags;
+    bool m_valid = false;
+    bool m_error = false;
+    bool m_hasTag = false;       // m_tag* hold the current unconsumed tag row
+    long long m_tagJobId = 0;
+    int m_tagId = 0;
+    QString m_tagName;
+    NativeJobReader *m_native = nullptr;  // owned; deleted in ~JobPrintCursor (sqlinterface_native.cpp)
+};
 
 class SQLInterface {
 public:
+    // Storage backend, chosen once at startup (config.json "sqlBackend").
+    // NativeSqlite routes the core CRUD (inserts, tag sets, fingerprints, transactions,
+    // bulk job reads) through the sqlite3 C API (see sqlinterface_native.cpp); everything
+    // else stays on QtSql, including the per-job ingest side steps: near-duplicate grouping,
+    // legacy id remaps and bigram indexing. Those run on the thread's QtSql connection, a
+    // second SQLite connection, so a batch must not be wrapped in beginTransaction() under
+    // NativeSqlite: their writes would wait on the native write lock (SQLITE_BUSY).
+    enum class Backend { QtSql, NativeSqlite };
+    // Applies to connections opened afterwards; returns false (and keeps QtSql)
+    // when the build has no native backend
+    static bool setBackend(Backend backend);
+    static Backend backend();
+    static bool nativeBackendAvailable();
+
+    // Diagnostic: number of per-thread QtSql connections currently registered
+    // (one per thread that has used SQLInterface and not yet disconnected/exited)
+    static int connectionCount();
+
     SQLInterface();
     ~SQLInterface();
 
@@ -20,9 +78,26 @@ public:
     bool isConnected() const;
     void disconnect();
 
+    // Explicit transaction on the current thread's connection (bulk ingest / benchmarks)
+    bool beginTransaction();
+    bool commitTransaction();
+    void rollbackTransaction();
+
     // Schema creation (replaces old ensureDatabaseAndTable)
     bool createAllTables();
 
+    // Versioned schema migrations (PRAGMA user_version), see sqlinterface_migrations.cpp.
+    // Applies pending steps in order; each step runs at most once per database file.
+    bool runMigrations();
+    // Current schema version stored in PRAGMA user_version (-1 if not connected)
+    int schemaVersion();
+
+    // Data generation (DbMeta 'generation', migration 8). Writers bump it once
+    // after an ingest batch so readers can key caches on it.
+    // Returns -1 if not connected or the counter is missing.
+    qint64 dataGeneration();
+    bool bumpDataGeneration();
+
     // Source operations
     int insertSource(const SQLNS::Source &source);
     SQLNS::Source querySourceById(int sourceId);
@@ -33,7 +108,7 @@ public:
     QVector<SQLNS::JobInfoPrint> queryAllJobsPrint();
     
     // Company operations (companyId required - general ID)
-    int insertCompany(int companyId, const QString &companyName);
+    long long insertCompany(long long companyId, const QString &companyName);
 
     // City operations
     int insertCity(const QString &cityName);
@@ -42,16 +117,104 @@ public:
     int insertTag(const QString &tagName);
 
     // Job operations
-    int insertJob(const SQLNS::JobInfo &job);
+    // returns the 64-bit jobId, -1 on failure
+    long long insertJob(const SQLNS::JobInfo &job);
     bool insertJobTagMapping(long long jobId, int tagId);
+    // Makes the job's tag set exactly tagIds: removes mappings no longer listed, adds the
+    // missing ones, touches nothing when the set is unchanged (no FTS trigger churn)
+    bool replaceJobTags(long long jobId, const QVector<int> &tagIds);
     QVector<SQLNS::JobInfo> queryAllJobs();
+    int countJobs();
+
+    // Streaming reads (see sqlinterface_cursor.cpp): rows are produced one at a
+    // time or in fixed-size chunks instead of materializing the whole table.
+    // withRequirements = false leaves JobInfoPrint::requirements empty (the largest
+    // column; list views fetch it on demand with queryRequirements)
+    std::unique_ptr<JobPrintCursor> openJobCursor(bool withRequirements = true);
+    // visitor returns false to stop early; returns false if the query failed or a
+    // row could not be read (the visitor has then seen a truncated table)
+    bool forEachJobPrint(const std::function<bool(const SQLNS::JobInfoPrint &)> &visitor, bool withRequirements = true);
+    bool forEachJobPrintChunk(int chunkSize, const std::function<bool(const QVector<SQLNS::JobInfoPrint> &)> &visitor);
+
+    // Keyset-paginated query with search / field filters / sort pushed down to SQL
+    // (see sqlinterface_paging.cpp). Matching semantics follow Presenter::searchJobs.
+    SQLNS::JobPage queryJobsPage(const SQLNS::JobPageQuery &pageQuery);
+    // Normalized monthly salary bounds (yuan/month, see SQLNS::monthlySalary) as SQL
+    // expressions over Job; prefix is a table alias such as "j.". Migration 9 indexes
+    // exactly these expressions, so range filters must use them unchanged.
+    static QString monthlySalaryLowSql(const QString &prefix = QString());
+    static QString monthlySalaryHighSql(const QString &prefix = QString());
+
+    // Full-text search over JobFts (FTS5, trigram tokenizer; see sqlinterface_search.cpp).
+    // Returns jobIds best match first; *ok is false when the index is unavailable.
+    // 1-2 character queries use the JobBigram index (migration 14) when it exists.
+    QVector<long long> searchJobIds(const QString &query, int limit = -1, bool *ok = nullptr);
+    bool hasFullTextIndex();
+    bool hasBigramIndex();
+    // Rebuilds the JobBigram rows of the jobs queued in JobBigramPending (the triggers
+    // only queue). Writers call it once per batch; returns how many were processed, -1 on error.
+    int indexPendingBigrams();
+    // FTS5 MATCH expression for JobBigram: a token for 2 letters/digits, a token
+    // prefix for 1; empty for anything else (the caller then uses JobFts / LIKE)
+    static QString bigramMatch(const QString &query);
+
+    // Requirements text on demand (see sqlinterface_search.cpp): by jobId, and the
+    // jobIds whose requirements contain any of the needles (case-insensitive for ASCII)
+    QHash<long long, QString> queryRequirements(const QVector<long long> &jobIds);
+    QVector<long long> searchRequirementIds(const QVector<QString> &needles);
+
+    // Cross-source near-duplicate groups (MinHash + LSH, see sqlinterface_dedup.cpp).
+    // Job.canonicalJobId is 0 for a group's canonical job and its id for the members.
+    // groupNearDuplicate files one stored job and returns its canonical id (its own id
+    // when it is canonical), -1 on error; already processed jobs return their group.
+    long long groupNearDuplicate(long long jobId);
+    // Processes every job without a signature yet (legacy rows); returns how many
+    // were linked to an existing group, -1 on error
+    int groupNearDuplicates();
+
+    // Legacy synthetic IDs (migration 12, see sqlinterface_remap.cpp): rows written before
+    // IDs became stable are rewritten to stableId the first time their legacy id is seen
+    // again. Returns true if a row was remapped; false if nothing was pending, the stable
+    // id is already taken, or on error. Each legacy id is consumed at most once.
+    bool remapLegacyJobId(long long legacyId, long long stableId);
+    bool remapLegacyCompanyId(long long legacyId, long long stableId);
+
+    // Known-job index for incremental crawls (Job.fingerprint, migration 13): the list-page
+    // fingerprint last seen for a job, and every (jobId, fingerprint) of one source.
+    // Jobs without a fingerprint (stored before migration 13) are not returned.
+    bool updateJobFingerprint(long long jobId, quint64 fingerprint);
+    QVector<QPair<long long, quint64>> queryJobFingerprints(int sourceId, bool *ok = nullptr);
 
 private:
     bool openSqliteConnection(const QString &dbFilePath);
     // stored DB file path to lazily open per-thread connections
     QString m_dbFilePath;
-    // helper to get or create QSqlDatabase for the current thread
+    // the current thread's cached QSqlDatabase (thread_local, opened lazily; no registry lookup)
     QSqlDatabase databaseForCurrentThread();
+    // quote a user query as a single FTS5 phrase
+    static QString ftsPhrase(const QString &query);
+    // JobBigram column text: space separated 2-character windows (see bigramMatch)
+    static QString bigramText(const QString &text);
+    // attach tagIds / tagNames to the given jobs with one IN (...) query
+    void fillTagsForJobs(QVector<SQLNS::JobInfoPrint> &jobs);
+
+    // Native backend (sqlinterface_native.cpp); used when m_useNative is set
+    bool m_useNative = false;
+    bool openNativeConnection();
+    void closeNativeConnection();
+    bool nativeExec(const char *sql);
+    long long nativeInsertCompany(long long companyId, const QString &companyName);
+    int nativeInsertCity(const QString &cityName);
+    int nativeInsertTag(const QString &tagName);
+    long long nativeInsertJob(const SQLNS::JobInfo &job);
+    bool nativeInsertJobTagMapping(long long jobId, int tagId);
+    bool nativeReplaceJobTags(long long jobId, const QVector<int> &tagIds);
+    bool nativeUpdateJobFingerprint(long long jobId, quint64 fingerprint);
+    QVector<QPair<long long, quint64>> nativeQueryJobFingerprints(int sourceId, bool *ok);
+    QVector<SQLNS::JobInfo> nativeQueryAllJobs();
+    int nativeCountJobs();
+    // new reader owned by the caller, nullptr on failure
+    NativeJobReader *nativeJobReader(bool withRequirements);
 };
 
 #endif // SQLINTERFACE_H
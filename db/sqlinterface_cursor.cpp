@@ -0,0 +1,155 @@
+// db/sqlinterface_cursor.cpp
+// Forward-only streaming over the Job table (JobPrintCursor + visitor helpers).
+#include "sqlinterface.h"
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QVariant>
+#include <QDebug>
+
+JobPrintCursor::JobPrintCursor(const QSqlDatabase &db, NativeJobReader *native, bool withRequirements)
+	: m_jobs(db), m_tags(db), m_native(native) {
+	if (m_native) {
+		m_valid = true;
+		return;
+	}
+	m_jobs.setForwardOnly(true);
+	m_tags.setForwardOnly(true);
+	// Without requirements the column is selected as NULL so the row layout stays the same
+	if (!m_jobs.exec(QStringLiteral(
+					 "SELECT j.jobId, j.jobName, j.companyId, j.recruitTypeId, j.cityId, j.sourceId, %1, "
+					 "j.salaryMin, j.salaryMax, j.salarySlabId, j.createTime, j.updateTime, j.hrLastLoginTime, "
+					 "c.companyName, r.typeName, ci.cityName, s.sourceName, "
+					 "j.createEpoch, j.updateEpoch, j.hrLastLoginEpoch, j.canonicalJobId "
+					 "FROM Job j "
+					 "LEFT JOIN Company c ON c.companyId = j.companyId "
+					 "LEFT JOIN RecruitType r ON r.recruitTypeId = j.recruitTypeId "
+					 "LEFT JOIN JobCity ci ON ci.cityId = j.cityId "
+					 "LEFT JOIN Source s ON s.sourceId = j.sourceId "
+					 "ORDER BY j.jobId ASC").arg(withRequirements ? "j.requirements" : "NULL"))) {
+		qDebug() << "Open job cursor failed:" << m_jobs.lastError().text();
+		return;
+	}
+	if (!m_tags.exec("SELECT m.jobId, t.tagId, t.tagName FROM JobTagMapping m "
+					 "JOIN JobTag t ON t.tagId = m.tagId "
+					 "ORDER BY m.jobId ASC")) {
+		qDebug() << "Open tag cursor failed:" << m_tags.lastError().text();
+		return;
+	}
+	m_valid = true;
+	advanceTag();
+}
+
+bool JobPrintCursor::advanceTag() {
+	m_hasTag = m_tags.next();
+	if (m_hasTag) {
+		m_tagJobId = m_tags.value(0).toLongLong();
+		m_tagId = m_tags.value(1).toInt();
+		m_tagName = m_tags.value(2).toString();
+	} else if (m_tags.lastError().isValid()) {
+		qDebug() << "Job cursor tag step failed:" << m_tags.lastError().text();
+		m_error = true;
+	}
+	return m_hasTag;
+}
+
+bool JobPrintCursor::next(SQLNS::JobInfoPrint &job) {
+	if (!m_valid || m_error) return false;
+	if (m_native) return nextNative(job);
+	if (!m_jobs.next()) {
+		// next() is also false at the end of the result; only a set error means truncation
+		if (m_jobs.lastError().isValid()) {
+			qDebug() << "Job cursor step failed:" << m_jobs.lastError().text();
+			m_error = true;
+		}
+		return false;
+	}
+
+	job = SQLNS::JobInfoPrint();
+	job.jobId = m_jobs.value(0).toLongLong();
+	job.jobName = m_jobs.value(1).toString();
+	job.companyId = m_jobs.value(2).toLongLong();
+	job.recruitTypeId = m_jobs.value(3).toInt();
+	job.cityId = m_jobs.value(4).toInt();
+	job.sourceId = m_jobs.value(5).toInt();
+	job.requirements = m_jobs.value(6).toString();
+	job.salaryMin = m_jobs.value(7).toDouble();
+	job.salaryMax = m_jobs.value(8).toDouble();
+	job.salarySlabId = m_jobs.value(9).toInt();
+	job.createTime = m_jobs.value(10).toString();
+	job.updateTime = m_jobs.value(11).toString();
+	job.hrLastLoginTime = m_jobs.value(12).toString();
+	job.companyName = m_jobs.value(13).toString();
+	job.recruitTypeName = m_jobs.value(14).toString();
+	job.cityName = m_jobs.value(15).toString();
+	job.sourceName = m_jobs.value(16).toString();
+	job.createEpoch = m_jobs.value(17).toLongLong();
+	job.updateEpoch = m_jobs.value(18).toLongLong();
+	job.hrLastLoginEpoch = m_jobs.value(19).toLongLong();
+	job.canonicalJobId = m_jobs.value(20).toLongLong();
+
+	// Both statements are ordered by jobId: skip orphan tag rows, then take this job's tags
+	while (m_hasTag && m_tagJobId < job.jobId) advanceTag();
+	while (m_hasTag && m_tagJobId == job.jobId) {
+		job.tagIds.append(m_tagId);
+		job.tagNames.append(m_tagName);
+		advanceTag();
+	}
+	// a failed tag step leaves this job's tags incomplete
+	return !m_error;
+}
+
+std::unique_ptr<JobPrintCursor> SQLInterface::openJobCursor(bool withRequirements) {
+	if (!isConnected()) return nullptr;
+	NativeJobReader *native = nullptr;
+	if (m_useNative) {
+		native = nativeJobReader(withRequirements);
+		if (!native) return nullptr;
+	}
+	std::unique_ptr<JobPrintCursor> cursor(new JobPrintCursor(databaseForCurrentThread(), native, withRequirements));
+	if (!cursor->isValid()) return nullptr;
+	return cursor;
+}
+
+bool SQLInterface::forEachJobPrint(const std::function<bool(const SQLNS::JobInfoPrint &)> &visitor, bool withRequirements) {
+	std::unique_ptr<JobPrintCursor> cursor = openJobCursor(withRequirements);
+	if (!cursor) return false;
+	SQLNS::JobInfoPrint job;
+	while (cursor->next(job)) {
+		if (!visitor(job)) return true;
+	}
+	return !cursor->hasError();
+}
+
+bool SQLInterface::forEachJobPrintChunk(int chunkSize, const std::function<bool(const QVector<SQLNS::JobInfoPrint> &)> &visitor) {
+	std::unique_ptr<JobPrintCursor> cursor = openJobCursor();
+	if (!cursor) return false;
+	if (chunkSize < 1) chunkSize = 1;
+
+	QVector<SQLNS::JobInfoPrint> chunk;
+	chunk.reserve(chunkSize);
+	SQLNS::JobInfoPrint job;
+	while (cursor->next(job)) {
+		chunk.append(job);
+		if (chunk.size() == chunkSize) {
+			if (!visitor(chunk)) return true;
+			chunk.clear();
+		}
+	}
+	if (cursor->hasError()) return false;
+	if (!chunk.isEmpty()) visitor(chunk);
+	return true;
+}
+
+int SQLInterface::countJobs() {
+	if (!isConnected()) return 0;
+	if (m_useNative) return nativeCountJobs();
+	QSqlDatabase db = databaseForCurrentThread();
+	QSqlQuery q(db);
+	if (q.exec("SELECT COUNT(*) FROM Job") && q.next()) {
+		return q.value(0).toInt();
+	}
+	qDebug() << "Count Job failed:" << q.lastError().text();
+	return 0;
+}
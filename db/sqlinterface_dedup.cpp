@@ -0,0 +1,289 @@
+// db/sqlinterface_dedup.cpp
+// Near-duplicate grouping of jobs across sources (MinHash + LSH).
+//
+// The same posting is often crawled from several sources with small edits
+// (punctuation, a reworded line, "XX科技有限公司" vs "XX科技"). Each job is
+// reduced to a normalized text: title, company without its legal suffix and
+// requirements, case-folded, letters and digits only. Its 3-character shingles
+// are hashed into a kMinHashSize MinHash signature; equal signature positions
+// estimate Jaccard similarity. The signature is cut into kLshBands bands of
+// kLshRows values, and jobs that share any band key (JobLshBucket) become
+// candidates. With 16 x 4 a pair at similarity 0.8 is a candidate with
+// probability ~99.98%, a pair at 0.5 with ~64%; candidates are then verified on
+// the full signature (>= kDuplicateSimilarity) and on the city.
+//
+// A job that matches becomes a member of the candidate's group:
+// Job.canonicalJobId holds the group's first job (the canonical one keeps 0).
+// Groups never re-elect: jobs are INSERT OR IGNORE'd, so a processed row does
+// not change. JobMinHash is written last and doubles as the "processed" marker.
+// Tables and columns come from migration 11.
+#include "sqlinterface.h"
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QVariant>
+#include <QDebug>
+#include <QStringList>
+#include <QtEndian>
+
+namespace {
+
+constexpr int kMinHashSize = 64;
+constexpr int kLshBands = 16;
+constexpr int kLshRows = 4;
+static_assert(kLshBands * kLshRows == kMinHashSize, "bands must cover the signature");
+constexpr int kShingle = 3;
+constexpr double kDuplicateSimilarity = 0.8;
+
+using Signature = QVector<quint32>;
+
+// splitmix64 finalizer
+quint64 mix64(quint64 x) {
+	x ^= x >> 30;
+	x *= 0xBF58476D1CE4E5B9ULL;
+	x ^= x >> 27;
+	x *= 0x94D049BB133111EBULL;
+	x ^= x >> 31;
+	return x;
+}
+
+// Case-folded letters and digits; drops whitespace and punctuation differences
+QString normalizeText(const QString &text) {
+	QString out;
+	out.reserve(text.size());
+	for (const QChar ch : text.toCaseFolded()) {
+		if (ch.isLetterOrNumber()) out.append(ch);
+	}
+	return out;
+}
+
+QString normalizeCompany(const QString &name) {
+	static const QStringList kSuffixes = {
+		QStringLiteral("股份有限公司"), QStringLiteral("有限责任公司"), QStringLiteral("有限公司"),
+		QStringLiteral("公司"), QStringLiteral("coltd"), QStringLiteral("ltd"), QStringLiteral("inc"),
+	};
+	QString out = normalizeText(name);
+	for (bool stripped = true; stripped;) {
+		stripped = false;
+		for (const QString &suffix : kSuffixes) {
+			if (out.size() > suffix.size() && out.endsWith(suffix)) {
+				out.chop(suffix.size());
+				stripped = true;
+			}
+		}
+	}
+	return out;
+}
+
+QString normalizeCity(const QString &city) {
+	QString out = city.trimmed();
+	if (out.size() > 1 && out.endsWith(QStringLiteral("市"))) out.chop(1);
+	return out;
+}
+
+// Empty when the text is shorter than one shingle (nothing to compare)
+Signature minHashSignature(const QString &text) {
+	Signature sig;
+	if (text.size() < kShingle) return sig;
+	sig.fill(0xFFFFFFFFu, kMinHashSize);
+	const QChar *s = text.constData();
+	for (int i = 0; i + kShingle <= text.size(); ++i) {
+		quint64 base = 14695981039346656037ULL;   // FNV-1a over the shingle
+		for (int k = 0; k < kShingle; ++k) {
+			base ^= s[i + k].unicode();
+			base *= 1099511628211ULL;
+		}
+		// k-th hash function: the shingle hash re-mixed with a per-function offset
+		for (int k = 0; k < kMinHashSize; ++k) {
+			const quint32 h = static_cast<quint32>(mix64(base + (k + 1) * 0x9E3779B97F4A7C15ULL) >> 32);
+			if (h < sig[k]) sig[k] = h;
+		}
+	}
+	return sig;
+}
+
+QVector<qint64> bandKeys(const Signature &sig) {
+	QVector<qint64> keys;
+	keys.reserve(kLshBands);
+	for (int b = 0; b < kLshBands; ++b) {
+		quint64 h = mix64(b + 1);
+		for (int r = 0; r < kLshRows; ++r) h = mix64(h ^ sig[b * kLshRows + r]);
+		keys.append(static_cast<qint64>(h));
+	}
+	return keys;
+}
+
+double similarity(const Signature &a, const Signature &b) {
+	int equal = 0;
+	for (int k = 0; k < kMinHashSize; ++k) {
+		if (a[k] == b[k]) ++equal;
+	}
+	return static_cast<double>(equal) / kMinHashSize;
+}
+
+QByteArray encodeSignature(const Signature &sig) {
+	QByteArray bytes(sig.size() * 4, Qt::Uninitialized);
+	for (int k = 0; k < sig.size(); ++k) qToLittleEndian<quint32>(sig[k], bytes.data() + k * 4);
+	return bytes;
+}
+
+Signature decodeSignature(const QByteArray &bytes) {
+	Signature sig;
+	if (bytes.size() != kMinHashSize * 4) return sig;
+	sig.resize(kMinHashSize);
+	for (int k = 0; k < kMinHashSize; ++k) sig[k] = qFromLittleEndian<quint32>(bytes.constData() + k * 4);
+	return sig;
+}
+
+// Groups one job on an open connection (the caller owns the transaction).
+// Returns the job's canonical id (its own id when it starts a group), -1 on error.
+long long assignGroup(QSqlDatabase &db, long long jobId) {
+	QSqlQuery q(db);
+	q.prepare("SELECT j.canonicalJobId, EXISTS (SELECT 1 FROM JobMinHash h WHERE h.jobId = j.jobId), "
+			  "j.jobName, c.companyName, j.requirements, ci.cityName "
+			  "FROM Job j "
+			  "LEFT JOIN Company c ON c.companyId = j.companyId "
+			  "LEFT JOIN JobCity ci ON ci.cityId = j.cityId "
+			  "WHERE j.jobId = :jobId");
+	q.bindValue(":jobId", QVariant::fromValue<qlonglong>(jobId));
+	if (!q.exec() || !q.next()) {
+		qDebug() << "Near-duplicate: job" << jobId << "not found:" << q.lastError().text();
+		return -1;
+	}
+	const long long current = q.value(0).toLongLong();
+	if (q.value(1).toBool()) return current != 0 ? current : jobId;
+
+	const QString text = normalizeText(q.value(2).toString()) + QChar(0x1F)
+		+ normalizeCompany(q.value(3).toString()) + QChar(0x1F)
+		+ normalizeText(q.value(4).toString());
+	const QString city = normalizeCity(q.value(5).toString());
+	q.finish();
+
+	const Signature sig = minHashSignature(text);
+	long long canonical = 0;
+	QVector<qint64> keys;
+	if (!sig.isEmpty()) {
+		keys = bandKeys(sig);
+		QStringList inList;
+		for (qint64 key : keys) inList << QString::number(key);
+		// Best verified candidate; ties go to the older job (ascending jobId, strict >)
+		QSqlQuery c(db);
+		c.setForwardOnly(true);
+		c.prepare(QStringLiteral("SELECT DISTINCT b.jobId, h.signature, j.canonicalJobId, ci.cityName "
+								 "FROM JobLshBucket b "
+								 "JOIN JobMinHash h ON h.jobId = b.jobId "
+								 "JOIN Job j ON j.jobId = b.jobId "
+								 "LEFT JOIN JobCity ci ON ci.cityId = j.cityId "
+								 "WHERE b.bucket IN (%1) AND b.jobId <> :jobId "
+								 "ORDER BY b.jobId").arg(inList.join(',')));
+		c.bindValue(":jobId", QVariant::fromValue<qlonglong>(jobId));
+		if (!c.exec()) {
+			qDebug() << "Near-duplicate candidate query failed:" << c.lastError().text();
+			return -1;
+		}
+		double best = 0;
+		while (c.next()) {
+			const Signature other = decodeSignature(c.value(1).toByteArray());
+			if (other.isEmpty()) continue;
+			// Same text in different cities is a separate opening, not a repost
+			const QString otherCity = normalizeCity(c.value(3).toString());
+			if (!city.isEmpty() && !otherCity.isEmpty() && city != otherCity) continue;
+			const double s = similarity(sig, other);
+			if (s >= kDuplicateSimilarity && s > best) {
+				best = s;
+				const long long otherCanonical = c.value(2).toLongLong();
+				canonical = otherCanonical != 0 ? otherCanonical : c.value(0).toLongLong();
+			}
+		}
+	}
+
+	// Members are filed too, so later reposts still find the group when the canonical text drifted
+	QSqlQuery w(db);
+	w.prepare("INSERT OR IGNORE INTO JobLshBucket(bucket, jobId) VALUES(:bucket, :jobId)");
+	for (qint64 key : keys) {
+		w.bindValue(":bucket", QVariant::fromValue<qlonglong>(key));
+		w.bindValue(":jobId", QVariant::fromValue<qlonglong>(jobId));
+		if (!w.exec()) {
+			qDebug() << "Insert JobLshBucket failed:" << w.lastError().text();
+			return -1;
+		}
+	}
+	if (canonical != 0) {
+		w.prepare("UPDATE Job SET canonicalJobId = :canonical WHERE jobId = :jobId");
+		w.bindValue(":canonical", QVariant::fromValue<qlonglong>(canonical));
+		w.bindValue(":jobId", QVariant::fromValue<qlonglong>(jobId));
+		if (!w.exec()) {
+			qDebug() << "Update Job.canonicalJobId failed:" << w.lastError().text();
+			return -1;
+		}
+	}
+	w.prepare("INSERT OR REPLACE INTO JobMinHash(jobId, signature) VALUES(:jobId, :signature)");
+	w.bindValue(":jobId", QVariant::fromValue<qlonglong>(jobId));
+	w.bindValue(":signature", sig.isEmpty() ? QVariant() : QVariant(encodeSignature(sig)));
+	if (!w.exec()) {
+		qDebug() << "Insert JobMinHash failed:" << w.lastError().text();
+		return -1;
+	}
+	return canonical != 0 ? canonical : jobId;
+}
+
+} // namespace
+
+long long SQLInterface::groupNearDuplicate(long long jobId) {
+	if (!isConnected()) return -1;
+	QSqlDatabase db = databaseForCurrentThread();
+	// One job is ~20 writes; batch them unless the caller already holds a transaction
+	const bool ownTransaction = db.transaction();
+	const long long canonical = assignGroup(db, jobId);
+	if (ownTransaction) {
+		if (canonical < 0) {
+			db.rollback();
+		} else if (!db.commit()) {
+			qDebug() << "Near-duplicate commit failed:" << db.lastError().text();
+			db.rollback();
+			return -1;
+		}
+	}
+	return canonical;
+}
+
+int SQLInterface::groupNearDuplicates() {
+	if (!isConnected()) return -1;
+	QSqlDatabase db = databaseForCurrentThread();
+	QVector<long long> pending;
+	{
+		QSqlQuery q(db);
+		q.setForwardOnly(true);
+		if (!q.exec("SELECT j.jobId FROM Job j "
+					"WHERE NOT EXISTS (SELECT 1 FROM JobMinHash h WHERE h.jobId = j.jobId) "
+					"ORDER BY j.jobId ASC")) {
+			qDebug() << "Near-duplicate backlog query failed:" << q.lastError().text();
+			return -1;
+		}
+		while (q.next()) pending.append(q.value(0).toLongLong());
+	}
+	if (pending.isEmpty()) return 0;
+
+	if (!db.transaction()) {
+		qDebug() << "Near-duplicate begin transaction failed:" << db.lastError().text();
+		return -1;
+	}
+	int linked = 0;
+	for (long long jobId : pending) {
+		const long long canonical = assignGroup(db, jobId);
+		if (canonical < 0) {
+			db.rollback();
+			return -1;
+		}
+		if (canonical != jobId) ++linked;
+	}
+	if (!db.commit()) {
+		qDebug() << "Near-duplicate commit failed:" << db.lastError().text();
+		db.rollback();
+		return -1;
+	}
+	qDebug() << "Near-duplicate grouping:" << pending.size() << "jobs processed," << linked << "linked to a group";
+	if (linked > 0) bumpDataGeneration();
+	return linked;
+}
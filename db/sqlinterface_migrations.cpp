@@ -0,0 +1,413 @@
+// db/sqlinterface_migrations.cpp
+// Versioned schema migrations for SQLInterface.
+//
+// The schema version is kept in SQLite's PRAGMA user_version. Every step in
+// kMigrations has a strictly increasing version; runMigrations() applies the
+// steps whose version is greater than the stored one, each inside its own
+// transaction, and bumps user_version on success. Steps therefore run once
+// per database file instead of being re-checked on every connect.
+//
+// To add a migration append a new entry at the end of kMigrations. Never
+// reorder or edit a step that has already shipped.
+#include "sqlinterface.h"
+#include "constants/network_types.h"
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QVariant>
+#include <QDebug>
+#include <QStringList>
+#include <functional>
+#include <vector>
+
+namespace {
+
+struct Migration {
+	int version;
+	const char *description;
+	std::function<bool(QSqlQuery &)> apply;
+};
+
+bool execStatement(QSqlQuery &q, const QString &sql) {
+	if (!q.exec(sql)) {
+		qDebug() << "[Migration] statement failed:" << sql << q.lastError().text();
+		return false;
+	}
+	return true;
+}
+
+bool columnExists(QSqlQuery &q, const QString &table, const QString &column) {
+	if (!q.exec(QStringLiteral("PRAGMA table_info(%1)").arg(table))) return false;
+	while (q.next()) {
+		if (q.value(1).toString() == column) return true;
+	}
+	return false;
+}
+
+// Tag names of one job, space separated (used by the FTS sync triggers)
+#define JOB_FTS_TAGS(jobIdExpr) \
+	"(SELECT group_concat(t.tagName, ' ') FROM JobTagMapping m JOIN JobTag t ON t.tagId = m.tagId WHERE m.jobId = " jobIdExpr ")"
+
+#define JOB_FTS_INSERT(rowExpr) \
+	"INSERT INTO JobFts(rowid, jobName, requirements, companyName, cityName, tagNames) VALUES(" \
+	rowExpr ".jobId, " rowExpr ".jobName, " rowExpr ".requirements, " \
+	"(SELECT companyName FROM Company WHERE companyId = " rowExpr ".companyId), " \
+	"(SELECT cityName FROM JobCity WHERE cityId = " rowExpr ".cityId), " \
+	JOB_FTS_TAGS(rowExpr ".jobId") ");"
+
+// Re-indexes a job's JobFts row. Scoped to the indexed columns so fingerprint,
+// canonicalJobId and epoch writes (every stored job) leave the index alone.
+QString jobFtsUpdateTrigger() {
+	return QStringLiteral(
+		"CREATE TRIGGER IF NOT EXISTS job_fts_au AFTER UPDATE OF jobId, jobName, requirements, companyId, cityId ON Job BEGIN "
+			"DELETE FROM JobFts WHERE rowid = OLD.jobId;"
+			JOB_FTS_INSERT("NEW")
+		" END");
+}
+
+// JobFts: FTS5 over Job + resolved names, rowid = jobId.
+// The trigram tokenizer indexes every 3-character window, so Chinese text
+// (no word boundaries) matches by substring, and Latin text is case-folded.
+// Queries shorter than 3 characters fall back to LIKE on the same table
+// (see SQLInterface::searchJobIds). Triggers keep it in sync with Job,
+// JobTagMapping and Company renames.
+// If the SQLite build lacks FTS5/trigram the step is skipped and search
+// falls back to LIKE scans; hasFullTextIndex() reports which path is active.
+// A skipped step still advances user_version, so runMigrations() retries it
+// on every open while JobFts is missing (see ensureFullTextIndexes).
+bool createJobFts(QSqlQuery &q) {
+	if (!q.exec("CREATE VIRTUAL TABLE IF NOT EXISTS JobFts USING fts5("
+				"jobName, requirements, companyName, cityName, tagNames, "
+				"tokenize = 'trigram case_sensitive 0')")) {
+		qDebug() << "[Migration] FTS5 trigram unavailable, full-text index skipped:" << q.lastError().text();
+		return true;
+	}
+	const QStringList statements = {
+		"CREATE TRIGGER IF NOT EXISTS job_fts_ai AFTER INSERT ON Job BEGIN "
+			JOB_FTS_INSERT("NEW")
+		" END",
+		"CREATE TRIGGER IF NOT EXISTS job_fts_ad AFTER DELETE ON Job BEGIN "
+			"DELETE FROM JobFts WHERE rowid = OLD.jobId;"
+		" END",
+		jobFtsUpdateTrigger(),
+		"CREATE TRIGGER IF NOT EXISTS jobtag_fts_ai AFTER INSERT ON JobTagMapping BEGIN "
+			"UPDATE JobFts SET tagNames = " JOB_FTS_TAGS("NEW.jobId") " WHERE rowid = NEW.jobId;"
+		" END",
+		"CREATE TRIGGER IF NOT EXISTS jobtag_fts_ad AFTER DELETE ON JobTagMapping BEGIN "
+			"UPDATE JobFts SET tagNames = " JOB_FTS_TAGS("OLD.jobId") " WHERE rowid = OLD.jobId;"
+		" END",
+		"CREATE TRIGGER IF NOT EXISTS company_fts_au AFTER UPDATE OF companyName ON Company BEGIN "
+			"UPDATE JobFts SET companyName = NEW.companyName "
+			"WHERE rowid IN (SELECT jobId FROM Job WHERE companyId = NEW.companyId);"
+		" END",
+		// backfill rows that existed before the index
+		"INSERT INTO JobFts(rowid, jobName, requirements, companyName, cityName, tagNames) "
+			"SELECT j.jobId, j.jobName, j.requirements, c.companyName, ci.cityName, " JOB_FTS_TAGS("j.jobId") " "
+			"FROM Job j "
+			"LEFT JOIN Company c ON c.companyId = j.companyId "
+			"LEFT JOIN JobCity ci ON ci.cityId = j.cityId",
+	};
+	for (const QString &sql : statements) {
+		if (!execStatement(q, sql)) return false;
+	}
+	return true;
+}
+
+#undef JOB_FTS_INSERT
+#undef JOB_FTS_TAGS
+
+// JobBigram: FTS5 (unicode61) over pre-split text, rowid = jobId, same columns as
+// JobFts. Each column holds the space separated 2-character windows of every
+// letter/digit run plus the run's last character (SQLInterface::bigramText), so
+// 1-2 character queries, which trigrams cannot answer, become a token or prefix
+// lookup instead of a LIKE scan. The text is built in C++, so triggers only
+// invalidate: any change to a job, its tags or its company's name drops the
+// job's row and queues it in JobBigramPending; SQLInterface::indexPendingBigrams
+// rebuilds queued rows and searches LIKE-match the (normally empty) queue.
+// Skipped like JobFts when the SQLite build lacks FTS5.
+bool createJobBigram(QSqlQuery &q) {
+	if (!q.exec("CREATE VIRTUAL TABLE IF NOT EXISTS JobBigram USING fts5("
+				"jobName, requirements, companyName, cityName, tagNames, "
+				"tokenize = 'unicode61')")) {
+		qDebug() << "[Migration] FTS5 unavailable, bigram index skipped:" << q.lastError().text();
+		return true;
+	}
+	const QStringList statements = {
+		"CREATE TABLE IF NOT EXISTS JobBigramPending ("
+			" jobId INTEGER PRIMARY KEY"
+		")",
+		"CREATE TRIGGER IF NOT EXISTS job_bigram_ai AFTER INSERT ON Job BEGIN "
+			"INSERT OR IGNORE INTO JobBigramPending(jobId) VALUES(NEW.jobId);"
+		" END",
+		// fingerprint / canonicalJobId / epoch updates do not touch the indexed text
+		"CREATE TRIGGER IF NOT EXISTS job_bigram_au AFTER UPDATE OF jobId, jobName, requirements, companyId, cityId ON Job BEGIN "
+			"DELETE FROM JobBigram WHERE rowid = OLD.jobId;"
+			"DELETE FROM JobBigramPending WHERE jobId = OLD.jobId;"
+			"INSERT OR IGNORE INTO JobBigramPending(jobId) VALUES(NEW.jobId);"
+		" END",
+		"CREATE TRIGGER IF NOT EXISTS job_bigram_ad AFTER DELETE ON Job BEGIN "
+			"DELETE FROM JobBigram WHERE rowid = OLD.jobId;"
+			"DELETE FROM JobBigramPending WHERE jobId = OLD.jobId;"
+		" END",
+		"CREATE TRIGGER IF NOT EXISTS jobtag_bigram_ai AFTER INSERT ON JobTagMapping BEGIN "
+			"DELETE FROM JobBigram WHERE rowid = NEW.jobId;"
+			"INSERT OR IGNORE INTO JobBigramPending(jobId) VALUES(NEW.jobId);"
+		" END",
+		"CREATE TRIGGER IF NOT EXISTS jobtag_bigram_ad AFTER DELETE ON JobTagMapping BEGIN "
+			"DELETE FROM JobBigram WHERE rowid = OLD.jobId;"
+			"INSERT OR IGNORE INTO JobBigramPending(jobId) VALUES(OLD.jobId);"
+		" END",
+		"CREATE TRIGGER IF NOT EXISTS company_bigram_au AFTER UPDATE OF companyName ON Company BEGIN "
+			"DELETE FROM JobBigram WHERE rowid IN (SELECT jobId FROM Job WHERE companyId = NEW.companyId);"
+			"INSERT OR IGNORE INTO JobBigramPending(jobId) SELECT jobId FROM Job WHERE companyId = NEW.companyId;"
+		" END",
+		// every existing job starts queued; indexPendingBigrams() backfills them
+		"INSERT OR IGNORE INTO JobBigramPending(jobId) SELECT jobId FROM Job",
+	};
+	for (const QString &sql : statements) {
+		if (!execStatement(q, sql)) return false;
+	}
+	return true;
+}
+
+bool tableExists(QSqlQuery &q, const QString &table) {
+	q.prepare("SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = :name");
+	q.bindValue(":name", table);
+	return q.exec() && q.next();
+}
+
+// Full-text tables whose migration step is skipped (not failed) without FTS5
+struct FullTextTable {
+	int version;
+	const char *table;
+	bool (*create)(QSqlQuery &);
+};
+
+const FullTextTable kFullTextTables[] = {
+	{7, "JobFts", createJobFts},
+	{14, "JobBigram", createJobBigram},
+};
+
+// Re-runs the creation step outside the version ladder for each full-text table
+// that is missing although its step was applied before this call (appliedVersion),
+// so a database migrated under a SQLite without FTS5/trigram gets the index once
+// the library supports it. Everything created is IF NOT EXISTS; the backfill only
+// runs together with the table.
+bool ensureFullTextIndexes(QSqlDatabase &db, int appliedVersion) {
+	for (const FullTextTable &t : kFullTextTables) {
+		if (t.version > appliedVersion) continue;
+		QSqlQuery q(db);
+		if (tableExists(q, t.table)) continue;
+		if (!db.transaction()) {
+			qDebug() << "[Migration] begin transaction failed:" << db.lastError().text();
+			return false;
+		}
+		const bool ok = t.create(q);
+		q.finish();
+		if (!ok || !db.commit()) {
+			qDebug() << "[Migration] retry of" << t.table << "failed, rolling back:" << db.lastError().text();
+			db.rollback();
+			return false;
+		}
+	}
+	return true;
+}
+
+// Adds createEpoch / updateEpoch / hrLastLoginEpoch where missing and backfills
+// them from the TEXT columns. Times are stored as local "yyyy-MM-dd HH:MM:SS",
+// so the 'utc' modifier converts them the same way QDateTime does at ingest
+// (SQLNS::timeEpoch); unparseable values become 0.
+bool addEpochColumns(QSqlQuery &q) {
+	const QList<QPair<QString, QString>> columns = {
+		{"createEpoch", "createTime"},
+		{"updateEpoch", "updateTime"},
+		{"hrLastLoginEpoch", "hrLastLoginTime"},
+	};
+	for (const auto &c : columns) {
+		if (!columnExists(q, "Job", c.first)
+			&& !execStatement(q, QStringLiteral("ALTER TABLE Job ADD COLUMN %1 INTEGER").arg(c.first))) {
+			return false;
+		}
+		if (!execStatement(q, QStringLiteral("UPDATE Job SET %1 = COALESCE(CAST(strftime('%s', %2, 'utc') AS INTEGER), 0) "
+											 "WHERE %1 IS NULL").arg(c.first, c.second))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+const std::vector<Migration> &migrations() {
+	static const std::vector<Migration> kMigrations = {
+		{1, "Job.sourceId column (legacy databases)", [](QSqlQuery &q) {
+			if (columnExists(q, "Job", "sourceId")) return true;
+			return execStatement(q, "ALTER TABLE Job ADD COLUMN sourceId INTEGER");
+		}},
+		// Secondary indexes driven by the presenter's filters (source / city / recruit type + slab / tag)
+		{2, "index Job(sourceId)", [](QSqlQuery &q) {
+			return execStatement(q, "CREATE INDEX IF NOT EXISTS idx_job_source ON Job(sourceId)");
+		}},
+		{3, "index Job(cityId)", [](QSqlQuery &q) {
+			return execStatement(q, "CREATE INDEX IF NOT EXISTS idx_job_city ON Job(cityId)");
+		}},
+		{4, "index Job(recruitTypeId, salarySlabId)", [](QSqlQuery &q) {
+			return execStatement(q, "CREATE INDEX IF NOT EXISTS idx_job_recruit_slab ON Job(recruitTypeId, salarySlabId)");
+		}},
+		{5, "index JobTagMapping(tagId, jobId)", [](QSqlQuery &q) {
+			// PK is (jobId, tagId); this covers the reverse lookup tag -> jobs
+			return execStatement(q, "CREATE INDEX IF NOT EXISTS idx_jobtag_tag_job ON JobTagMapping(tagId, jobId)");
+		}},
+		// Sort keys used by keyset pagination (queryJobsPage): ORDER BY key, jobId LIMIT n
+		{6, "indexes for keyset sort keys", [](QSqlQuery &q) {
+			return execStatement(q, "CREATE INDEX IF NOT EXISTS idx_job_name_id ON Job(jobName, jobId)")
+				&& execStatement(q, "CREATE INDEX IF NOT EXISTS idx_job_salarymin_id ON Job(salaryMin, jobId)")
+				&& execStatement(q, "CREATE INDEX IF NOT EXISTS idx_job_salarymax_id ON Job(salaryMax, jobId)");
+		}},
+		// Full-text index over job name / requirements / company / city / tags, see createJobFts()
+		{7, "FTS5 JobFts table and sync triggers", [](QSqlQuery &q) {
+			return createJobFts(q);
+		}},
+		// Data generation counter, bumped by writers after each ingest batch;
+		// readers key their caches on it (see SQLInterface::dataGeneration)
+		{8, "DbMeta table with data generation", [](QSqlQuery &q) {
+			return execStatement(q, "CREATE TABLE IF NOT EXISTS DbMeta ("
+									" key TEXT PRIMARY KEY,"
+									" value INTEGER NOT NULL"
+									")")
+				&& execStatement(q, "INSERT OR IGNORE INTO DbMeta(key, value) VALUES('generation', 0)");
+		}},
+		// Expression indexes on the normalized monthly salary bounds, used by the
+		// monthlySalaryMin / Max / Overlap range filters (see SQLInterface::monthlySalaryLowSql)
+		{9, "indexes on normalized monthly salary bounds", [](QSqlQuery &q) {
+			return execStatement(q, "CREATE INDEX IF NOT EXISTS idx_job_monthly_low ON Job("
+									+ SQLInterface::monthlySalaryLowSql() + ")")
+				&& execStatement(q, "CREATE INDEX IF NOT EXISTS idx_job_monthly_high ON Job("
+									+ SQLInterface::monthlySalaryHighSql() + ")");
+		}},
+		// Integer epoch copies of the TEXT time columns (filled by insertJob from now on),
+		// indexed for sort-by-recency keyset paging and "within N days" filters
+		{10, "Job epoch time columns and indexes", [](QSqlQuery &q) {
+			return addEpochColumns(q)
+				&& execStatement(q, "CREATE INDEX IF NOT EXISTS idx_job_create_epoch_id ON Job(createEpoch, jobId)")
+				&& execStatement(q, "CREATE INDEX IF NOT EXISTS idx_job_update_epoch_id ON Job(updateEpoch, jobId)")
+				&& execStatement(q, "CREATE INDEX IF NOT EXISTS idx_job_hrlogin_epoch_id ON Job(hrLastLoginEpoch, jobId)");
+		}},
+		// Near-duplicate groups (see sqlinterface_dedup.cpp): canonical job per group,
+		// MinHash signature per processed job and the LSH band buckets it was filed under.
+		// Existing rows get no signature, so groupNearDuplicates() backfills them.
+		{11, "near-duplicate groups: canonicalJobId, MinHash signatures, LSH buckets", [](QSqlQuery &q) {
+			if (!columnExists(q, "Job", "canonicalJobId")
+				&& !execStatement(q, "ALTER TABLE Job ADD COLUMN canonicalJobId INTEGER NOT NULL DEFAULT 0")) {
+				return false;
+			}
+			return execStatement(q, "CREATE INDEX IF NOT EXISTS idx_job_canonical ON Job(canonicalJobId, jobId)")
+				&& execStatement(q, "CREATE TABLE IF NOT EXISTS JobMinHash ("
+									" jobId INTEGER PRIMARY KEY,"
+									" signature BLOB"
+									")")
+				&& execStatement(q, "CREATE TABLE IF NOT EXISTS JobLshBucket ("
+									" bucket INTEGER NOT NULL,"
+									" jobId INTEGER NOT NULL,"
+									" PRIMARY KEY(bucket, jobId)"
+									") WITHOUT ROWID");
+		}},
+		// Synthetic IDs of string-keyed sources moved from std::hash (unstable across builds,
+		// company truncated to int) to a seeded XXH64. The old inputs are not stored, so rows
+		// cannot be rewritten here: the pre-existing job / company ids are recorded as pending
+		// and SQLInterface::remapLegacyJobId / remapLegacyCompanyId rewrite each one the next
+		// time the crawler sees it (see sqlinterface_remap.cpp). Kind 0 = job, 1 = company.
+		// Only zhipin / chinahr rows are recorded (Job.sourceId as assigned by SOURCE_ID_MAP;
+		// Company has no source, so companies are those referenced by these jobs): the other
+		// sources use their numeric ids unchanged, so an entry for them could only be hit by
+		// a hash collision that would then rewrite an unrelated row.
+		// Limitation: the crawler recomputes the legacy id with the std::hash of the build that
+		// is running. Rows written by a build with a different std::hash (another compiler or
+		// standard library) never match; they stay pending and the re-crawled copy is stored
+		// as a new job, grouped with the old one by near-duplicate detection.
+		{12, "pending remaps of legacy synthetic job / company ids", [](QSqlQuery &q) {
+			const QString sourceIds = QStringLiteral("%1, %2")
+				.arg(SOURCE_ID_MAP.at("zhipin")).arg(SOURCE_ID_MAP.at("chinahr"));
+			return execStatement(q, "CREATE TABLE IF NOT EXISTS LegacyIdRemap ("
+									" kind INTEGER NOT NULL,"
+									" legacyId INTEGER NOT NULL,"
+									" PRIMARY KEY(kind, legacyId)"
+									") WITHOUT ROWID")
+				&& execStatement(q, QStringLiteral("INSERT OR IGNORE INTO LegacyIdRemap(kind, legacyId) "
+													"SELECT 0, jobId FROM Job WHERE sourceId IN (%1)").arg(sourceIds))
+				&& execStatement(q, QStringLiteral("INSERT OR IGNORE INTO LegacyIdRemap(kind, legacyId) "
+													"SELECT DISTINCT 1, companyId FROM Job "
+													"WHERE sourceId IN (%1) AND companyId IS NOT NULL").arg(sourceIds));
+		}},
+		// Incremental crawls: list-page fingerprint per job (job_fingerprint, written by SqlTask
+		// after each store). The index covers the per-source (jobId, fingerprint) load, so
+		// queryJobFingerprints never touches the table. Existing rows stay NULL = not known yet.
+		{13, "Job.fingerprint for the known-job index", [](QSqlQuery &q) {
+			if (!columnExists(q, "Job", "fingerprint")
+				&& !execStatement(q, "ALTER TABLE Job ADD COLUMN fingerprint INTEGER")) {
+				return false;
+			}
+			return execStatement(q, "CREATE INDEX IF NOT EXISTS idx_job_source_fingerprint ON Job(sourceId, jobId, fingerprint)");
+		}},
+		// Bigram index for 1-2 character queries, see createJobBigram()
+		{14, "FTS5 JobBigram table, pending queue and invalidation triggers", [](QSqlQuery &q) {
+			return createJobBigram(q);
+		}},
+		// job_fts_au used to fire on any Job update (fingerprint, canonicalJobId, epochs),
+		// rebuilding the JobFts row with its tag subquery for every stored job. Replace it
+		// with the column-scoped version; without JobFts there is nothing to replace
+		// (ensureFullTextIndexes creates the scoped trigger together with the table).
+		{15, "scope job_fts_au to the indexed Job columns", [](QSqlQuery &q) {
+			if (!tableExists(q, "JobFts")) return true;
+			return execStatement(q, "DROP TRIGGER IF EXISTS job_fts_au")
+				&& execStatement(q, jobFtsUpdateTrigger());
+		}},
+	};
+	return kMigrations;
+}
+
+} // namespace
+
+int SQLInterface::schemaVersion() {
+	if (!isConnected()) return -1;
+	QSqlDatabase db = databaseForCurrentThread();
+	QSqlQuery q(db);
+	if (q.exec("PRAGMA user_version") && q.next()) {
+		return q.value(0).toInt();
+	}
+	qDebug() << "Read user_version failed:" << q.lastError().text();
+	return -1;
+}
+
+bool SQLInterface::runMigrations() {
+	if (!isConnected()) {
+		qDebug() << "Not connected; cannot run migrations.";
+		return false;
+	}
+	QSqlDatabase db = databaseForCurrentThread();
+
+	int current = schemaVersion();
+	if (current < 0) return false;
+	// Full-text steps applied in this call have just tried FTS5; only earlier ones are retried
+	const int appliedVersion = current;
+
+	for (const Migration &m : migrations()) {
+		if (m.version <= current) continue;
+
+		qDebug() << "[Migration] applying" << m.version << "-" << m.description;
+		if (!db.transaction()) {
+			qDebug() << "[Migration] begin transaction failed:" << db.lastError().text();
+			return false;
+		}
+		QSqlQuery q(db);
+		bool ok = m.apply(q)
+			&& execStatement(q, QStringLiteral("PRAGMA user_version = %1").arg(m.version));
+		q.finish();
+		if (!ok || !db.commit()) {
+			qDebug() << "[Migration] step" << m.version << "failed, rolling back:" << db.lastError().text();
+			db.rollback();
+			return false;
+		}
+		current = m.version;
+	}
+	return ensureFullTextIndexes(db, appliedVersion);
+}
@@ -0,0 +1,555 @@
+// db/sqlinterface_native.cpp
+// Native storage backend: the hot insert / bulk-read paths of SQLInterface
+// implemented directly on the sqlite3 C API.
+//
+// Compared with the QtSql path this avoids the per-call connection-registry
+// lookup (one sqlite3* per thread held in a thread_local), named-placeholder
+// rewriting and QVariant boxing (positional sqlite3_bind_* calls), and
+// re-preparing statements (sqlite3_stmt cache per connection). Column text
+// is decoded straight from sqlite3_column_text into the output structs.
+//
+// Only the write path used by SqlTask (company/city/tag/job/mapping inserts),
+// transactions, queryAllJobs, countJobs and the job cursor are routed here.
+// Schema creation, migrations, Source queries, paging and full-text search
+// keep using QtSql on the same database file.
+//
+// Built only when CMake finds a system SQLite3 (CRAWLER_NATIVE_SQLITE);
+// otherwise the stubs at the bottom keep the QtSql backend as the only one.
+#include "sqlinterface.h"
+
+#include <QDebug>
+#include <QByteArray>
+#include <QSet>
+
+#ifdef CRAWLER_NATIVE_SQLITE
+
+#include <sqlite3.h>
+#include <unordered_map>
+
+namespace {
+
+// One sqlite3 handle per thread (mirrors the per-thread QSqlDatabase) plus
+// its prepared-statement cache. Statements are keyed by the address of the
+// SQL string literal, so every call site must pass a literal.
+class NativeConnection {
+public:
+	~NativeConnection() {
+		for (auto &entry : m_statements) sqlite3_finalize(entry.second);
+		// v2: deferred close if a cursor still holds statements
+		sqlite3_close_v2(m_db);
+	}
+
+	static NativeConnection *forCurrentThread(const QString &dbFilePath);
+	static void closeForCurrentThread();
+
+	sqlite3 *handle() const { return m_db; }
+	const QString &path() const { return m_path; }
+
+	// Cached statement, reset and with cleared bindings; nullptr on prepare failure
+	sqlite3_stmt *statement(const char *sql) {
+		auto it = m_statements.find(sql);
+		if (it != m_statements.end()) {
+			sqlite3_reset(it->second);
+			sqlite3_clear_bindings(it->second);
+			return it->second;
+		}
+		sqlite3_stmt *stmt = nullptr;
+		if (sqlite3_prepare_v3(m_db, sql, -1, SQLITE_PREPARE_PERSISTENT, &stmt, nullptr) != SQLITE_OK) {
+			qDebug() << "[Native] prepare failed:" << sql << sqlite3_errmsg(m_db);
+			sqlite3_finalize(stmt);
+			return nullptr;
+		}
+		m_statements.emplace(sql, stmt);
+		return stmt;
+	}
+
+	bool exec(const char *sql) {
+		char *err = nullptr;
+		if (sqlite3_exec(m_db, sql, nullptr, nullptr, &err) != SQLITE_OK) {
+			qDebug() << "[Native]" << sql << "failed:" << (err ? err : sqlite3_errmsg(m_db));
+			sqlite3_free(err);
+			return false;
+		}
+		return true;
+	}
+
+	QString lastError() const { return QString::fromUtf8(sqlite3_errmsg(m_db)); }
+
+private:
+	sqlite3 *m_db = nullptr;
+	QString m_path;
+	std::unordered_map<const char *, sqlite3_stmt *> m_statements;
+};
+
+thread_local std::unique_ptr<NativeConnection> t_connection;
+
+NativeConnection *NativeConnection::forCurrentThread(const QString &dbFilePath) {
+	if (t_connection && t_connection->m_path == dbFilePath) return t_connection.get();
+	t_connection.reset();
+
+	std::unique_ptr<NativeConnection> conn(new NativeConnection);
+	conn->m_path = dbFilePath;
+	const QByteArray path = dbFilePath.toUtf8();
+	if (sqlite3_open_v2(path.constData(), &conn->m_db,
+						SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX, nullptr) != SQLITE_OK) {
+		qDebug() << "[Native] open failed:" << dbFilePath << conn->lastError();
+		return nullptr;
+	}
+	// Same busy timeout as the QSQLITE driver default
+	sqlite3_busy_timeout(conn->m_db, 5000);
+	t_connection = std::move(conn);
+	return t_connection.get();
+}
+
+void NativeConnection::closeForCurrentThread() {
+	t_connection.reset();
+}
+
+// Resets a cached statement when leaving scope so it does not keep a read lock open
+class StatementScope {
+public:
+	explicit StatementScope(sqlite3_stmt *stmt) : m_stmt(stmt) {}
+	~StatementScope() { if (m_stmt) sqlite3_reset(m_stmt); }
+	StatementScope(const StatementScope &) = delete;
+	StatementScope &operator=(const StatementScope &) = delete;
+private:
+	sqlite3_stmt *m_stmt;
+};
+
+void bindText(sqlite3_stmt *stmt, int index, const QString &value) {
+	const QByteArray utf8 = value.toUtf8();
+	sqlite3_bind_text(stmt, index, utf8.constData(), utf8.size(), SQLITE_TRANSIENT);
+}
+
+QString columnText(sqlite3_stmt *stmt, int column) {
+	const char *text = reinterpret_cast<const char *>(sqlite3_column_text(stmt, column));
+	return text ? QString::fromUtf8(text, sqlite3_column_bytes(stmt, column)) : QString();
+}
+
+// INSERT OR IGNORE by name, then look the id up (City / Tag)
+int insertNamed(NativeConnection *conn, const char *insertSql, const char *selectSql, const QString &name) {
+	sqlite3_stmt *ins = conn->statement(insertSql);
+	if (!ins) return -1;
+	{
+		StatementScope scope(ins);
+		bindText(ins, 1, name);
+		sqlite3_step(ins); // ignore duplicates
+	}
+	sqlite3_stmt *sel = conn->statement(selectSql);
+	if (!sel) return -1;
+	StatementScope scope(sel);
+	bindText(sel, 1, name);
+	return sqlite3_step(sel) == SQLITE_ROW ? sqlite3_column_int(sel, 0) : -1;
+}
+
+} // namespace
+
+// Two owned (uncached) statements merged by jobId, same shape as the QtSql cursor
+class NativeJobReader {
+public:
+	NativeJobReader(sqlite3 *db, bool withRequirements) {
+		const QByteArray jobsSql = QByteArrayLiteral(
+				"SELECT j.jobId, j.jobName, j.companyId, j.recruitTypeId, j.cityId, j.sourceId, ")
+			+ (withRequirements ? "j.requirements, " : "NULL, ")
+			+ QByteArrayLiteral(
+				"j.salaryMin, j.salaryMax, j.salarySlabId, j.createTime, j.updateTime, j.hrLastLoginTime, "
+				"c.companyName, r.typeName, ci.cityName, s.sourceName, "
+				"j.createEpoch, j.updateEpoch, j.hrLastLoginEpoch, j.canonicalJobId "
+				"FROM Job j "
+				"LEFT JOIN Company c ON c.companyId = j.companyId "
+				"LEFT JOIN RecruitType r ON r.recruitTypeId = j.recruitTypeId "
+				"LEFT JOIN JobCity ci ON ci.cityId = j.cityId "
+				"LEFT JOIN Source s ON s.sourceId = j.sourceId "
+				"ORDER BY j.jobId ASC");
+		if (sqlite3_prepare_v2(db, jobsSql.constData(), -1, &m_jobs, nullptr) != SQLITE_OK
+			|| sqlite3_prepare_v2(db,
+				"SELECT m.jobId, t.tagId, t.tagName FROM JobTagMapping m "
+				"JOIN JobTag t ON t.tagId = m.tagId "
+				"ORDER BY m.jobId ASC", -1, &m_tags, nullptr) != SQLITE_OK) {
+			qDebug() << "[Native] open job cursor failed:" << sqlite3_errmsg(db);
+			return;
+		}
+		m_valid = true;
+		stepTag();
+	}
+	~NativeJobReader() {
+		sqlite3_finalize(m_jobs);
+		sqlite3_finalize(m_tags);
+	}
+
+	bool isValid() const { return m_valid; }
+
+	bool next(SQLNS::JobInfoPrint &job) {
+		if (!m_valid || m_failed) return false;
+		const int rc = sqlite3_step(m_jobs);
+		if (rc != SQLITE_ROW) {
+			if (rc != SQLITE_DONE) fail(m_jobs);
+			return false;
+		}
+
+		job = SQLNS::JobInfoPrint();
+		job.jobId = sqlite3_column_int64(m_jobs, 0);
+		job.jobName = columnText(m_jobs, 1);
+		job.companyId = sqlite3_column_int64(m_jobs, 2);
+		job.recruitTypeId = sqlite3_column_int(m_jobs, 3);
+		job.cityId = sqlite3_column_int(m_jobs, 4);
+		job.sourceId = sqlite3_column_int(m_jobs, 5);
+		job.requirements = columnText(m_jobs, 6);
+		job.salaryMin = sqlite3_column_double(m_jobs, 7);
+		job.salaryMax = sqlite3_column_double(m_jobs, 8);
+		job.salarySlabId = sqlite3_column_int(m_jobs, 9);
+		job.createTime = columnText(m_jobs, 10);
+		job.updateTime = columnText(m_jobs, 11);
+		job.hrLastLoginTime = columnText(m_jobs, 12);
+		job.companyName = columnText(m_jobs, 13);
+		job.recruitTypeName = columnText(m_jobs, 14);
+		job.cityName = columnText(m_jobs, 15);
+		job.sourceName = columnText(m_jobs, 16);
+		job.createEpoch = sqlite3_column_int64(m_jobs, 17);
+		job.updateEpoch = sqlite3_column_int64(m_jobs, 18);
+		job.hrLastLoginEpoch = sqlite3_column_int64(m_jobs, 19);
+		job.canonicalJobId = sqlite3_column_int64(m_jobs, 20);
+
+		while (m_hasTag && sqlite3_column_int64(m_tags, 0) < job.jobId) stepTag();
+		while (m_hasTag && sqlite3_column_int64(m_tags, 0) == job.jobId) {
+			job.tagIds.append(sqlite3_column_int(m_tags, 1));
+			job.tagNames.append(columnText(m_tags, 2));
+			stepTag();
+		}
+		return !m_failed;
+	}
+
+	// True when a step failed (as opposed to reaching the end of the jobs)
+	bool failed() const { return m_failed; }
+
+private:
+	void stepTag() {
+		const int rc = sqlite3_step(m_tags);
+		m_hasTag = rc == SQLITE_ROW;
+		if (!m_hasTag && rc != SQLITE_DONE) fail(m_tags);
+	}
+	void fail(sqlite3_stmt *stmt) {
+		qDebug() << "[Native] job cursor step failed:" << sqlite3_errmsg(sqlite3_db_handle(stmt));
+		m_failed = true;
+	}
+
+	sqlite3_stmt *m_jobs = nullptr;
+	sqlite3_stmt *m_tags = nullptr;
+	bool m_valid = false;
+	bool m_failed = false;
+	bool m_hasTag = false;
+};
+
+JobPrintCursor::~JobPrintCursor() {
+	delete m_native;
+}
+
+bool JobPrintCursor::nextNative(SQLNS::JobInfoPrint &job) {
+	if (m_native->next(job)) return true;
+	m_error = m_native->failed();
+	return false;
+}
+
+bool SQLInterface::nativeBackendAvailable() {
+	return true;
+}
+
+bool SQLInterface::openNativeConnection() {
+	NativeConnection *conn = NativeConnection::forCurrentThread(m_dbFilePath);
+	if (!conn) return false;
+	// Job triggers write JobFts (migration 7): the linked SQLite must provide FTS5 + trigram
+	// like Qt's bundled one, checked independently of whether the schema exists yet
+	char *err = nullptr;
+	if (sqlite3_exec(conn->handle(),
+					 "CREATE VIRTUAL TABLE temp.crawler_fts_probe USING fts5(x, tokenize = 'trigram');"
+					 "DROP TABLE temp.crawler_fts_probe;", nullptr, nullptr, &err) != SQLITE_OK) {
+		qDebug() << "[Native] linked SQLite lacks FTS5 trigram, using QtSql backend:" << (err ? err : "");
+		sqlite3_free(err);
+		NativeConnection::closeForCurrentThread();
+		return false;
+	}
+	return true;
+}
+
+void SQLInterface::closeNativeConnection() {
+	NativeConnection::closeForCurrentThread();
+}
+
+bool SQLInterface::nativeExec(const char *sql) {
+	NativeConnection *conn = NativeConnection::forCurrentThread(m_dbFilePath);
+	return conn && conn->exec(sql);
+}
+
+long long SQLInterface::nativeInsertCompany(long long companyId, const QString &companyName) {
+	NativeConnection *conn = NativeConnection::forCurrentThread(m_dbFilePath);
+	if (!conn) return -1;
+	if (sqlite3_stmt *ins = conn->statement("INSERT OR IGNORE INTO Company(companyId, companyName) VALUES(?1, ?2)")) {
+		StatementScope scope(ins);
+		sqlite3_bind_int64(ins, 1, companyId);
+		bindText(ins, 2, companyName);
+		sqlite3_step(ins); // ignore duplicates silently
+	}
+	// Rename only when the name actually changed (keeps the company_fts_au trigger quiet)
+	if (!companyName.isEmpty()) {
+		if (sqlite3_stmt *upd = conn->statement("UPDATE Company SET companyName = ?1 WHERE companyId = ?2 AND companyName <> ?1")) {
+			StatementScope scope(upd);
+			bindText(upd, 1, companyName);
+			sqlite3_bind_int64(upd, 2, companyId);
+			sqlite3_step(upd);
+		}
+	}
+	sqlite3_stmt *sel = conn->statement("SELECT 1 FROM Company WHERE companyId = ?1");
+	if (!sel) return -1;
+	StatementScope scope(sel);
+	sqlite3_bind_int64(sel, 1, companyId);
+	return sqlite3_step(sel) == SQLITE_ROW ? companyId : -1;
+}
+
+int SQLInterface::nativeInsertCity(const QString &cityName) {
+	NativeConnection *conn = NativeConnection::forCurrentThread(m_dbFilePath);
+	if (!conn) return -1;
+	return insertNamed(conn, "INSERT OR IGNORE INTO JobCity(cityName) VALUES(?1)",
+					   "SELECT cityId FROM JobCity WHERE cityName = ?1", cityName);
+}
+
+int SQLInterface::nativeInsertTag(const QString &tagName) {
+	NativeConnection *conn = NativeConnection::forCurrentThread(m_dbFilePath);
+	if (!conn) return -1;
+	return insertNamed(conn, "INSERT OR IGNORE INTO JobTag(tagName) VALUES(?1)",
+					   "SELECT tagId FROM JobTag WHERE tagName = ?1", tagName);
+}
+
+long long SQLInterface::nativeInsertJob(const SQLNS::JobInfo &job) {
+	NativeConnection *conn = NativeConnection::forCurrentThread(m_dbFilePath);
+	if (!conn) return -1;
+	// Same upsert as SQLInterface::insertJob
+	sqlite3_stmt *ins = conn->statement(
+		"INSERT INTO Job(jobId, jobName, companyId, recruitTypeId, cityId, sourceId, "
+		"requirements, salaryMin, salaryMax, salarySlabId, createTime, updateTime, hrLastLoginTime, "
+		"createEpoch, updateEpoch, hrLastLoginEpoch) "
+		"VALUES(?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10, ?11, ?12, ?13, ?14, ?15, ?16) "
+		"ON CONFLICT(jobId) DO UPDATE SET jobName = excluded.jobName, companyId = excluded.companyId, "
+		"recruitTypeId = excluded.recruitTypeId, cityId = excluded.cityId, sourceId = excluded.sourceId, "
+		"requirements = COALESCE(NULLIF(excluded.requirements, ''), requirements), "
+		"salaryMin = excluded.salaryMin, salaryMax = excluded.salaryMax, salarySlabId = excluded.salarySlabId, "
+		"updateTime = excluded.updateTime, hrLastLoginTime = excluded.hrLastLoginTime, "
+		"updateEpoch = excluded.updateEpoch, hrLastLoginEpoch = excluded.hrLastLoginEpoch "
+		"WHERE jobName IS NOT excluded.jobName OR companyId IS NOT excluded.companyId "
+		"OR recruitTypeId IS NOT excluded.recruitTypeId OR cityId IS NOT excluded.cityId "
+		"OR sourceId IS NOT excluded.sourceId OR salaryMin IS NOT excluded.salaryMin "
+		"OR salaryMax IS NOT excluded.salaryMax OR salarySlabId IS NOT excluded.salarySlabId "
+		"OR updateTime IS NOT excluded.updateTime OR hrLastLoginTime IS NOT excluded.hrLastLoginTime "
+		"OR (excluded.requirements <> '' AND requirements IS NOT excluded.requirements)");
+	if (!ins) return -1;
+	{
+		StatementScope scope(ins);
+		sqlite3_bind_int64(ins, 1, job.jobId);
+		bindText(ins, 2, job.jobName);
+		sqlite3_bind_int64(ins, 3, job.companyId);
+		sqlite3_bind_int(ins, 4, job.recruitTypeId);
+		sqlite3_bind_int(ins, 5, job.cityId);
+		sqlite3_bind_int(ins, 6, job.sourceId);
+		bindText(ins, 7, job.requirements);
+		sqlite3_bind_double(ins, 8, job.salaryMin);
+		sqlite3_bind_double(ins, 9, job.salaryMax);
+		sqlite3_bind_int(ins, 10, job.salarySlabId);
+		bindText(ins, 11, job.createTime);
+		bindText(ins, 12, job.updateTime);
+		bindText(ins, 13, job.hrLastLoginTime);
+		sqlite3_bind_int64(ins, 14, SQLNS::timeEpoch(job.createTime));
+		sqlite3_bind_int64(ins, 15, SQLNS::timeEpoch(job.updateTime));
+		sqlite3_bind_int64(ins, 16, SQLNS::timeEpoch(job.hrLastLoginTime));
+		if (sqlite3_step(ins) != SQLITE_DONE) {
+			qDebug() << "[Native] Insert Job failed:" << conn->lastError();
+			qDebug() << "Job debug -> jobId:" << job.jobId << " jobName:" << job.jobName << " companyId:" << job.companyId << " sourceId:" << job.sourceId;
+			return -1;
+		}
+	}
+
+	// verify the row exists (the upsert may have left an up-to-date row untouched)
+	sqlite3_stmt *sel = conn->statement("SELECT 1 FROM Job WHERE jobId = ?1");
+	if (!sel) return -1;
+	StatementScope scope(sel);
+	sqlite3_bind_int64(sel, 1, job.jobId);
+	if (sqlite3_step(sel) == SQLITE_ROW) {
+		return job.jobId;
+	}
+	qDebug() << "[Native] Insert Job: verify select failed:" << conn->lastError();
+	return -1;
+}
+
+bool SQLInterface::nativeInsertJobTagMapping(long long jobId, int tagId) {
+	NativeConnection *conn = NativeConnection::forCurrentThread(m_dbFilePath);
+	if (!conn) return false;
+	sqlite3_stmt *ins = conn->statement("INSERT OR IGNORE INTO JobTagMapping(jobId, tagId) VALUES(?1, ?2)");
+	if (!ins) return false;
+	StatementScope scope(ins);
+	sqlite3_bind_int64(ins, 1, jobId);
+	sqlite3_bind_int(ins, 2, tagId);
+	return sqlite3_step(ins) == SQLITE_DONE;
+}
+
+bool SQLInterface::nativeReplaceJobTags(long long jobId, const QVector<int> &tagIds) {
+	NativeConnection *conn = NativeConnection::forCurrentThread(m_dbFilePath);
+	if (!conn) return false;
+	QSet<int> stale;
+	{
+		sqlite3_stmt *sel = conn->statement("SELECT tagId FROM JobTagMapping WHERE jobId = ?1");
+		if (!sel) return false;
+		StatementScope scope(sel);
+		sqlite3_bind_int64(sel, 1, jobId);
+		int rc;
+		while ((rc = sqlite3_step(sel)) == SQLITE_ROW) stale.insert(sqlite3_column_int(sel, 0));
+		if (rc != SQLITE_DONE) {
+			qDebug() << "[Native] Select JobTagMapping failed:" << conn->lastError();
+			return false;
+		}
+	}
+	QVector<int> missing;
+	for (int tagId : tagIds) {
+		if (!stale.remove(tagId)) missing.append(tagId);
+	}
+	for (int tagId : stale) {
+		sqlite3_stmt *del = conn->statement("DELETE FROM JobTagMapping WHERE jobId = ?1 AND tagId = ?2");
+		if (!del) return false;
+		StatementScope scope(del);
+		sqlite3_bind_int64(del, 1, jobId);
+		sqlite3_bind_int(del, 2, tagId);
+		if (sqlite3_step(del) != SQLITE_DONE) {
+			qDebug() << "[Native] Delete JobTagMapping failed:" << conn->lastError();
+			return false;
+		}
+	}
+	bool ok = true;
+	for (int tagId : missing) ok = nativeInsertJobTagMapping(jobId, tagId) && ok;
+	return ok;
+}
+
+bool SQLInterface::nativeUpdateJobFingerprint(long long jobId, quint64 fingerprint) {
+	NativeConnection *conn = NativeConnection::forCurrentThread(m_dbFilePath);
+	if (!conn) return false;
+	sqlite3_stmt *upd = conn->statement("UPDATE Job SET fingerprint = ?1 WHERE jobId = ?2");
+	if (!upd) return false;
+	StatementScope scope(upd);
+	// stored as the signed bit pattern, like the QtSql path
+	sqlite3_bind_int64(upd, 1, static_cast<sqlite3_int64>(fingerprint));
+	sqlite3_bind_int64(upd, 2, jobId);
+	if (sqlite3_step(upd) != SQLITE_DONE) {
+		qDebug() << "[Native] Update Job.fingerprint failed:" << conn->lastError();
+		return false;
+	}
+	return true;
+}
+
+QVector<QPair<long long, quint64>> SQLInterface::nativeQueryJobFingerprints(int sourceId, bool *ok) {
+	QVector<QPair<long long, quint64>> entries;
+	NativeConnection *conn = NativeConnection::forCurrentThread(m_dbFilePath);
+	if (!conn) return entries;
+	sqlite3_stmt *q = conn->statement(
+		"SELECT jobId, fingerprint FROM Job WHERE sourceId = ?1 AND fingerprint IS NOT NULL ORDER BY jobId");
+	if (!q) return entries;
+	StatementScope scope(q);
+	sqlite3_bind_int(q, 1, sourceId);
+	int rc;
+	while ((rc = sqlite3_step(q)) == SQLITE_ROW) {
+		entries.append({sqlite3_column_int64(q, 0), static_cast<quint64>(sqlite3_column_int64(q, 1))});
+	}
+	if (rc != SQLITE_DONE) {
+		qDebug() << "[Native] Select Job fingerprints failed:" << conn->lastError();
+		return {};
+	}
+	if (ok) *ok = true;
+	return entries;
+}
+
+QVector<SQLNS::JobInfo> SQLInterface::nativeQueryAllJobs() {
+	QVector<SQLNS::JobInfo> jobs;
+	NativeConnection *conn = NativeConnection::forCurrentThread(m_dbFilePath);
+	if (!conn) return jobs;
+
+	sqlite3_stmt *q = conn->statement(
+		"SELECT jobId, jobName, companyId, recruitTypeId, cityId, sourceId, requirements, "
+		"salaryMin, salaryMax, salarySlabId, createTime, updateTime, hrLastLoginTime "
+		"FROM Job ORDER BY jobId ASC");
+	if (!q) return jobs;
+	{
+		StatementScope scope(q);
+		while (sqlite3_step(q) == SQLITE_ROW) {
+			SQLNS::JobInfo job;
+			job.jobId = sqlite3_column_int64(q, 0);
+			job.jobName = columnText(q, 1);
+			job.companyId = sqlite3_column_int64(q, 2);
+			job.recruitTypeId = sqlite3_column_int(q, 3);
+			job.cityId = sqlite3_column_int(q, 4);
+			job.sourceId = sqlite3_column_int(q, 5);
+			job.requirements = columnText(q, 6);
+			job.salaryMin = sqlite3_column_double(q, 7);
+			job.salaryMax = sqlite3_column_double(q, 8);
+			job.salarySlabId = sqlite3_column_int(q, 9);
+			job.createTime = columnText(q, 10);
+			job.updateTime = columnText(q, 11);
+			job.hrLastLoginTime = columnText(q, 12);
+			jobs.append(job);
+		}
+	}
+
+	sqlite3_stmt *tq = conn->statement("SELECT jobId, tagId FROM JobTagMapping ORDER BY jobId ASC");
+	if (!tq) return jobs;
+	StatementScope scope(tq);
+	int idx = 0;
+	while (sqlite3_step(tq) == SQLITE_ROW) {
+		const long long jobId = sqlite3_column_int64(tq, 0);
+		while (idx < jobs.size() && jobs[idx].jobId < jobId) ++idx;
+		if (idx >= jobs.size()) break;
+		if (jobs[idx].jobId == jobId) {
+			jobs[idx].tagIds.append(sqlite3_column_int(tq, 1));
+		}
+	}
+	return jobs;
+}
+
+int SQLInterface::nativeCountJobs() {
+	NativeConnection *conn = NativeConnection::forCurrentThread(m_dbFilePath);
+	if (!conn) return 0;
+	sqlite3_stmt *q = conn->statement("SELECT COUNT(*) FROM Job");
+	if (!q) return 0;
+	StatementScope scope(q);
+	return sqlite3_step(q) == SQLITE_ROW ? sqlite3_column_int(q, 0) : 0;
+}
+
+NativeJobReader *SQLInterface::nativeJobReader(bool withRequirements) {
+	NativeConnection *conn = NativeConnection::forCurrentThread(m_dbFilePath);
+	if (!conn) return nullptr;
+	std::unique_ptr<NativeJobReader> reader(new NativeJobReader(conn->handle(), withRequirements));
+	if (!reader->isValid()) return nullptr;
+	return reader.release();
+}
+
+#else // !CRAWLER_NATIVE_SQLITE
+
+// No system SQLite3 at build time: only the QtSql backend exists and
+// m_useNative is never set, so none of these are reached.
+class NativeJobReader {};
+
+JobPrintCursor::~JobPrintCursor() {
+	delete m_native;
+}
+bool JobPrintCursor::nextNative(SQLNS::JobInfoPrint &) { return false; }
+
+bool SQLInterface::nativeBackendAvailable() { return false; }
+bool SQLInterface::openNativeConnection() { return false; }
+void SQLInterface::closeNativeConnection() {}
+bool SQLInterface::nativeExec(const char *) { return false; }
+long long SQLInterface::nativeInsertCompany(long long, const QString &) { return -1; }
+int SQLInterface::nativeInsertCity(const QString &) { return -1; }
+int SQLInterface::nativeInsertTag(const QString &) { return -1; }
+long long SQLInterface::nativeInsertJob(const SQLNS::JobInfo &) { return -1; }
+bool SQLInterface::nativeInsertJobTagMapping(long long, int) { return false; }
+bool SQLInterface::nativeReplaceJobTags(long long, const QVector<int> &) { return false; }
+bool SQLInterface::nativeUpdateJobFingerprint(long long, quint64) { return false; }
+QVector<QPair<long long, quint64>> SQLInterface::nativeQueryJobFingerprints(int, bool *) { return {}; }
+QVector<SQLNS::JobInfo> SQLInterface::nativeQueryAllJobs() { return {}; }
+int SQLInterface::nativeCountJobs() { return 0; }
+NativeJobReader *SQLInterface::nativeJobReader(bool) { return nullptr; }
+
+#endif // CRAWLER_NATIVE_SQLITE
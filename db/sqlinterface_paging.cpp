@@ -0,0 +1,336 @@
+// db/sqlinterface_paging.cpp
+// Keyset pagination with search / filter / sort pushed down to SQLite.
+//
+// The WHERE clause mirrors Presenter::searchJobs:
+// - query: pure digits -> exact jobId; otherwise the JobFts full-text index,
+//   the JobBigram index for 1-2 letters/digits (plus a LIKE over jobs still
+//   queued in JobBigramPending), or LIKE over jobName, requirements,
+//   companyName, cityName and tag names
+// - fieldFilters: AND across fields, OR within a field; unknown fields match nothing
+// Pages are addressed by the (sortKey, jobId) of the last row of the previous
+// page instead of OFFSET, so every page costs an index seek plus pageSize rows.
+// jobName is ordered by code point (SQLite BINARY collation, which idx_job_name_id
+// is built with), not by the QCollator ranks JobStore sorts with, so a name-sorted
+// SQL page can differ from the same page of the in-memory snapshot.
+#include "sqlinterface.h"
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QRegularExpression>
+#include <QStringList>
+#include <QHash>
+#include <QVariant>
+#include <QDebug>
+#include <QDateTime>
+#include <cmath>
+
+namespace {
+
+// Collects WHERE fragments and their named bind values (:p0, :p1, ...)
+class WhereBuilder {
+public:
+	QString bind(const QVariant &value) {
+		const QString name = QStringLiteral(":p%1").arg(m_binds.size());
+		m_binds.append(qMakePair(name, value));
+		return name;
+	}
+	void add(const QString &clause) { m_clauses.append(clause); }
+	QString sql() const {
+		return m_clauses.isEmpty() ? QString() : QStringLiteral(" WHERE ") + m_clauses.join(" AND ");
+	}
+	void apply(QSqlQuery &q) const {
+		for (const auto &b : m_binds) q.bindValue(b.first, b.second);
+	}
+
+private:
+	QStringList m_clauses;
+	QVector<QPair<QString, QVariant>> m_binds;
+};
+
+// LIKE pattern for a case-insensitive substring match (SQLite LIKE folds ASCII only)
+QString likePattern(const QString &value) {
+	QString escaped = value;
+	escaped.replace('\\', "\\\\").replace('%', "\\%").replace('_', "\\_");
+	return QStringLiteral("%") + escaped + QStringLiteral("%");
+}
+
+QString likeClause(WhereBuilder &w, const QString &column, const QString &value) {
+	return QStringLiteral("%1 LIKE %2 ESCAPE '\\'").arg(column, w.bind(likePattern(value)));
+}
+
+QString tagLikeClause(WhereBuilder &w, const QString &value) {
+	return QStringLiteral("EXISTS (SELECT 1 FROM JobTagMapping m JOIN JobTag t ON t.tagId = m.tagId "
+						  "WHERE m.jobId = j.jobId AND t.tagName LIKE %1 ESCAPE '\\')").arg(w.bind(likePattern(value)));
+}
+
+void addQueryClause(WhereBuilder &w, const QString &rawQuery, const QString &ftsPhrase, const QString &bigramMatch) {
+	const QString query = rawQuery.trimmed();
+	if (query.isEmpty()) return;
+
+	static const QRegularExpression digitsRegex("^\\d+$");
+	if (digitsRegex.match(query).hasMatch()) {
+		bool ok = false;
+		const long long qid = query.toLongLong(&ok);
+		w.add(ok ? QStringLiteral("j.jobId = %1").arg(w.bind(QVariant::fromValue<qlonglong>(qid)))
+				 : QStringLiteral("0"));
+		return;
+	}
+
+	// FTS5 trigram index handles queries of 3+ characters; shorter ones keep the LIKE scan
+	if (!ftsPhrase.isEmpty() && query.size() >= 3) {
+		w.add(QStringLiteral("j.jobId IN (SELECT rowid FROM JobFts WHERE JobFts MATCH %1)").arg(w.bind(ftsPhrase)));
+		return;
+	}
+
+	QStringList any;
+	any << likeClause(w, "j.jobName", query)
+		<< likeClause(w, "j.requirements", query)
+		<< likeClause(w, "c.companyName", query)
+		<< likeClause(w, "ci.cityName", query)
+		<< tagLikeClause(w, query);
+
+	// 1-2 letters/digits: bigram index, LIKE only for jobs it has not indexed yet
+	if (!bigramMatch.isEmpty()) {
+		w.add(QStringLiteral("(j.jobId IN (SELECT rowid FROM JobBigram WHERE JobBigram MATCH %1) "
+							 "OR (j.jobId IN (SELECT jobId FROM JobBigramPending) AND (%2)))")
+				  .arg(w.bind(bigramMatch), any.join(" OR ")));
+		return;
+	}
+	w.add("(" + any.join(" OR ") + ")");
+}
+
+// One salary range value; only bounded sides are emitted so each one can use
+// its expression index (high > 0 excludes jobs without salary information)
+QString salaryRangeClause(WhereBuilder &w, const SQLNS::SalaryBounds &b) {
+	const QString low = SQLInterface::monthlySalaryLowSql("j.");
+	const QString high = SQLInterface::monthlySalaryHighSql("j.");
+	QStringList all;
+	all << high + QStringLiteral(" > 0");
+	auto bound = [&w, &all](const QString &expr, const char *op, double value) {
+		if (std::isinf(value)) return;
+		all << QStringLiteral("%1 %2 %3").arg(expr, QLatin1String(op), w.bind(value));
+	};
+	bound(low, ">=", b.lowMin);
+	bound(low, "<=", b.lowMax);
+	bound(high, ">=", b.highMin);
+	bound(high, "<=", b.highMax);
+	return "(" + all.join(" AND ") + ")";
+}
+
+void addFieldFilterClauses(WhereBuilder &w, const QMap<QString, QVector<QString>> &fieldFilters) {
+	static const QMap<QString, QString> textColumns = {
+		{"jobName", "j.jobName"},
+		{"requirements", "j.requirements"},
+		{"companyName", "c.companyName"},
+		{"cityName", "ci.cityName"},
+		{"sourceName", "s.sourceName"},
+		{"recruitTypeName", "r.typeName"},
+	};
+
+	for (auto it = fieldFilters.constBegin(); it != fieldFilters.constEnd(); ++it) {
+		const QString &field = it.key();
+		const QVector<QString> &vals = it.value();
+		if (vals.isEmpty()) continue;
+		if (SQLNS::isCollapseField(field)) {
+			// a switch rather than a value list: off means no constraint at all
+			if (SQLNS::collapseEnabled(vals)) w.add(QStringLiteral("j.canonicalJobId = 0"));
+			continue;
+		}
+
+		QStringList any;
+		if (field == "jobId" || field == "salary" || field == "tagIds") {
+			QStringList ids;
+			for (const auto &v : vals) {
+				bool ok = false;
+				const long long n = v.toLongLong(&ok);
+				if (ok) ids << w.bind(QVariant::fromValue<qlonglong>(n));
+			}
+			if (!ids.isEmpty()) {
+				if (field == "jobId") {
+					any << QStringLiteral("j.jobId IN (%1)").arg(ids.join(','));
+				} else if (field == "salary") {
+					any << QStringLiteral("j.salarySlabId IN (%1)").arg(ids.join(','));
+				} else {
+					any << QStringLiteral("EXISTS (SELECT 1 FROM JobTagMapping m WHERE m.jobId = j.jobId AND m.tagId IN (%1))").arg(ids.join(','));
+				}
+			}
+		} else if (textColumns.contains(field)) {
+			for (const auto &v : vals) any << likeClause(w, textColumns.value(field), v);
+		} else if (field == "tagNames" || field == "tags") {
+			for (const auto &v : vals) any << tagLikeClause(w, v);
+		} else if (SQLNS::isSalaryRangeField(field)) {
+			for (const auto &v : vals) {
+				SQLNS::SalaryBounds b;
+				if (SQLNS::salaryBounds(field, v, &b)) any << salaryRangeClause(w, b);
+			}
+		} else if (SQLNS::isRecencyField(field)) {
+			// epoch 0 means unknown and never matches; the epoch indexes (migration 10) serve the range
+			const QString column = field == "postedWithinDays" ? QStringLiteral("j.createEpoch") : QStringLiteral("j.hrLastLoginEpoch");
+			const qint64 now = QDateTime::currentSecsSinceEpoch();
+			for (const auto &v : vals) {
+				qint64 cutoff = 0;
+				if (!SQLNS::recencyCutoff(v, now, &cutoff)) continue;
+				any << QStringLiteral("(%1 > 0 AND %1 >= %2)").arg(column, w.bind(QVariant::fromValue<qlonglong>(cutoff)));
+			}
+		}
+		// unknown field or no parsable value: match nothing (same as Presenter::searchJobs)
+		w.add(any.isEmpty() ? QStringLiteral("0") : "(" + any.join(" OR ") + ")");
+	}
+}
+
+// Sort column for a presenter sort field name; falls back to jobId.
+// jobName compares by code point (see the file comment)
+QString sortColumn(const QString &field) {
+	const QString key = field.trimmed().toLower();
+	if (key == "jobname" || key == "job_name") return QStringLiteral("j.jobName");
+	if (key == "salarymin" || key == "salary_min") return QStringLiteral("j.salaryMin");
+	if (key == "salarymax" || key == "salary_max") return QStringLiteral("j.salaryMax");
+	if (key == "createtime" || key == "create_time") return QStringLiteral("j.createEpoch");
+	if (key == "updatetime" || key == "update_time") return QStringLiteral("j.updateEpoch");
+	if (key == "hrlastlogintime" || key == "hr_last_login_time") return QStringLiteral("j.hrLastLoginEpoch");
+	return QStringLiteral("j.jobId");
+}
+
+const char *kPageFrom =
+	" FROM Job j"
+	" LEFT JOIN Company c ON c.companyId = j.companyId"
+	" LEFT JOIN RecruitType r ON r.recruitTypeId = j.recruitTypeId"
+	" LEFT JOIN JobCity ci ON ci.cityId = j.cityId"
+	" LEFT JOIN Source s ON s.sourceId = j.sourceId";
+
+} // namespace
+
+QString SQLInterface::monthlySalaryLowSql(const QString &prefix) {
+	return QStringLiteral("(CASE WHEN %1recruitTypeId = 2 THEN %1salaryMin * %2 ELSE %1salaryMin * 1000 END)")
+		.arg(prefix, QString::number(SQLNS::kInternWorkDaysPerMonth));
+}
+
+QString SQLInterface::monthlySalaryHighSql(const QString &prefix) {
+	return QStringLiteral("(CASE WHEN %1recruitTypeId = 2 THEN MAX(%1salaryMin, %1salaryMax) * %2 ELSE MAX(%1salaryMin, %1salaryMax) * 1000 END)")
+		.arg(prefix, QString::number(SQLNS::kInternWorkDaysPerMonth));
+}
+
+SQLNS::JobPage SQLInterface::queryJobsPage(const SQLNS::JobPageQuery &pageQuery) {
+	SQLNS::JobPage page;
+	if (!isConnected()) return page;
+	QSqlDatabase db = databaseForCurrentThread();
+	const int pageSize = pageQuery.pageSize > 0 ? pageQuery.pageSize : 20;
+
+	WhereBuilder where;
+	addQueryClause(where, pageQuery.query,
+				   hasFullTextIndex() ? ftsPhrase(pageQuery.query.trimmed()) : QString(),
+				   hasBigramIndex() ? bigramMatch(pageQuery.query.trimmed()) : QString());
+	addFieldFilterClauses(where, pageQuery.fieldFilters);
+
+	// Total count ignores the keyset position
+	if (pageQuery.withTotal) {
+		QSqlQuery qc(db);
+		qc.prepare(QStringLiteral("SELECT COUNT(*)") + kPageFrom + where.sql());
+		where.apply(qc);
+		if (qc.exec() && qc.next()) {
+			page.totalCount = qc.value(0).toInt();
+		} else {
+			qDebug() << "Count page failed:" << qc.lastError().text();
+		}
+	}
+
+	// Keyset: rows strictly after (afterSortKey, afterJobId) in (key asc|desc, jobId asc) order.
+	// Ties on the sort key keep jobId ascending, matching the presenter's stable sort.
+	const QString key = sortColumn(pageQuery.sortField);
+	const bool keyIsJobId = (key == "j.jobId");
+	const QString cmp = pageQuery.asc ? QStringLiteral(">") : QStringLiteral("<");
+	if (pageQuery.hasCursor) {
+		if (keyIsJobId) {
+			where.add(QStringLiteral("j.jobId %1 %2").arg(cmp, where.bind(QVariant::fromValue<qlonglong>(pageQuery.afterJobId))));
+		} else {
+			const QString k1 = where.bind(pageQuery.afterSortKey);
+			const QString k2 = where.bind(pageQuery.afterSortKey);
+			const QString id = where.bind(QVariant::fromValue<qlonglong>(pageQuery.afterJobId));
+			where.add(QStringLiteral("(%1 %2 %3 OR (%1 = %4 AND j.jobId > %5))").arg(key, cmp, k1, k2, id));
+		}
+	}
+	QString orderBy = QStringLiteral(" ORDER BY %1 %2").arg(key, pageQuery.asc ? QStringLiteral("ASC") : QStringLiteral("DESC"));
+	if (!keyIsJobId) orderBy += QStringLiteral(", j.jobId ASC");
+
+	QSqlQuery q(db);
+	q.setForwardOnly(true);
+	q.prepare(QStringLiteral(
+		"SELECT j.jobId, j.jobName, j.companyId, j.recruitTypeId, j.cityId, j.sourceId, j.requirements, "
+		"j.salaryMin, j.salaryMax, j.salarySlabId, j.createTime, j.updateTime, j.hrLastLoginTime, "
+		"c.companyName, r.typeName, ci.cityName, s.sourceName, "
+		"j.createEpoch, j.updateEpoch, j.hrLastLoginEpoch, j.canonicalJobId, %1")
+		.arg(key) + kPageFrom + where.sql() + orderBy + QStringLiteral(" LIMIT %1").arg(pageSize + 1));
+	where.apply(q);
+	if (!q.exec()) {
+		qDebug() << "Select page failed:" << q.lastError().text();
+		return page;
+	}
+	QVariant lastKey;
+	while (q.next()) {
+		if (page.rows.size() == pageSize) {
+			page.hasMore = true;
+			break;
+		}
+		SQLNS::JobInfoPrint job;
+		job.jobId = q.value(0).toLongLong();
+		job.jobName = q.value(1).toString();
+		job.companyId = q.value(2).toLongLong();
+		job.recruitTypeId = q.value(3).toInt();
+		job.cityId = q.value(4).toInt();
+		job.sourceId = q.value(5).toInt();
+		job.requirements = q.value(6).toString();
+		job.salaryMin = q.value(7).toDouble();
+		job.salaryMax = q.value(8).toDouble();
+		job.salarySlabId = q.value(9).toInt();
+		job.createTime = q.value(10).toString();
+		job.updateTime = q.value(11).toString();
+		job.hrLastLoginTime = q.value(12).toString();
+		job.companyName = q.value(13).toString();
+		job.recruitTypeName = q.value(14).toString();
+		job.cityName = q.value(15).toString();
+		job.sourceName = q.value(16).toString();
+		job.createEpoch = q.value(17).toLongLong();
+		job.updateEpoch = q.value(18).toLongLong();
+		job.hrLastLoginEpoch = q.value(19).toLongLong();
+		job.canonicalJobId = q.value(20).toLongLong();
+		lastKey = q.value(21);
+		page.rows.append(job);
+	}
+	if (!page.rows.isEmpty()) {
+		page.lastSortKey = lastKey;
+		page.lastJobId = page.rows.last().jobId;
+	}
+
+	fillTagsForJobs(page.rows);
+	return page;
+}
+
+void SQLInterface::fillTagsForJobs(QVector<SQLNS::JobInfoPrint> &jobs) {
+	if (jobs.isEmpty() || !isConnected()) return;
+	QSqlDatabase db = databaseForCurrentThread();
+
+	QHash<long long, int> indexById;
+	QStringList placeholders;
+	for (int i = 0; i < jobs.size(); ++i) {
+		indexById.insert(jobs[i].jobId, i);
+		placeholders << QStringLiteral(":id%1").arg(i);
+	}
+	QSqlQuery tq(db);
+	tq.setForwardOnly(true);
+	tq.prepare(QStringLiteral("SELECT m.jobId, t.tagId, t.tagName FROM JobTagMapping m "
+							  "JOIN JobTag t ON t.tagId = m.tagId WHERE m.jobId IN (%1)").arg(placeholders.join(',')));
+	for (int i = 0; i < jobs.size(); ++i) {
+		tq.bindValue(placeholders[i], QVariant::fromValue<qlonglong>(jobs[i].jobId));
+	}
+	if (!tq.exec()) {
+		qDebug() << "Select page tags failed:" << tq.lastError().text();
+		return;
+	}
+	while (tq.next()) {
+		auto it = indexById.constFind(tq.value(0).toLongLong());
+		if (it == indexById.constEnd()) continue;
+		jobs[it.value()].tagIds.append(tq.value(1).toInt());
+		jobs[it.value()].tagNames.append(tq.value(2).toString());
+	}
+}
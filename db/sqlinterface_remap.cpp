@@ -0,0 +1,121 @@
+// db/sqlinterface_remap.cpp
+// Rewrites legacy synthetic job / company ids to their stable replacements.
+//
+// Sources that only expose string keys (BOSS直聘, 中华英才网) used to derive
+// ids with std::hash, which changes between builds and standard libraries, so
+// a rebuilt crawler saw every stored job as new. Ids now come from a seeded
+// XXH64 (stable_synthetic_id). The crawler still computes the old std::hash
+// value alongside; when that value names a row recorded as pending by
+// migration 12 (LegacyIdRemap), the row and everything keyed on it move to the
+// stable id and the pending entry is consumed. Rows written by a build whose
+// std::hash differs from the current one cannot be matched and stay as they
+// are (near-duplicate grouping still collapses them with their re-crawled copy).
+#include "sqlinterface.h"
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QVariant>
+#include <QDebug>
+#include <QStringList>
+
+namespace {
+
+enum RemapKind { JobKind = 0, CompanyKind = 1 };
+
+bool execBound(QSqlDatabase &db, const QString &sql, long long stableId, long long legacyId) {
+	QSqlQuery q(db);
+	q.prepare(sql);
+	if (sql.contains(":stable")) q.bindValue(":stable", QVariant::fromValue<qlonglong>(stableId));
+	q.bindValue(":legacy", QVariant::fromValue<qlonglong>(legacyId));
+	if (!q.exec()) {
+		qDebug() << "[Remap] statement failed:" << sql << q.lastError().text();
+		return false;
+	}
+	return true;
+}
+
+bool rowExists(QSqlDatabase &db, const QString &sql, long long id) {
+	QSqlQuery q(db);
+	q.prepare(sql);
+	q.bindValue(":id", QVariant::fromValue<qlonglong>(id));
+	return q.exec() && q.next();
+}
+
+bool isPending(QSqlDatabase &db, RemapKind kind, long long legacyId) {
+	QSqlQuery q(db);
+	q.prepare("SELECT 1 FROM LegacyIdRemap WHERE kind = :kind AND legacyId = :id");
+	q.bindValue(":kind", static_cast<int>(kind));
+	q.bindValue(":id", QVariant::fromValue<qlonglong>(legacyId));
+	return q.exec() && q.next();
+}
+
+// Runs the rewrite statements and consumes the pending entry in one transaction
+bool applyRemap(QSqlDatabase &db, RemapKind kind, long long legacyId, long long stableId, const QStringList &statements) {
+	if (!db.transaction()) {
+		qDebug() << "[Remap] begin transaction failed:" << db.lastError().text();
+		return false;
+	}
+	bool ok = true;
+	for (const QString &sql : statements) {
+		if (!(ok = execBound(db, sql, stableId, legacyId))) break;
+	}
+	if (ok) {
+		QSqlQuery q(db);
+		q.prepare("DELETE FROM LegacyIdRemap WHERE kind = :kind AND legacyId = :id");
+		q.bindValue(":kind", static_cast<int>(kind));
+		q.bindValue(":id", QVariant::fromValue<qlonglong>(legacyId));
+		ok = q.exec();
+	}
+	if (!ok || !db.commit()) {
+		qDebug() << "[Remap] rolling back" << legacyId << "->" << stableId << ":" << db.lastError().text();
+		db.rollback();
+		return false;
+	}
+	return true;
+}
+
+} // namespace
+
+bool SQLInterface::remapLegacyJobId(long long legacyId, long long stableId) {
+	if (!isConnected() || legacyId == stableId) return false;
+	QSqlDatabase db = databaseForCurrentThread();
+	if (!isPending(db, JobKind, legacyId)) return false;
+	if (!rowExists(db, "SELECT 1 FROM Job WHERE jobId = :id", legacyId)
+		|| rowExists(db, "SELECT 1 FROM Job WHERE jobId = :id", stableId)) {
+		// nothing to move, or the stable row was stored first: keep both rows, stop checking
+		QSqlQuery q(db);
+		q.prepare("DELETE FROM LegacyIdRemap WHERE kind = 0 AND legacyId = :id");
+		q.bindValue(":id", QVariant::fromValue<qlonglong>(legacyId));
+		q.exec();
+		return false;
+	}
+	// The Job row moves last: its job_fts_au / job_bigram_au triggers re-index the job
+	// under the stable id and look its tags up by that id, so JobTagMapping must already
+	// be re-keyed (JobTagMapping has no UPDATE trigger that would repair it later)
+	const bool ok = applyRemap(db, JobKind, legacyId, stableId, {
+		"UPDATE JobTagMapping SET jobId = :stable WHERE jobId = :legacy",
+		"UPDATE JobMinHash SET jobId = :stable WHERE jobId = :legacy",
+		"UPDATE JobLshBucket SET jobId = :stable WHERE jobId = :legacy",
+		"UPDATE Job SET canonicalJobId = :stable WHERE canonicalJobId = :legacy",
+		"UPDATE Job SET jobId = :stable WHERE jobId = :legacy",
+	});
+	if (ok) qDebug() << "[Remap] job" << legacyId << "->" << stableId;
+	return ok;
+}
+
+bool SQLInterface::remapLegacyCompanyId(long long legacyId, long long stableId) {
+	if (!isConnected() || legacyId == stableId) return false;
+	QSqlDatabase db = databaseForCurrentThread();
+	if (!isPending(db, CompanyKind, legacyId)) return false;
+	// The Company row moves (only if the stable id is still free) before the jobs follow,
+	// so the job triggers find the company name under the stable id when re-indexing
+	QStringList statements;
+	const bool stableTaken = rowExists(db, "SELECT 1 FROM Company WHERE companyId = :id", stableId);
+	if (!stableTaken) statements << "UPDATE Company SET companyId = :stable WHERE companyId = :legacy";
+	statements << "UPDATE Job SET companyId = :stable WHERE companyId = :legacy";
+	if (stableTaken) statements << "DELETE FROM Company WHERE companyId = :legacy";
+	const bool ok = applyRemap(db, CompanyKind, legacyId, stableId, statements);
+	if (ok) qDebug() << "[Remap] company" << legacyId << "->" << stableId;
+	return ok;
+}
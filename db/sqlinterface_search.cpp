@@ -0,0 +1,263 @@
+// db/sqlinterface_search.cpp
+// Full-text job search over the JobFts FTS5 table (created by migration 7) and,
+// for 1-2 character queries, the JobBigram table (migration 14).
+#include "sqlinterface.h"
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QVariant>
+#include <QDebug>
+#include <QStringList>
+
+bool SQLInterface::hasFullTextIndex() {
+	if (!isConnected()) return false;
+	QSqlDatabase db = databaseForCurrentThread();
+	QSqlQuery q(db);
+	return q.exec("SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'JobFts'") && q.next();
+}
+
+bool SQLInterface::hasBigramIndex() {
+	if (!isConnected()) return false;
+	QSqlDatabase db = databaseForCurrentThread();
+	QSqlQuery q(db);
+	return q.exec("SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'JobBigram'") && q.next();
+}
+
+namespace {
+
+void appendCodePoint(QString &out, uint cp) {
+	if (QChar::requiresSurrogates(cp)) {
+		out.append(QChar(QChar::highSurrogate(cp)));
+		out.append(QChar(QChar::lowSurrogate(cp)));
+	} else {
+		out.append(QChar(cp));
+	}
+}
+
+} // namespace
+
+QString SQLInterface::bigramText(const QString &text) {
+	// Every letter/digit emits itself plus its successor when that is a letter/digit too;
+	// the last character of a run is emitted alone. unicode61 case-folds the tokens.
+	QString out;
+	const QList<uint> cps = text.toUcs4();
+	for (int i = 0; i < cps.size(); ++i) {
+		if (!QChar::isLetterOrNumber(cps[i])) continue;
+		if (!out.isEmpty()) out.append(QLatin1Char(' '));
+		appendCodePoint(out, cps[i]);
+		if (i + 1 < cps.size() && QChar::isLetterOrNumber(cps[i + 1])) appendCodePoint(out, cps[i + 1]);
+	}
+	return out;
+}
+
+QString SQLInterface::bigramMatch(const QString &query) {
+	// Two characters are exactly one JobBigram token; one character is the prefix of
+	// the tokens that start with it (which include the lone run-final token)
+	const QList<uint> cps = query.toUcs4();
+	if (cps.isEmpty() || cps.size() > 2) return QString();
+	for (uint cp : cps) {
+		if (!QChar::isLetterOrNumber(cp)) return QString();
+	}
+	return cps.size() == 2 ? ftsPhrase(query) : ftsPhrase(query) + QLatin1Char('*');
+}
+
+QString SQLInterface::ftsPhrase(const QString &query) {
+	// One quoted FTS5 phrase; with the trigram tokenizer this is a substring match
+	QString escaped = query;
+	escaped.replace('"', "\"\"");
+	return QStringLiteral("\"") + escaped + QStringLiteral("\"");
+}
+
+QVector<long long> SQLInterface::searchJobIds(const QString &query, int limit, bool *ok) {
+	QVector<long long> ids;
+	if (ok) *ok = false;
+	const QString text = query.trimmed();
+	if (text.isEmpty() || !hasFullTextIndex()) return ids;
+
+	QSqlDatabase db = databaseForCurrentThread();
+	QSqlQuery q(db);
+	q.setForwardOnly(true);
+	const QString limitSql = limit > 0 ? QStringLiteral(" LIMIT %1").arg(limit) : QString();
+	// 1-2 letters/digits: JobBigram token / prefix lookup, then the jobs still queued for it
+	const QString bigram = hasBigramIndex() ? bigramMatch(text) : QString();
+	if (!bigram.isEmpty()) {
+		q.prepare(QStringLiteral("SELECT rowid FROM JobBigram WHERE JobBigram MATCH :q "
+								 "ORDER BY bm25(JobBigram, 10.0, 1.0, 3.0, 3.0, 5.0)") + limitSql);
+		q.bindValue(":q", bigram);
+		if (!q.exec()) {
+			qDebug() << "Bigram search failed:" << q.lastError().text();
+			return ids;
+		}
+		while (q.next()) ids.append(q.value(0).toLongLong());
+		if (limit > 0 && ids.size() >= limit) {
+			if (ok) *ok = true;
+			return ids;
+		}
+	}
+	if (!bigram.isEmpty() || text.size() < 3) {
+		// Trigrams cannot match 1-2 character queries (common for Chinese, e.g. "后端"):
+		// LIKE over the FTS table, ranked by the first column that matches. With the bigram
+		// index this only covers jobs not indexed yet (JobBigramPending, normally empty);
+		// without it (or for queries with punctuation) it scans every job.
+		const int remaining = limit > 0 ? limit - static_cast<int>(ids.size()) : -1;
+		q.prepare(QStringLiteral("SELECT rowid FROM JobFts "
+								 "WHERE %1(jobName LIKE :p0 ESCAPE '\\' OR tagNames LIKE :p1 ESCAPE '\\' "
+								 "OR companyName LIKE :p2 ESCAPE '\\' OR cityName LIKE :p3 ESCAPE '\\' "
+								 "OR requirements LIKE :p4 ESCAPE '\\') "
+								 "ORDER BY CASE WHEN jobName LIKE :p5 ESCAPE '\\' THEN 0 "
+								 "WHEN tagNames LIKE :p6 ESCAPE '\\' THEN 1 "
+								 "WHEN companyName LIKE :p7 ESCAPE '\\' OR cityName LIKE :p8 ESCAPE '\\' THEN 2 "
+								 "ELSE 3 END, rowid")
+				  .arg(bigram.isEmpty() ? QString() : QStringLiteral("rowid IN (SELECT jobId FROM JobBigramPending) AND "))
+				  + (remaining > 0 ? QStringLiteral(" LIMIT %1").arg(remaining) : QString()));
+		QString escaped = text;
+		escaped.replace('\\', "\\\\").replace('%', "\\%").replace('_', "\\_");
+		const QString pattern = QStringLiteral("%") + escaped + QStringLiteral("%");
+		for (int i = 0; i < 9; ++i) q.bindValue(QStringLiteral(":p%1").arg(i), pattern);
+	} else {
+		// Column weights: jobName > tagNames > companyName = cityName > requirements
+		q.prepare(QStringLiteral("SELECT rowid FROM JobFts WHERE JobFts MATCH :q "
+								 "ORDER BY bm25(JobFts, 10.0, 1.0, 3.0, 3.0, 5.0)") + limitSql);
+		q.bindValue(":q", ftsPhrase(text));
+	}
+	if (!q.exec()) {
+		qDebug() << "Full-text search failed:" << q.lastError().text();
+		return ids;
+	}
+	while (q.next()) {
+		ids.append(q.value(0).toLongLong());
+	}
+	if (ok) *ok = true;
+	return ids;
+}
+
+int SQLInterface::indexPendingBigrams() {
+	if (!isConnected()) return -1;
+	if (!hasBigramIndex()) return 0;
+	QSqlDatabase db = databaseForCurrentThread();
+	// Batches keep each transaction (and the rows held in memory) bounded on a first backfill
+	const int kBatch = 500;
+	int indexed = 0;
+	for (;;) {
+		QSqlQuery q(db);
+		q.setForwardOnly(true);
+		if (!q.exec(QStringLiteral(
+				"SELECT p.jobId, j.jobId IS NOT NULL, j.jobName, j.requirements, c.companyName, ci.cityName, "
+				"(SELECT group_concat(t.tagName, ' ') FROM JobTagMapping m JOIN JobTag t ON t.tagId = m.tagId "
+				"WHERE m.jobId = p.jobId) "
+				"FROM JobBigramPending p "
+				"LEFT JOIN Job j ON j.jobId = p.jobId "
+				"LEFT JOIN Company c ON c.companyId = j.companyId "
+				"LEFT JOIN JobCity ci ON ci.cityId = j.cityId "
+				"ORDER BY p.jobId LIMIT %1").arg(kBatch))) {
+			qDebug() << "Bigram pending query failed:" << q.lastError().text();
+			return -1;
+		}
+		struct Row { long long jobId; bool exists; QString columns[5]; };
+		QVector<Row> rows;
+		while (q.next()) {
+			Row row;
+			row.jobId = q.value(0).toLongLong();
+			row.exists = q.value(1).toBool();
+			for (int i = 0; i < 5; ++i) row.columns[i] = bigramText(q.value(2 + i).toString());
+			rows.append(row);
+		}
+		q.finish();
+		if (rows.isEmpty()) break;
+
+		// Joins the caller's transaction if one is open
+		const bool ownTransaction = db.transaction();
+		QSqlQuery del(db), ins(db), done(db);
+		del.prepare("DELETE FROM JobBigram WHERE rowid = :id");
+		ins.prepare("INSERT INTO JobBigram(rowid, jobName, requirements, companyName, cityName, tagNames) "
+					"VALUES(:id, :n, :r, :c, :ci, :t)");
+		done.prepare("DELETE FROM JobBigramPending WHERE jobId = :id");
+		bool ok = true;
+		for (const Row &row : rows) {
+			const QVariant id = QVariant::fromValue<qlonglong>(row.jobId);
+			del.bindValue(":id", id);
+			ok = del.exec();
+			if (ok && row.exists) {
+				ins.bindValue(":id", id);
+				ins.bindValue(":n", row.columns[0]);
+				ins.bindValue(":r", row.columns[1]);
+				ins.bindValue(":c", row.columns[2]);
+				ins.bindValue(":ci", row.columns[3]);
+				ins.bindValue(":t", row.columns[4]);
+				ok = ins.exec();
+			}
+			if (ok) {
+				done.bindValue(":id", id);
+				ok = done.exec();
+			}
+			if (!ok) {
+				qDebug() << "Bigram index write failed:" << del.lastError().text() << ins.lastError().text() << done.lastError().text();
+				break;
+			}
+		}
+		if (ownTransaction) {
+			if (!ok) {
+				db.rollback();
+			} else if (!db.commit()) {
+				qDebug() << "Bigram index commit failed:" << db.lastError().text();
+				db.rollback();
+				ok = false;
+			}
+		}
+		if (!ok) return -1;
+		indexed += rows.size();
+		if (rows.size() < kBatch) break;
+	}
+	return indexed;
+}
+
+QHash<long long, QString> SQLInterface::queryRequirements(const QVector<long long> &jobIds) {
+	QHash<long long, QString> texts;
+	if (jobIds.isEmpty() || !isConnected()) return texts;
+	QSqlDatabase db = databaseForCurrentThread();
+	// Chunked to stay well below SQLite's bound-parameter limit
+	const int kChunk = 500;
+	for (int from = 0; from < jobIds.size(); from += kChunk) {
+		const int n = qMin(kChunk, static_cast<int>(jobIds.size()) - from);
+		QStringList placeholders;
+		for (int i = 0; i < n; ++i) placeholders << QStringLiteral(":id%1").arg(i);
+		QSqlQuery q(db);
+		q.setForwardOnly(true);
+		q.prepare(QStringLiteral("SELECT jobId, requirements FROM Job WHERE jobId IN (%1)").arg(placeholders.join(',')));
+		for (int i = 0; i < n; ++i) q.bindValue(placeholders[i], QVariant::fromValue<qlonglong>(jobIds[from + i]));
+		if (!q.exec()) {
+			qDebug() << "Select requirements failed:" << q.lastError().text();
+			return texts;
+		}
+		while (q.next()) texts.insert(q.value(0).toLongLong(), q.value(1).toString());
+	}
+	return texts;
+}
+
+QVector<long long> SQLInterface::searchRequirementIds(const QVector<QString> &needles) {
+	QVector<long long> ids;
+	if (!isConnected()) return ids;
+	QStringList clauses;
+	QStringList patterns;
+	for (const QString &needle : needles) {
+		if (needle.isEmpty()) continue;
+		QString escaped = needle;
+		escaped.replace('\\', "\\\\").replace('%', "\\%").replace('_', "\\_");
+		clauses << QStringLiteral("requirements LIKE :p%1 ESCAPE '\\'").arg(patterns.size());
+		patterns << QStringLiteral("%") + escaped + QStringLiteral("%");
+	}
+	if (clauses.isEmpty()) return ids;
+
+	QSqlDatabase db = databaseForCurrentThread();
+	QSqlQuery q(db);
+	q.setForwardOnly(true);
+	q.prepare(QStringLiteral("SELECT jobId FROM Job WHERE ") + clauses.join(" OR ") + QStringLiteral(" ORDER BY jobId"));
+	for (int i = 0; i < patterns.size(); ++i) q.bindValue(QStringLiteral(":p%1").arg(i), patterns[i]);
+	if (!q.exec()) {
+		qDebug() << "Search requirements failed:" << q.lastError().text();
+		return ids;
+	}
+	while (q.next()) ids.append(q.value(0).toLongLong());
+	return ids;
+}
@@ -2,6 +2,8 @@
 #include "test/test.h"
 #include "config/config_manager.h"
 #include "maintenance/logger.h"
+#include "db/sqlinterface.h"
+#include "presenter/presenter.h"
 
 #include <QApplication>
 #include <QDebug>
@@ -21,6 +23,33 @@ int main(int argc, char *argv[])
         qDebug() << "⚠️  配置文件加载失败，将使用默认值\n";
     }
 
+    // ========== 存储后端选择（config.json "sqlBackend": "qtsql" | "native"） ==========
+    if (ConfigManager::getSqlBackend() == "native") {
+        if (SQLInterface::setBackend(SQLInterface::Backend::NativeSqlite)) {
+            qDebug() << "✓ 存储后端: 原生 sqlite3 C API\n";
+        } else {
+            qDebug() << "⚠️  未编译原生 SQLite 后端，使用 QtSql\n";
+        }
+    }
+
+    // ========== 数据库建表与迁移（启动时执行一次） ==========
+    {
+        SQLInterface sql;
+        if (sql.connectSqlite(Presenter::DEFAULT_DB_PATH) && sql.createAllTables()) {
+            qDebug() << "✓ 数据库 schema 版本:" << sql.schemaVersion() << "\n";
+            // 近重复分组：补齐尚无 MinHash 签名的职位（迁移前的旧数据；之后入库时逐条分组）
+            const int linked = sql.groupNearDuplicates();
+            if (linked > 0) qDebug() << "✓ 近重复分组: 新归组" << linked << "条职位\n";
+            // 二元组索引：补建迁移 14 排队的旧职位（及上次退出前未建完的职位）
+            const int bigrams = sql.indexPendingBigrams();
+            if (bigrams > 0) qDebug() << "✓ 二元组索引: 补建" << bigrams << "条职位\n";
+        } else {
+            qDebug() << "⚠️  数据库初始化/迁移失败\n";
+        }
+        sql.disconnect();
+        qDebug() << "  SQLInterface 活动连接数:" << SQLInterface::connectionCount() << "\n";
+    }
+
     // ========== 单元测试 ==========
     // qDebug() << "\n========== UNIT TESTS ==========" << "\n";
 
@@ -45,6 +74,14 @@ int main(int argc, char *argv[])
     // qDebug() << "PresenterTask 功能测试 - 数据查询与处理";
     // test_presenter_task();
 
+    // SQLInterface 加载基准 - 行数 vs 全量加载耗时
+    // qDebug() << "\n========== SQL BENCHMARK ==========\n";
+    // test_sql_benchmark();
+
+    // 搜索基准 - 分词 / 建索引 / 查询延迟
+    // qDebug() << "\n========== SEARCH BENCHMARK ==========\n";
+    // test_search_benchmark();
+
     // 启动GUI应用
     qDebug() << "\n========== Launching GUI ==========";
     LauncherWindow w;
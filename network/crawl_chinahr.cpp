@@ -57,7 +57,7 @@ static std::string fetch_text_page(const std::string& url) {
     return resp;
 }
 
-std::pair<std::vector<JobInfo>, MappingData> parseChinahrResponse(const json &json_data, int pageSize) {
+std::pair<std::vector<JobInfo>, MappingData> parseChinahrResponse(const json &json_data, int pageSize, const KnownJobFilter &isKnown) {
     std::vector<JobInfo> jobs;
     MappingData mapping;
     try {
@@ -110,14 +110,21 @@ std::pair<std::vector<JobInfo>, MappingData> parseChinahrResponse(const json &js
 
         for (const auto &it : items) {
             try {
-                JobInfo job;
+                JobInfo job{};
                 std::string jobId = it.value("jobId", "");
-                if (!jobId.empty()) job.info_id = std::hash<std::string>{}(jobId);
+                if (!jobId.empty()) {
+                    job.info_id = stable_synthetic_id("chinahr", jobId);
+                    // 旧版 ID 仅用于重映射迁移 12 登记的旧行，只能匹配同一 std::hash 实现的构建写入的行
+                    job.legacy_info_id = static_cast<int64_t>(std::hash<std::string>{}(jobId));
+                }
 
                 job.info_name = it.value("jobName", "");
                 job.company_name = it.value("comName", "");
                 std::string comId = it.value("comId", "");
-                if (!comId.empty()) job.company_id = std::hash<std::string>{}(comId);
+                if (!comId.empty()) {
+                    job.company_id = stable_synthetic_id("chinahr", comId);
+                    job.legacy_company_id = static_cast<int>(std::hash<std::string>{}(comId));
+                }
 
                 // 薪资解析：优先判断是否含 K/k
                 std::string salary_desc = it.value("salary", "");
@@ -157,8 +164,9 @@ std::pair<std::vector<JobInfo>, MappingData> parseChinahrResponse(const json &js
                 }
                 job.area_name = it.value("workPlace", "");
 
-                // 尝试请求详情页并解析 area 信息（简单字符串抽取）以及 requirements
-                if (!jobId.empty()) {
+                // 尝试请求详情页并解析 area 信息（简单字符串抽取）以及 requirements；增量爬取时已知且未变的职位跳过
+                const bool known = isKnown && isKnown(job.info_id, job_fingerprint(job));
+                if (!jobId.empty() && !known) {
                     std::string detail_url = std::string("https://www.chinahr.com/detail/") + jobId;
                     // 尝试抓取详情页；若响应提示“请求过于频繁，请稍后重试！”，则等待并重试（最多重试 5 次）
                     std::string html;
@@ -274,7 +282,7 @@ std::pair<std::vector<JobInfo>, MappingData> parseChinahrResponse(const json &js
     return {jobs, mapping};
 }
 
-std::pair<std::vector<JobInfo>, MappingData> crawlChinahr(int page, int pageSize, const std::string &localId) {
+std::pair<std::vector<JobInfo>, MappingData> crawlChinahr(int page, int pageSize, const std::string &localId, const KnownJobFilter &isKnown) {
     try {
         static bool curl_initialized = false;
         if (!curl_initialized) {
@@ -293,7 +301,7 @@ std::pair<std::vector<JobInfo>, MappingData> crawlChinahr(int page, int pageSize
             return {{}, {}};
         }
 
-        auto [jobs, mapping] = parseChinahrResponse(*json_data_opt, pageSize);
+        auto [jobs, mapping] = parseChinahrResponse(*json_data_opt, pageSize, isKnown);
 
         return {jobs, mapping};
     } catch (const std::exception &e) {
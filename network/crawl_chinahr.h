@@ -14,8 +14,9 @@ namespace ChinahrCrawler {
 std::map<std::string, std::string> getChinahrHeaders();
 std::string buildChinahrUrl();
 std::string buildChinahrPostData(int page, int pageSize, const std::string &localId = "1");
-std::pair<std::vector<JobInfo>, MappingData> parseChinahrResponse(const json &json_data, int pageSize);
-std::pair<std::vector<JobInfo>, MappingData> crawlChinahr(int page, int pageSize, const std::string &localId = "1");
+// isKnown 非空时（增量爬取），判定为已知且未变的职位不再请求详情页
+std::pair<std::vector<JobInfo>, MappingData> parseChinahrResponse(const json &json_data, int pageSize, const KnownJobFilter &isKnown = {});
+std::pair<std::vector<JobInfo>, MappingData> crawlChinahr(int page, int pageSize, const std::string &localId = "1", const KnownJobFilter &isKnown = {});
 
 } // namespace ChinahrCrawler
 
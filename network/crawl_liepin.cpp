@@ -11,6 +11,7 @@
 #include <QJsonArray>
 #include <QRegularExpression>
 #include "webview2_browser_wrl.h"
+#include "job_crawler.h"
 #include <curl/curl.h>
 #include <thread>
 #include <chrono>
@@ -44,7 +45,8 @@ static std::string fetch_text_page_liepin(const std::string& url) {
 
 using namespace LiepinCrawler;
 
-std::pair<std::vector<JobInfo>, MappingData> LiepinCrawler::crawlLiepin(int pageNo, int pageSize, const std::string& city, WebView2BrowserWRL* browser) {
+std::pair<std::vector<JobInfo>, MappingData> LiepinCrawler::crawlLiepin(int pageNo, int pageSize, const std::string& city, WebView2BrowserWRL* browser,
+                                                                        const KnownJobFilter& isKnown) {
     qDebug() << "[LiepinCrawler] Starting capture for page" << pageNo << "pageSize" << pageSize << "city" << QString::fromStdString(city);
 
     std::unique_ptr<WebView2BrowserWRL> ownedBrowser;
@@ -163,7 +165,7 @@ std::pair<std::vector<JobInfo>, MappingData> LiepinCrawler::crawlLiepin(int page
 
         // company
         ji.company_name = comp.value("compName").toString().toStdString();
-        ji.company_id = comp.value("compId").toInt();
+        ji.company_id = comp.value("compId").toVariant().toLongLong();
 
         // area
         ji.area_name = job.value("dq").toString().toStdString();
@@ -209,9 +211,10 @@ std::pair<std::vector<JobInfo>, MappingData> LiepinCrawler::crawlLiepin(int page
             }
         }
 
-        // 尝试抓取详情页并解析职位介绍（job-intro-container）
+        // 尝试抓取详情页并解析职位介绍（job-intro-container）；增量爬取时已知且未变的职位跳过
         QString link = item.value("job").toObject().value("link").toString();
-        if (!link.isEmpty()) {
+        const bool known = isKnown && isKnown(ji.info_id, job_fingerprint(ji));
+        if (!link.isEmpty() && !known) {
             std::string detail_url = link.toStdString();
             // 简单的节奏控制，避免请求过快
             std::this_thread::sleep_for(std::chrono::milliseconds(200));
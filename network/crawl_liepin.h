@@ -13,7 +13,9 @@ namespace LiepinCrawler {
 
 // 启动一次WebView2页面，捕获后台API响应并保存原始JSON；
 // 当前不做解析，返回空结果。调用者应在收到提示后确认映射，然后请求解析实现。
-std::pair<std::vector<JobInfo>, MappingData> crawlLiepin(int pageNo, int pageSize, const std::string& city = "410", class WebView2BrowserWRL* browser = nullptr);
+// isKnown 非空时（增量爬取），判定为已知且未变的职位不再抓取详情页
+std::pair<std::vector<JobInfo>, MappingData> crawlLiepin(int pageNo, int pageSize, const std::string& city = "410", class WebView2BrowserWRL* browser = nullptr,
+                                                         const KnownJobFilter& isKnown = {});
 
 }
 
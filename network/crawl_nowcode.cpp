@@ -135,7 +135,7 @@ std::pair<std::vector<JobInfo>, MappingData> parseNowcodeResponse(const json& js
             if (job.info_name.empty()) job.info_name = get_string_safe(d, "jobTitle", "");
 
             job.company_name = get_string_safe(d, "companyName", "");
-            job.company_id = static_cast<int>(get_int64_safe(d, "companyId", 0));
+            job.company_id = get_int64_safe(d, "companyId", 0);
 
             job.area_name = get_string_safe(d, "jobCity", "");
             job.area_id = 0;
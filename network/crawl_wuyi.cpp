@@ -178,7 +178,7 @@ std::pair<std::vector<JobInfo>, MappingData> WuyiCrawler::crawlWuyi(int pageNo,
                 ji.company_name = o.value("companyName").toString().toStdString();
                 QString coId = o.value("coId").toString();
                 if (coId.isEmpty()) coId = o.value("coId").toVariant().toString();
-                ji.company_id = coId.toInt();
+                ji.company_id = coId.toLongLong();
 
                 // area
                 ji.area_name = o.value("jobAreaString").toString().toStdString();
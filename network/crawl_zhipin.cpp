@@ -102,9 +102,11 @@ std::pair<std::vector<JobInfo>, MappingData> parseZhipinResponse(const json& jso
                 
                 // 基本信息
                 if (job_item.contains("encryptJobId")) {
-                    // 使用encryptJobId的哈希值作为jobId
+                    // 使用encryptJobId的稳定哈希作为jobId（std::hash 的旧值只用于重映射旧数据，
+                    // 且只能匹配同一 std::hash 实现的构建写入的旧行，见迁移 12）
                     std::string encrypt_id = job_item["encryptJobId"].get<std::string>();
-                    job.info_id = std::hash<std::string>{}(encrypt_id);
+                    job.info_id = stable_synthetic_id("zhipin", encrypt_id);
+                    job.legacy_info_id = static_cast<int64_t>(std::hash<std::string>{}(encrypt_id));
                 }
                 
                 job.info_name = job_item.value("jobName", "");
@@ -113,7 +115,8 @@ std::pair<std::vector<JobInfo>, MappingData> parseZhipinResponse(const json& jso
                 job.company_name = job_item.value("brandName", "");
                 if (job_item.contains("encryptBrandId")) {
                     std::string brand_id = job_item["encryptBrandId"].get<std::string>();
-                    job.company_id = std::hash<std::string>{}(brand_id);
+                    job.company_id = stable_synthetic_id("zhipin", brand_id);
+                    job.legacy_company_id = static_cast<int>(std::hash<std::string>{}(brand_id));
                 }
                 
                 // 地区信息
@@ -37,6 +37,16 @@ int get_int_safe(const json& obj, const char* key, int def = 0);
 int64_t get_int64_safe(const json& obj, const char* key, int64_t def = 0);
 double get_double_safe(const json& obj, const char* key, double def = 0.0);
 std::string get_string_safe(const json& obj, const char* key, const std::string& def = "");
+// Stable IDs for sources whose API only exposes string keys (BOSS直聘 encryptJobId, 中华英才网 jobId ...).
+// xxhash64 is XXH64 (byte-order independent); stable_synthetic_id hashes key with a per-source seed and maps it
+// into [kSyntheticIdBase, 2^63): positive, never overlapping the numeric IDs other sources report, and identical
+// across builds / standard libraries (std::hash is neither).
+constexpr uint64_t kSyntheticIdBase = 1ULL << 62;
+uint64_t xxhash64(const void* data, size_t len, uint64_t seed = 0);
+int64_t stable_synthetic_id(const std::string& source, const std::string& key);
+// Content fingerprint over the list-page fields of a job (title, company, city, type, salary, tags). Detail-page
+// text and crawl-time timestamps are left out, so a parser can compute it before deciding to fetch the detail page.
+uint64_t job_fingerprint(const JobInfo& job);
 void print_data_formatted(const std::vector<JobInfo>& job_info_list,
                           const std::vector<TypeInfo>& type_list,
                           const std::vector<AreaInfo>& area_list,
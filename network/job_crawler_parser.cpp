@@ -351,7 +351,7 @@ std::pair<std::vector<JobInfo>, MappingData> parse_job_data(const json& json_dat
                             for (const auto& identity : identity_list) {
                                 if (!identity.is_object()) continue;
                                 if (identity.contains("companyId")) {
-                                    job_info.company_id = get_int_safe(identity, "companyId", 0);
+                                    job_info.company_id = get_int64_safe(identity, "companyId", 0);
                                 }
                                 if (identity.contains("companyName")) {
                                     job_info.company_name = get_string_safe(identity, "companyName", "");
@@ -370,7 +370,7 @@ std::pair<std::vector<JobInfo>, MappingData> parse_job_data(const json& json_dat
 
                 // 兼容：若 identity 未提供则尝试顶层 companyId/companyName（新样式）
                 if ((job_info.company_id == 0 || job_info.company_name.empty())) {
-                    int fallback_company_id = get_int_safe(job_data, "companyId", 0);
+                    int64_t fallback_company_id = get_int64_safe(job_data, "companyId", 0);
                     std::string fallback_company_name = get_string_safe(job_data, "companyName", "");
                     if (fallback_company_id > 0 && !fallback_company_name.empty()) {
                         job_info.company_id = fallback_company_id;
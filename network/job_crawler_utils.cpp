@@ -4,6 +4,7 @@
 #include <sstream>
 #include <regex>
 #include <algorithm>
+#include <cmath>
 // helpers are declared in job_crawler.h
 
 // Debug info print function
@@ -136,3 +137,110 @@ std::string get_string_safe(const json& obj, const char* key, const std::string&
     if (it->is_string()) return it->get<std::string>();
     return def;
 }
+
+// ========== Stable synthetic IDs ==========
+
+namespace {
+
+constexpr uint64_t kXxPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t kXxPrime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t kXxPrime3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t kXxPrime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t kXxPrime5 = 0x27D4EB2F165667C5ULL;
+
+inline uint64_t rotl64(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+// little-endian reads, independent of the host byte order
+inline uint64_t read_le64(const unsigned char* p) {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) v = (v << 8) | p[i];
+    return v;
+}
+inline uint32_t read_le32(const unsigned char* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8)
+           | (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+inline uint64_t xx_round(uint64_t acc, uint64_t input) {
+    acc += input * kXxPrime2;
+    acc = rotl64(acc, 31);
+    return acc * kXxPrime1;
+}
+
+inline uint64_t xx_merge(uint64_t acc, uint64_t val) {
+    acc ^= xx_round(0, val);
+    return acc * kXxPrime1 + kXxPrime4;
+}
+
+} // namespace
+
+uint64_t xxhash64(const void* data, size_t len, uint64_t seed) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    const unsigned char* const end = p + len;
+    uint64_t h;
+    if (len >= 32) {
+        uint64_t v1 = seed + kXxPrime1 + kXxPrime2;
+        uint64_t v2 = seed + kXxPrime2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - kXxPrime1;
+        const unsigned char* const limit = end - 32;
+        do {
+            v1 = xx_round(v1, read_le64(p));
+            v2 = xx_round(v2, read_le64(p + 8));
+            v3 = xx_round(v3, read_le64(p + 16));
+            v4 = xx_round(v4, read_le64(p + 24));
+            p += 32;
+        } while (p <= limit);
+        h = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+        h = xx_merge(h, v1);
+        h = xx_merge(h, v2);
+        h = xx_merge(h, v3);
+        h = xx_merge(h, v4);
+    } else {
+        h = seed + kXxPrime5;
+    }
+    h += static_cast<uint64_t>(len);
+    for (; p + 8 <= end; p += 8) {
+        h ^= xx_round(0, read_le64(p));
+        h = rotl64(h, 27) * kXxPrime1 + kXxPrime4;
+    }
+    if (p + 4 <= end) {
+        h ^= static_cast<uint64_t>(read_le32(p)) * kXxPrime1;
+        h = rotl64(h, 23) * kXxPrime2 + kXxPrime3;
+        p += 4;
+    }
+    for (; p < end; ++p) {
+        h ^= (*p) * kXxPrime5;
+        h = rotl64(h, 11) * kXxPrime1;
+    }
+    h ^= h >> 33;
+    h *= kXxPrime2;
+    h ^= h >> 29;
+    h *= kXxPrime3;
+    h ^= h >> 32;
+    return h;
+}
+
+int64_t stable_synthetic_id(const std::string& source, const std::string& key) {
+    // per-source seed keeps equal keys from different sources apart
+    const uint64_t seed = xxhash64(source.data(), source.size(), 0);
+    const uint64_t h = xxhash64(key.data(), key.size(), seed);
+    return static_cast<int64_t>((h >> 2) | kSyntheticIdBase);
+}
+
+uint64_t job_fingerprint(const JobInfo& job) {
+    // 只取列表页即可得到的字段（不含详情页的 requirements、抓取时刻生成的时间）；薪资按 0.01 取整后转为整数，避免 locale 影响
+    std::string text;
+    auto append = [&text](const std::string& field) {
+        text += field;
+        text.push_back('\x1F');
+    };
+    append(job.info_name);
+    append(job.company_name);
+    append(job.area_name);
+    append(std::to_string(job.type_id));
+    append(std::to_string(std::llround(job.salary_min * 100)));
+    append(std::to_string(std::llround(job.salary_max * 100)));
+    for (const auto& tag : job.tag_names) append(tag);
+    return xxhash64(text.data(), text.size(), 0);
+}
@@ -0,0 +1,30 @@
+#include "known_job_index.h"
+#include <algorithm>
+
+void KnownJobIndex::assign(std::vector<std::pair<int64_t, uint64_t>> entries) {
+    m_recent.clear();
+    m_sorted.clear();
+    m_sorted.reserve(entries.size());
+    // stable_sort + 逆序去重：同一 jobId 保留最后出现的一条
+    std::stable_sort(entries.begin(), entries.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (i + 1 < entries.size() && entries[i + 1].first == entries[i].first) continue;
+        m_sorted.push_back({entries[i].first, entries[i].second});
+    }
+    m_sorted.shrink_to_fit();
+}
+
+void KnownJobIndex::insert(int64_t jobId, uint64_t fingerprint) {
+    m_recent[jobId] = fingerprint;
+}
+
+KnownJobIndex::State KnownJobIndex::lookup(int64_t jobId, uint64_t fingerprint) const {
+    auto recent = m_recent.find(jobId);
+    if (recent != m_recent.end()) return recent->second == fingerprint ? State::Known : State::Changed;
+
+    auto it = std::lower_bound(m_sorted.begin(), m_sorted.end(), jobId,
+                               [](const Entry& e, int64_t id) { return e.jobId < id; });
+    if (it == m_sorted.end() || it->jobId != jobId) return State::Unknown;
+    return it->fingerprint == fingerprint ? State::Known : State::Changed;
+}
@@ -0,0 +1,49 @@
+#ifndef KNOWN_JOB_INDEX_H
+#define KNOWN_JOB_INDEX_H
+
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @file known_job_index.h
+ * @brief 增量爬取用的已知职位集合（单个来源）
+ *
+ * 持久化数据是 Job 表的 (sourceId, jobId, fingerprint)（迁移 13，覆盖索引），
+ * 每个来源开始爬取时整体读入一次：按 jobId 排序的紧凑数组（每条 16 字节）二分查找；
+ * 本次爬取中新入库的职位放在一个小哈希表里，不改动排序数组。
+ * 每个来源各用一个实例，不做加锁。
+ */
+class KnownJobIndex {
+public:
+    enum class State {
+        Unknown,   // 库中没有该职位
+        Changed,   // 有该职位，但列表字段的指纹不同
+        Known      // 有该职位且指纹一致
+    };
+
+    // 用 (jobId, fingerprint) 列表整体替换内容（顺序任意，内部排序；jobId 重复时保留后者）
+    void assign(std::vector<std::pair<int64_t, uint64_t>> entries);
+    // 记录本次爬取新入库 / 内容变化的职位
+    void insert(int64_t jobId, uint64_t fingerprint);
+
+    State lookup(int64_t jobId, uint64_t fingerprint) const;
+    bool contains(int64_t jobId, uint64_t fingerprint) const { return lookup(jobId, fingerprint) == State::Known; }
+
+    // 仅用于日志：内容变化后重新记录的职位会计两次
+    size_t size() const { return m_sorted.size() + m_recent.size(); }
+    bool empty() const { return size() == 0; }
+
+private:
+    struct Entry {
+        int64_t jobId;
+        uint64_t fingerprint;
+    };
+
+    std::vector<Entry> m_sorted;                       // 按 jobId 递增
+    std::unordered_map<int64_t, uint64_t> m_recent;    // 本次爬取写入，优先于 m_sorted
+};
+
+#endif // KNOWN_JOB_INDEX_H
@@ -0,0 +1,253 @@
+// presenter/bm25_index.cpp
+#include "bm25_index.h"
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+#include <QDebug>
+#include <cmath>
+
+namespace {
+
+// 字段权重：标题 > 标签 > 公司 > 岗位要求
+constexpr double kFieldWeights[Bm25Index::FieldCount] = {3.0, 2.0, 1.5, 1.0};
+constexpr double kK1 = 1.2;
+constexpr double kB = 0.75;
+
+} // namespace
+
+QStringList Bm25Index::fieldTexts(const SQLNS::JobInfoPrint &job) {
+    QStringList tags(job.tagNames.begin(), job.tagNames.end());
+    return {job.jobName, tags.join(QLatin1Char(' ')), job.companyName, job.requirements};
+}
+
+QString Bm25Index::pathForDatabase(const QString &dbPath) {
+    return dbPath + ".bm25";
+}
+
+Bm25Index::Bm25Index(const Segmenter *segmenter) : m_segmenter(segmenter) {}
+
+// 共享词表首次使用时才加载（静态索引对象构造时 QCoreApplication 可能尚未创建）
+const Segmenter &Bm25Index::segmenter() const {
+    if (!m_segmenter) m_segmenter = &Segmenter::shared();
+    return *m_segmenter;
+}
+
+void Bm25Index::clear() {
+    m_docJobId.clear();
+    m_fieldLengths.clear();
+    m_docLive.clear();
+    m_docByJobId.clear();
+    m_signatures.clear();
+    m_postings.clear();
+    for (qint64 &sum : m_lengthSum) sum = 0;
+    m_dirty = true;
+}
+
+// 有效状态变化时同步维护各字段长度之和（BM25 的平均长度只统计有效文档）
+void Bm25Index::setLive(quint32 docId, bool live) {
+    if (m_docLive[docId] == live) return;
+    m_docLive[docId] = live;
+    for (int f = 0; f < FieldCount; ++f) {
+        const qint64 length = m_fieldLengths[docId * FieldCount + f];
+        m_lengthSum[f] += live ? length : -length;
+    }
+}
+
+bool Bm25Index::isCurrent(long long jobId, quint64 sig) const {
+    auto it = m_signatures.constFind(jobId);
+    return it != m_signatures.constEnd() && it.value() == sig;
+}
+
+bool Bm25Index::addJob(long long jobId, const QStringList &fields, quint64 sig) {
+    if (isCurrent(jobId, sig)) return false;
+
+    auto old = m_docByJobId.constFind(jobId);
+    if (old != m_docByJobId.constEnd()) setLive(old.value(), false);
+
+    const quint32 docId = static_cast<quint32>(m_docJobId.size());
+    QHash<QString, Posting> terms;
+    for (int f = 0; f < FieldCount; ++f) {
+        const QStringList tokens = f < fields.size() ? segmenter().segmentForSearch(fields[f]) : QStringList();
+        m_fieldLengths.append(static_cast<quint16>(qMin<qsizetype>(tokens.size(), 0xFFFF)));
+        for (const QString &token : tokens) {
+            auto it = terms.find(token);
+            if (it == terms.end()) it = terms.insert(token, Posting{docId, {0, 0, 0, 0}});
+            if (it.value().tf[f] < 0xFFFF) ++it.value().tf[f];
+        }
+    }
+    for (auto it = terms.constBegin(); it != terms.constEnd(); ++it) m_postings[it.key()].append(it.value());
+
+    m_docJobId.append(jobId);
+    m_docLive.append(false);
+    setLive(docId, true);
+    m_docByJobId.insert(jobId, docId);
+    m_signatures.insert(jobId, sig);
+    m_dirty = true;
+    return true;
+}
+
+void Bm25Index::retainOnly(const QSet<long long> &jobIds) {
+    for (auto it = m_docByJobId.begin(); it != m_docByJobId.end();) {
+        if (jobIds.contains(it.key())) {
+            ++it;
+        } else {
+            setLive(it.value(), false);
+            m_signatures.remove(it.key());
+            it = m_docByJobId.erase(it);
+            m_dirty = true;
+        }
+    }
+}
+
+bool Bm25Index::needsCompaction() const {
+    const int dead = m_docJobId.size() - m_docByJobId.size();
+    return dead > 0 && dead > m_docByJobId.size();
+}
+
+QHash<long long, double> Bm25Index::scores(const QString &query) const {
+    QHash<long long, double> result;
+    const int docCount = m_docByJobId.size();
+    if (docCount == 0) return result;
+
+    double avgLength[FieldCount];
+    for (int f = 0; f < FieldCount; ++f) {
+        avgLength[f] = m_lengthSum[f] > 0 ? static_cast<double>(m_lengthSum[f]) / docCount : 1.0;
+    }
+
+    QStringList terms = segmenter().segment(query);
+    terms.removeDuplicates();
+    for (const QString &term : terms) {
+        auto list = m_postings.constFind(term);
+        if (list == m_postings.constEnd()) continue;
+
+        int df = 0;
+        for (const Posting &p : list.value()) {
+            if (m_docLive[p.docId]) ++df;
+        }
+        if (df == 0) continue;
+        const double idf = std::log(1.0 + (docCount - df + 0.5) / (df + 0.5));
+
+        for (const Posting &p : list.value()) {
+            if (!m_docLive[p.docId]) continue;
+            // BM25F：各字段词频按字段长度归一化后加权求和，再统一饱和
+            double tf = 0;
+            for (int f = 0; f < FieldCount; ++f) {
+                if (p.tf[f] == 0) continue;
+                const double norm = 1.0 - kB + kB * m_fieldLengths[p.docId * FieldCount + f] / avgLength[f];
+                tf += kFieldWeights[f] * p.tf[f] / norm;
+            }
+            result[m_docJobId[p.docId]] += idf * tf * (kK1 + 1.0) / (kK1 + tf);
+        }
+    }
+    return result;
+}
+
+bool Bm25Index::save(const QString &path) {
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "Bm25Index: cannot write" << path << file.errorString();
+        return false;
+    }
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << kMagic << kVersion << segmenter().dictionarySignature();
+    out << static_cast<qint32>(m_docJobId.size());
+    for (int d = 0; d < m_docJobId.size(); ++d) {
+        out << static_cast<qint64>(m_docJobId[d]);
+        for (int f = 0; f < FieldCount; ++f) out << m_fieldLengths[d * FieldCount + f];
+    }
+    out << static_cast<qint32>(m_docByJobId.size());
+    for (auto it = m_docByJobId.constBegin(); it != m_docByJobId.constEnd(); ++it) {
+        out << static_cast<qint64>(it.key()) << it.value() << m_signatures.value(it.key());
+    }
+    out << static_cast<qint32>(m_postings.size());
+    for (auto it = m_postings.constBegin(); it != m_postings.constEnd(); ++it) {
+        out << it.key() << static_cast<qint32>(it.value().size());
+        for (const Posting &p : it.value()) {
+            out << p.docId;
+            for (int f = 0; f < FieldCount; ++f) out << p.tf[f];
+        }
+    }
+    if (out.status() != QDataStream::Ok || !file.commit()) {
+        qDebug() << "Bm25Index: failed to save" << path;
+        return false;
+    }
+    m_dirty = false;
+    return true;
+}
+
+bool Bm25Index::load(const QString &path) {
+    clear();
+    m_dirty = false;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0, version = 0;
+    quint64 dictionary = 0;
+    in >> magic >> version >> dictionary;
+    if (magic != kMagic || version != kVersion || dictionary != segmenter().dictionarySignature()) {
+        qDebug() << "Bm25Index: ignoring incompatible index file" << path;
+        return false;
+    }
+
+    qint32 docCount = 0;
+    in >> docCount;
+    m_docJobId.reserve(qMax(docCount, 0));
+    m_fieldLengths.reserve(qMax(docCount, 0) * FieldCount);
+    for (qint32 i = 0; i < docCount && in.status() == QDataStream::Ok; ++i) {
+        qint64 jobId = 0;
+        in >> jobId;
+        m_docJobId.append(jobId);
+        for (int f = 0; f < FieldCount; ++f) {
+            quint16 length = 0;
+            in >> length;
+            m_fieldLengths.append(length);
+        }
+    }
+    m_docLive = QVector<bool>(m_docJobId.size(), false);
+    qint32 liveCount = 0;
+    in >> liveCount;
+    for (qint32 i = 0; i < liveCount && in.status() == QDataStream::Ok; ++i) {
+        qint64 jobId = 0;
+        quint32 docId = 0;
+        quint64 sig = 0;
+        in >> jobId >> docId >> sig;
+        if (docId >= static_cast<quint32>(m_docJobId.size())) {
+            in.setStatus(QDataStream::ReadCorruptData);
+            break;
+        }
+        m_docByJobId.insert(jobId, docId);
+        m_signatures.insert(jobId, sig);
+        setLive(docId, true);
+    }
+    qint32 termTotal = 0;
+    in >> termTotal;
+    m_postings.reserve(qMax(termTotal, 0));
+    for (qint32 i = 0; i < termTotal && in.status() == QDataStream::Ok; ++i) {
+        QString term;
+        qint32 size = 0;
+        in >> term >> size;
+        QVector<Posting> list;
+        list.reserve(qMax(size, 0));
+        for (qint32 k = 0; k < size && in.status() == QDataStream::Ok; ++k) {
+            Posting p;
+            in >> p.docId;
+            for (int f = 0; f < FieldCount; ++f) in >> p.tf[f];
+            if (p.docId >= static_cast<quint32>(m_docJobId.size())) {
+                in.setStatus(QDataStream::ReadCorruptData);
+                break;
+            }
+            list.append(p);
+        }
+        m_postings.insert(term, list);
+    }
+
+    if (in.status() != QDataStream::Ok || docCount < 0 || liveCount < 0 || termTotal < 0) {
+        qDebug() << "Bm25Index: corrupt index file" << path << ", rebuilding";
+        clear();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,74 @@
+// presenter/bm25_index.h
+#ifndef BM25_INDEX_H
+#define BM25_INDEX_H
+
+#include <QVector>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QSet>
+#include "constants/db_types.h"
+#include "segmenter.h"
+
+// 分词倒排索引 + BM25F 相关度打分，用于给搜索结果排序（命中集合仍由 n-gram 索引 / 子串匹配决定）
+// - 字段按权重 标题 > 标签 > 公司 > 岗位要求 分别计词频与长度，先按字段长度归一化、加权求和，再做一次 BM25 饱和
+// - 文档以 jobId 为键，内部按追加顺序分配 docId；增量与作废规则与 NgramIndex 相同（签名不变跳过，变化 / 删除时旧文档作废）
+// - 建索引用 Segmenter::segmentForSearch，查询用 Segmenter::segment
+// - 持久化到数据库旁的文件（pathForDatabase）；文件记录词表签名，词表变化后加载失败、整体重建
+class Bm25Index {
+public:
+    enum Field { Title = 0, Tags, Company, Requirements, FieldCount };
+
+    // 职位的打分字段（与 Field 顺序一致）：jobName / 各标签名 / companyName / requirements
+    static QStringList fieldTexts(const SQLNS::JobInfoPrint &job);
+    // crawler.db -> crawler.db.bm25
+    static QString pathForDatabase(const QString &dbPath);
+
+    // segmenter 为空时使用 Segmenter::shared()（首次用到时加载）；需比索引活得久
+    explicit Bm25Index(const Segmenter *segmenter = nullptr);
+
+    void clear();
+    // 加入或更新一个职位（fields 为 fieldTexts 的结果），返回索引是否发生变化
+    bool addJob(long long jobId, const QStringList &fields, quint64 signature);
+    bool isCurrent(long long jobId, quint64 signature) const;
+    // 作废不在 jobIds 中的文档
+    void retainOnly(const QSet<long long> &jobIds);
+
+    // 查询各词的 BM25F 得分之和：jobId -> 分数（只含至少命中一个词的有效文档）
+    QHash<long long, double> scores(const QString &query) const;
+
+    int documentCount() const { return m_docByJobId.size(); }
+    int termCount() const { return m_postings.size(); }
+    bool isDirty() const { return m_dirty; }
+    // 作废文档数超过有效文档数时返回 true
+    bool needsCompaction() const;
+
+    // 失败时返回 false（文件不存在 / 版本或词表不符 / 数据损坏），索引保持为空
+    bool load(const QString &path);
+    bool save(const QString &path);
+
+private:
+    static constexpr quint32 kMagic = 0x424D3235;   // "BM25"
+    static constexpr quint32 kVersion = 1;
+
+    // 一个词在一个文档中的各字段词频
+    struct Posting {
+        quint32 docId;
+        quint16 tf[FieldCount];
+    };
+
+    void setLive(quint32 docId, bool live);
+    const Segmenter &segmenter() const;
+
+    mutable const Segmenter *m_segmenter;
+    QVector<long long> m_docJobId;                // docId -> jobId
+    QVector<quint16> m_fieldLengths;              // docId * FieldCount + field -> 词数
+    QVector<bool> m_docLive;                      // docId -> 是否有效
+    QHash<long long, quint32> m_docByJobId;       // 有效文档：jobId -> docId
+    QHash<long long, quint64> m_signatures;       // 有效文档：jobId -> 内容签名
+    QHash<QString, QVector<Posting>> m_postings;  // 词 -> 倒排（docId 递增）
+    qint64 m_lengthSum[FieldCount] = {};          // 有效文档各字段词数之和
+    bool m_dirty = false;
+};
+
+#endif // BM25_INDEX_H
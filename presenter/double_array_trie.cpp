@@ -0,0 +1,122 @@
+// presenter/double_array_trie.cpp
+#include "double_array_trie.h"
+#include <algorithm>
+
+void DoubleArrayTrie::clear() {
+    m_base.clear();
+    m_check.clear();
+    m_codeOf.clear();
+}
+
+void DoubleArrayTrie::build(const QVector<QString> &keys) {
+    clear();
+    m_order.clear();
+    for (int i = 0; i < keys.size(); ++i) {
+        if (!keys[i].isEmpty()) m_order.append(i);
+    }
+    if (m_order.isEmpty()) return;
+
+    // 字母表按 Unicode 升序编码，键按 QString 排序即等于按编码序列排序（前缀在前，对应词尾编码 0）
+    QVector<bool> seen(65536, false);
+    for (int i : m_order) {
+        for (const QChar ch : keys[i]) seen[ch.unicode()] = true;
+    }
+    m_codeOf = QVector<int>(65536, 0);
+    int nextCode = 1;
+    for (int u = 0; u < 65536; ++u) {
+        if (seen[u]) m_codeOf[u] = nextCode++;
+    }
+    std::stable_sort(m_order.begin(), m_order.end(), [&keys](int a, int b) { return keys[a] < keys[b]; });
+
+    m_keys = &keys;
+    m_nextCheckPos = 0;
+    m_maxIndex = 0;
+    ensure(qMax(1024, nextCode * 2));
+    m_check[0] = 0;   // 根节点
+    m_used[0] = true;
+    m_base[0] = insert(fetch(0, m_order.size(), 0), 0, 0);
+
+    m_base.resize(m_maxIndex + 1);
+    m_check.resize(m_maxIndex + 1);
+    m_keys = nullptr;
+    m_order.clear();
+    m_used.clear();
+}
+
+void DoubleArrayTrie::ensure(int index) {
+    if (index < m_base.size()) return;
+    int size = qMax(m_base.size(), 1024);
+    while (size <= index) size *= 2;
+    m_base.resize(size);
+    m_check.resize(size, -1);
+    m_used.resize(size);
+}
+
+QVector<DoubleArrayTrie::Sibling> DoubleArrayTrie::fetch(int left, int right, int depth) const {
+    QVector<Sibling> siblings;
+    for (int i = left; i < right; ++i) {
+        const QString &key = m_keys->at(m_order[i]);
+        const int code = key.size() > depth ? codeOf(key[depth]) : 0;
+        if (!siblings.isEmpty() && siblings.last().code == code) {
+            siblings.last().right = i + 1;
+        } else {
+            siblings.append(Sibling{code, i, i + 1});
+        }
+    }
+    return siblings;
+}
+
+// 为一组兄弟找到 base，使各自槽位空闲；占用后递归放置子节点，返回 base
+int DoubleArrayTrie::insert(const QVector<Sibling> &siblings, int depth, int parent) {
+    const int firstCode = siblings.first().code;
+    const int lastCode = siblings.last().code;
+    int pos = qMax(firstCode + 1, m_nextCheckPos) - 1;
+    int occupied = 0;
+    bool firstFree = true;
+    int begin = 0;
+    while (true) {
+        ++pos;
+        ensure(pos);
+        if (m_check[pos] != -1) {
+            ++occupied;
+            continue;
+        }
+        if (firstFree) {
+            m_nextCheckPos = pos;
+            firstFree = false;
+        }
+        begin = pos - firstCode;
+        ensure(begin + lastCode);
+        if (m_used[begin]) continue;
+        bool fits = true;
+        for (const Sibling &s : siblings) {
+            if (m_check[begin + s.code] != -1) { fits = false; break; }
+        }
+        if (fits) break;
+    }
+    // 扫过的区间已很密集时，后续搜索直接从这里开始
+    if (occupied >= 0.95 * (pos - m_nextCheckPos + 1)) m_nextCheckPos = pos;
+
+    m_used[begin] = true;
+    for (const Sibling &s : siblings) {
+        m_check[begin + s.code] = parent;
+        m_maxIndex = qMax(m_maxIndex, begin + s.code);
+    }
+    for (const Sibling &s : siblings) {
+        const int node = begin + s.code;
+        if (s.code == 0) {
+            m_base[node] = -m_order[s.left] - 1;
+        } else {
+            m_base[node] = insert(fetch(s.left, s.right, depth + 1), depth + 1, node);
+        }
+    }
+    return begin;
+}
+
+int DoubleArrayTrie::exactMatch(const QString &key) const {
+    int value = -1;
+    commonPrefixSearch(key.constData(), key.size(), [&value, &key](int length, int v) {
+        if (length == key.size()) value = v;
+    });
+    return value;
+}
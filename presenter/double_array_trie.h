@@ -0,0 +1,67 @@
+// presenter/double_array_trie.h
+#ifndef DOUBLE_ARRAY_TRIE_H
+#define DOUBLE_ARRAY_TRIE_H
+
+#include <QVector>
+#include <QString>
+#include <QChar>
+
+// 双数组 Trie（base / check），用于分词词典的前缀匹配
+// - 字符先映射为紧凑编码（按 Unicode 升序从 1 开始），编码 0 表示词尾
+// - 节点 s 经编码 c 转移到 t = base[s] + c，要求 check[t] == s；词尾槽位的 base 存 -(value + 1)
+// - 构建后只读，可在多个线程中同时查询
+class DoubleArrayTrie {
+public:
+    // keys 可无序；value 为 keys 中的下标（重复的键取第一次出现的下标），空串忽略
+    void build(const QVector<QString> &keys);
+    void clear();
+
+    // s[0..len) 的每个在词典中的前缀依次回调 visit(前缀长度, value)，长度递增
+    template<typename Visitor>
+    void commonPrefixSearch(const QChar *s, int len, Visitor &&visit) const {
+        if (m_base.isEmpty()) return;
+        int node = 0;
+        for (int i = 0; i < len; ++i) {
+            const int code = codeOf(s[i]);
+            if (code == 0) return;
+            const int t = m_base[node] + code;
+            if (t >= m_check.size() || m_check[t] != node) return;
+            node = t;
+            const int end = m_base[node];
+            if (end < m_check.size() && m_check[end] == node && m_base[end] < 0) visit(i + 1, -m_base[end] - 1);
+        }
+    }
+
+    // 整词匹配，不在词典中返回 -1
+    int exactMatch(const QString &key) const;
+
+    bool isEmpty() const { return m_base.isEmpty(); }
+    // 数组长度（节点槽位数）
+    int size() const { return m_base.size(); }
+
+private:
+    // 同一父节点下、在 depth 处编码相同的一组键：m_order[left, right)
+    struct Sibling {
+        int code;
+        int left;
+        int right;
+    };
+
+    int codeOf(QChar ch) const { return m_codeOf.isEmpty() ? 0 : m_codeOf[ch.unicode()]; }
+    QVector<Sibling> fetch(int left, int right, int depth) const;
+    int insert(const QVector<Sibling> &siblings, int depth, int parent);
+    void ensure(int index);
+
+    QVector<int> m_base;
+    QVector<int> m_check;        // -1 表示空闲
+    QVector<int> m_codeOf;       // UTF-16 码元 -> 编码（0 表示不在字母表中）
+
+    // 仅构建期使用
+    const QVector<QString> *m_keys = nullptr;
+    QVector<int> m_order;        // 按键排序后的下标
+    QVector<bool> m_used;        // 已被占用的 base
+    int m_nextCheckPos = 0;
+    int m_maxIndex = 0;
+};
+
+#endif // DOUBLE_ARRAY_TRIE_H
@@ -0,0 +1,760 @@
+// presenter/job_store.cpp
+#include "job_store.h"
+#include <QDateTime>
+#include <QCollator>
+#include <QLocale>
+#include <QStringList>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+// ==================== StringDictionary ====================
+
+int StringDictionary::intern(const QString &value) {
+    auto it = m_codes.constFind(value);
+    if (it != m_codes.constEnd()) return it.value();
+    const int code = m_values.size();
+    m_values.append(value);
+    m_codes.insert(value, code);
+    return code;
+}
+
+void StringDictionary::clear() {
+    m_values.clear();
+    m_codes.clear();
+}
+
+QVector<char> StringDictionary::mask(const std::function<bool(const QString &)> &pred) const {
+    QVector<char> m(m_values.size(), 0);
+    for (int c = 0; c < m_values.size(); ++c) m[c] = pred(m_values[c]) ? 1 : 0;
+    return m;
+}
+
+QVector<int> StringDictionary::sortRanks() const {
+    QCollator collator(QLocale(QLocale::Chinese, QLocale::China));
+    std::vector<QCollatorSortKey> keys;
+    keys.reserve(m_values.size());
+    for (const auto &v : m_values) keys.push_back(collator.sortKey(v.normalized(QString::NormalizationForm_KC).toCaseFolded()));
+
+    QVector<int> order(m_values.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this, &keys](int a, int b) {
+        const int c = keys[a].compare(keys[b]);
+        return c != 0 ? c < 0 : m_values[a] < m_values[b];
+    });
+    QVector<int> ranks(m_values.size());
+    for (int i = 0; i < order.size(); ++i) ranks[order[i]] = i;
+    return ranks;
+}
+
+// ==================== JobStore：构建与物化 ====================
+
+void JobStore::clear() {
+    *this = JobStore();
+}
+
+void JobStore::reserve(int rows) {
+    m_jobId.reserve(rows);
+    m_companyId.reserve(rows);
+    m_recruitTypeId.reserve(rows);
+    m_cityId.reserve(rows);
+    m_sourceId.reserve(rows);
+    m_salaryMin.reserve(rows);
+    m_salaryMax.reserve(rows);
+    m_salarySlabId.reserve(rows);
+    m_canonicalJobId.reserve(rows);
+    m_jobName.reserve(rows);
+    m_companyName.reserve(rows);
+    m_recruitTypeName.reserve(rows);
+    m_cityName.reserve(rows);
+    m_sourceName.reserve(rows);
+    m_createEpoch.reserve(rows);
+    m_updateEpoch.reserve(rows);
+    m_hrLastLoginEpoch.reserve(rows);
+    m_tagOffsets.reserve(rows + 1);
+    m_rowByJobId.reserve(rows);
+}
+
+void JobStore::append(const SQLNS::JobInfoPrint &job) {
+    // 时间取数据库中的 epoch 列；缺失时（未经迁移的来源或手工构造的行）才解析字符串
+    auto epochOf = [](qint64 epoch, const QString &text) { return epoch > 0 ? epoch : SQLNS::timeEpoch(text); };
+
+    // 新行使预计算的排序 / 区间索引失效
+    if (!m_sortIndex.isEmpty()) m_sortIndex.clear();
+    if (m_rangeIndexBuilt) {
+        m_salaryLowIndex = RangeIndex();
+        m_salaryHighIndex = RangeIndex();
+        m_rangeIndexBuilt = false;
+    }
+
+    const int r = m_jobId.size();
+    m_jobId.append(job.jobId);
+    m_companyId.append(job.companyId);
+    m_recruitTypeId.append(job.recruitTypeId);
+    m_cityId.append(job.cityId);
+    m_sourceId.append(job.sourceId);
+    m_salaryMin.append(job.salaryMin);
+    m_salaryMax.append(job.salaryMax);
+    m_salarySlabId.append(job.salarySlabId);
+    m_canonicalJobId.append(job.canonicalJobId);
+    (job.canonicalJobId == 0 ? m_canonicalRows : m_duplicateRows).add(r);
+
+    m_jobName.append(m_jobNames.intern(job.jobName));
+    m_companyName.append(m_companies.intern(job.companyName));
+    m_recruitTypeName.append(m_recruitTypes.intern(job.recruitTypeName));
+    m_cityName.append(m_cities.intern(job.cityName));
+    m_sourceName.append(m_sources.intern(job.sourceName));
+    indexRow(m_recruitTypeIndex, m_recruitTypeName[r], r);
+    indexRow(m_cityIndex, m_cityName[r], r);
+    indexRow(m_sourceIndex, m_sourceName[r], r);
+    m_slabIndex[job.salarySlabId].add(r);
+    m_createEpoch.append(epochOf(job.createEpoch, job.createTime));
+    m_updateEpoch.append(epochOf(job.updateEpoch, job.updateTime));
+    m_hrLastLoginEpoch.append(epochOf(job.hrLastLoginEpoch, job.hrLastLoginTime));
+
+    const int tagCount = qMin(job.tagIds.size(), job.tagNames.size());
+    for (int k = 0; k < tagCount; ++k) {
+        m_tagIds.append(job.tagIds[k]);
+        m_tagCodes.append(m_tagNames.intern(job.tagNames[k]));
+        indexRow(m_tagIndex, m_tagCodes.last(), r);
+        m_tagIdIndex[job.tagIds[k]].add(r);
+    }
+    m_tagOffsets.append(m_tagIds.size());
+
+    m_rowByJobId.insert(job.jobId, r);
+}
+
+void JobStore::indexRow(QVector<RoaringBitmap> &index, int code, int r) {
+    if (code >= index.size()) index.resize(code + 1);
+    index[code].add(r);
+}
+
+SQLNS::JobInfoPrint JobStore::row(int r) const {
+    SQLNS::JobInfoPrint job;
+    job.jobId = m_jobId[r];
+    job.jobName = m_jobNames.value(m_jobName[r]);
+    job.companyId = m_companyId[r];
+    job.companyName = m_companies.value(m_companyName[r]);
+    job.recruitTypeId = m_recruitTypeId[r];
+    job.recruitTypeName = m_recruitTypes.value(m_recruitTypeName[r]);
+    job.cityId = m_cityId[r];
+    job.cityName = m_cities.value(m_cityName[r]);
+    job.sourceId = m_sourceId[r];
+    job.sourceName = m_sources.value(m_sourceName[r]);
+    job.salaryMin = m_salaryMin[r];
+    job.salaryMax = m_salaryMax[r];
+    job.salarySlabId = m_salarySlabId[r];
+    job.canonicalJobId = m_canonicalJobId[r];
+    // 时间字符串只在物化（当前页 / 可见块）时格式化
+    job.createEpoch = m_createEpoch[r];
+    job.updateEpoch = m_updateEpoch[r];
+    job.hrLastLoginEpoch = m_hrLastLoginEpoch[r];
+    job.createTime = SQLNS::formatEpoch(job.createEpoch);
+    job.updateTime = SQLNS::formatEpoch(job.updateEpoch);
+    job.hrLastLoginTime = SQLNS::formatEpoch(job.hrLastLoginEpoch);
+    for (int k = m_tagOffsets[r]; k < m_tagOffsets[r + 1]; ++k) {
+        job.tagIds.append(m_tagIds[k]);
+        job.tagNames.append(m_tagNames.value(m_tagCodes[k]));
+    }
+    return job;
+}
+
+QVector<SQLNS::JobInfoPrint> JobStore::materialize(const QVector<int> &rows, int from, int count) const {
+    QVector<SQLNS::JobInfoPrint> out;
+    if (from < 0) from = 0;
+    const int end = (count < 0 || count > rows.size() - from) ? rows.size() : from + count;
+    if (from >= end) return out;
+    out.reserve(end - from);
+    for (int i = from; i < end; ++i) out.append(row(rows[i]));
+    return out;
+}
+
+// ==================== JobStore：选择向量上的检索 ====================
+
+QVector<int> JobStore::allRows() const {
+    QVector<int> rows(size());
+    std::iota(rows.begin(), rows.end(), 0);
+    return rows;
+}
+
+QVector<int> JobStore::rowsForJobIds(const QVector<long long> &ids) const {
+    QVector<int> rows;
+    rows.reserve(ids.size());
+    for (long long id : ids) {
+        auto it = m_rowByJobId.constFind(id);
+        if (it != m_rowByJobId.constEnd()) rows.append(it.value());
+    }
+    return rows;
+}
+
+std::function<bool(const QString &)> JobStore::containsAny(const QVector<QString> &vals) {
+    return [vals](const QString &value) {
+        for (const auto &v : vals) {
+            if (value.contains(v, Qt::CaseInsensitive)) return true;
+        }
+        return false;
+    };
+}
+
+QVector<int> JobStore::matchText(const QString &query) const {
+    return matchText(query, allRows());
+}
+
+QVector<int> JobStore::matchText(const QString &query, const QVector<int> &candidates) const {
+    // 先在字典上求掩码（不同取值通常远少于行数），再对整型编码列做一次线性扫描
+    const auto pred = containsAny({query});
+    const QVector<char> nameHit = m_jobNames.mask(pred);
+    const QVector<char> companyHit = m_companies.mask(pred);
+    const QVector<char> cityHit = m_cities.mask(pred);
+    const QVector<char> tagHit = m_tagNames.mask(pred);
+
+    QVector<char> hits(candidates.size(), 0);
+    QVector<long long> pending;   // 其它列都未命中、需要查岗位要求的候选
+    for (int i = 0; i < candidates.size(); ++i) {
+        const int r = candidates[i];
+        bool hit = nameHit[m_jobName[r]] || companyHit[m_companyName[r]] || cityHit[m_cityName[r]];
+        for (int k = m_tagOffsets[r]; !hit && k < m_tagOffsets[r + 1]; ++k) hit = tagHit[m_tagCodes[k]];
+        hits[i] = hit;
+        if (!hit) pending.append(m_jobId[r]);
+    }
+
+    // requirements 不在内存中：候选少时按 jobId 取回原文校验，多时直接由数据源做子串匹配
+    if (m_requirementsSource && !pending.isEmpty()) {
+        QSet<long long> matched;
+        if (pending.size() <= kRequirementsFetchLimit) {
+            const QHash<long long, QString> texts = m_requirementsSource->fetch(pending);
+            for (auto it = texts.constBegin(); it != texts.constEnd(); ++it) {
+                if (it.value().contains(query, Qt::CaseInsensitive)) matched.insert(it.key());
+            }
+        } else {
+            matched = m_requirementsSource->matchAny({query});
+        }
+        for (int i = 0; i < candidates.size(); ++i) {
+            if (!hits[i]) hits[i] = matched.contains(m_jobId[candidates[i]]);
+        }
+    }
+
+    QVector<int> rows;
+    for (int i = 0; i < candidates.size(); ++i) {
+        if (hits[i]) rows.append(candidates[i]);
+    }
+    return rows;
+}
+
+void JobStore::keepByCode(QVector<int> &rows, const QVector<int> &codes, const QVector<char> &codeMask) {
+    int w = 0;
+    for (int r : rows) {
+        if (codeMask[codes[r]]) rows[w++] = r;
+    }
+    rows.resize(w);
+}
+
+bool JobStore::isFacetField(const QString &field) {
+    return field == "cityName" || field == "sourceName" || field == "recruitTypeName"
+           || field == "salary" || field == "tagNames" || field == "tags" || field == "tagIds"
+           || SQLNS::isSalaryRangeField(field) || SQLNS::isRecencyField(field) || SQLNS::isCollapseField(field);
+}
+
+RoaringBitmap JobStore::uniteByMask(const QVector<RoaringBitmap> &index, const QVector<char> &codeMask) {
+    RoaringBitmap out;
+    for (int c = 0; c < codeMask.size() && c < index.size(); ++c) {
+        if (codeMask[c]) out |= index[c];
+    }
+    return out;
+}
+
+bool JobStore::facetBitmap(const QString &field, const QVector<QString> &vals, RoaringBitmap &out) const {
+    // 数值取值（薪资档 / tagId）精确匹配，非法值忽略
+    auto uniteByValue = [&vals, &out](const QHash<int, RoaringBitmap> &index) {
+        for (const auto &v : vals) {
+            bool ok = false;
+            const int q = v.toInt(&ok);
+            if (!ok) continue;
+            auto it = index.constFind(q);
+            if (it != index.constEnd()) out |= it.value();
+        }
+    };
+
+    if (field == "cityName") {
+        out = uniteByMask(m_cityIndex, m_cities.mask(containsAny(vals)));
+    } else if (field == "sourceName") {
+        out = uniteByMask(m_sourceIndex, m_sources.mask(containsAny(vals)));
+    } else if (field == "recruitTypeName") {
+        out = uniteByMask(m_recruitTypeIndex, m_recruitTypes.mask(containsAny(vals)));
+    } else if (field == "tagNames" || field == "tags") {
+        out = uniteByMask(m_tagIndex, m_tagNames.mask(containsAny(vals)));
+    } else if (field == "salary") {
+        uniteByValue(m_slabIndex);
+    } else if (field == "tagIds") {
+        uniteByValue(m_tagIdIndex);
+    } else if (SQLNS::isSalaryRangeField(field)) {
+        for (const auto &v : vals) {
+            SQLNS::SalaryBounds bounds;
+            if (SQLNS::salaryBounds(field, v, &bounds)) out |= salaryRangeBitmap(bounds);
+        }
+    } else if (SQLNS::isRecencyField(field)) {
+        const SortColumn column = field == "postedWithinDays" ? SortColumn::CreateTime : SortColumn::HrLastLoginTime;
+        const qint64 now = QDateTime::currentSecsSinceEpoch();
+        for (const auto &v : vals) {
+            qint64 cutoff = 0;
+            if (SQLNS::recencyCutoff(v, now, &cutoff)) out |= epochAtLeast(column, cutoff);
+        }
+    } else if (SQLNS::isCollapseField(field)) {
+        // 开关而非取值列表：关闭时不做限制（全部行）
+        out = m_canonicalRows;
+        if (!SQLNS::collapseEnabled(vals)) out |= m_duplicateRows;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+QVector<int> JobStore::filter(const QVector<int> &input, const QMap<QString, QVector<QString>> &fieldFilters) const {
+    return applyFilters(&input, fieldFilters);
+}
+
+QVector<int> JobStore::filter(const QMap<QString, QVector<QString>> &fieldFilters) const {
+    return applyFilters(nullptr, fieldFilters);
+}
+
+QVector<int> JobStore::applyFilters(const QVector<int> *input, const QMap<QString, QVector<QString>> &fieldFilters) const {
+    // 第一步：分面字段在位图上求交（字段内已是并集），任一为空即可提前返回
+    RoaringBitmap facets;
+    bool hasFacet = false;
+    for (auto it = fieldFilters.constBegin(); it != fieldFilters.constEnd(); ++it) {
+        if (it.value().isEmpty()) continue;
+        RoaringBitmap fieldBits;
+        if (!facetBitmap(it.key(), it.value(), fieldBits)) continue;
+        if (hasFacet) {
+            facets &= fieldBits;
+        } else {
+            facets = fieldBits;
+            hasFacet = true;
+        }
+        if (facets.isEmpty()) return {};
+    }
+
+    QVector<int> rows;
+    if (!hasFacet) {
+        rows = input ? *input : allRows();
+    } else if (!input) {
+        rows = facets.toVector();
+    } else {
+        // 保持输入顺序（例如按相关度排好的搜索结果）
+        rows.reserve(qMin(input->size(), facets.cardinality()));
+        for (int r : *input) {
+            if (facets.contains(r)) rows.append(r);
+        }
+    }
+
+    // 第二步：其余字段在已缩小的选择向量上原地压缩
+    applyScanFilters(rows, fieldFilters);
+    return rows;
+}
+
+void JobStore::applyScanFilters(QVector<int> &rows, const QMap<QString, QVector<QString>> &fieldFilters) const {
+    for (auto it = fieldFilters.constBegin(); it != fieldFilters.constEnd() && !rows.isEmpty(); ++it) {
+        const QString &field = it.key();
+        const QVector<QString> &vals = it.value();
+        // 该字段的筛选值为空时跳过
+        if (vals.isEmpty()) continue;
+
+        if (field == "jobId") {
+            QSet<long long> ids;
+            for (const auto &v : vals) {
+                bool ok = false;
+                const long long q = v.toLongLong(&ok);
+                if (ok) ids.insert(q);
+            }
+            int w = 0;
+            for (int r : rows) {
+                if (ids.contains(m_jobId[r])) rows[w++] = r;
+            }
+            rows.resize(w);
+        } else if (field == "jobName") {
+            keepByCode(rows, m_jobName, m_jobNames.mask(containsAny(vals)));
+        } else if (field == "companyName") {
+            keepByCode(rows, m_companyName, m_companies.mask(containsAny(vals)));
+        } else if (field == "requirements") {
+            // 由数据源匹配（未设置数据源时无法匹配，结果为空）
+            const QSet<long long> ids = m_requirementsSource ? m_requirementsSource->matchAny(vals) : QSet<long long>();
+            int w = 0;
+            for (int r : rows) {
+                if (ids.contains(m_jobId[r])) rows[w++] = r;
+            }
+            rows.resize(w);
+        } else if (isFacetField(field)) {
+            // 已在第一步由位图处理
+        } else {
+            // 未知字段：不做任何回退匹配（避免意外命中）
+            rows.clear();
+        }
+    }
+}
+
+JobStore::SortColumn JobStore::sortColumn(const QString &field) {
+    const QString key = field.trimmed().toLower();
+    if (key == "jobname" || key == "job_name") return SortColumn::JobName;
+    if (key == "salarymin" || key == "salary_min") return SortColumn::SalaryMin;
+    if (key == "salarymax" || key == "salary_max") return SortColumn::SalaryMax;
+    if (key == "createtime" || key == "create_time") return SortColumn::CreateTime;
+    if (key == "updatetime" || key == "update_time") return SortColumn::UpdateTime;
+    if (key == "hrlastlogintime" || key == "hr_last_login_time") return SortColumn::HrLastLoginTime;
+    // jobId 及未知字段（与 Presenter::sortJobs 的回退一致）
+    return SortColumn::JobId;
+}
+
+JobStore::SortIndex JobStore::computeSortIndex(SortColumn column) const {
+    const int n = size();
+    SortIndex index;
+    index.ascending.resize(n);
+    std::iota(index.ascending.begin(), index.ascending.end(), 0);
+    index.rank.resize(n);
+
+    // 稳定升序排列后按键是否变化分配名次
+    auto build = [&index, n](const auto &keyOf) {
+        std::stable_sort(index.ascending.begin(), index.ascending.end(),
+                         [&keyOf](int a, int b) { return keyOf(a) < keyOf(b); });
+        int rank = -1;
+        for (int i = 0; i < n; ++i) {
+            if (i == 0 || keyOf(index.ascending[i - 1]) < keyOf(index.ascending[i])) ++rank;
+            index.rank[index.ascending[i]] = rank;
+        }
+    };
+    switch (column) {
+    case SortColumn::JobName: {
+        const QVector<int> ranks = m_jobNames.sortRanks();
+        build([this, &ranks](int r) { return ranks[m_jobName[r]]; });
+        break;
+    }
+    case SortColumn::SalaryMin:
+        build([this](int r) { return m_salaryMin[r]; });
+        break;
+    case SortColumn::SalaryMax:
+        build([this](int r) { return m_salaryMax[r]; });
+        break;
+    case SortColumn::CreateTime:
+    case SortColumn::UpdateTime:
+    case SortColumn::HrLastLoginTime: {
+        const QVector<qint64> &epochs = epochColumn(column);
+        build([&epochs](int r) { return epochs[r]; });
+        break;
+    }
+    case SortColumn::JobId:
+        build([this](int r) { return m_jobId[r]; });
+        break;
+    }
+
+    // 降序：名次组倒序排列，组内仍按行号（与稳定降序排序一致）
+    index.descending.reserve(n);
+    for (int end = n; end > 0;) {
+        int begin = end - 1;
+        while (begin > 0 && index.rank[index.ascending[begin - 1]] == index.rank[index.ascending[end - 1]]) --begin;
+        for (int i = begin; i < end; ++i) index.descending.append(index.ascending[i]);
+        end = begin;
+    }
+    return index;
+}
+
+void JobStore::buildSortIndex() {
+    m_sortIndex.clear();
+    for (SortColumn column : {SortColumn::JobId, SortColumn::JobName, SortColumn::SalaryMin, SortColumn::SalaryMax,
+                              SortColumn::CreateTime, SortColumn::UpdateTime, SortColumn::HrLastLoginTime}) {
+        m_sortIndex.append(computeSortIndex(column));
+    }
+}
+
+// ==================== JobStore：月薪区间索引 ====================
+
+RoaringBitmap JobStore::RangeIndex::between(double lo, double hi) const {
+    RoaringBitmap out;
+    if (!(lo <= hi)) return out;
+    const auto first = std::lower_bound(keys.constBegin(), keys.constEnd(), lo);
+    const auto last = std::upper_bound(first, keys.constEnd(), hi);
+    // 命中段内行号无序，排序后顺序追加
+    QVector<int> hit(rows.constBegin() + (first - keys.constBegin()), rows.constBegin() + (last - keys.constBegin()));
+    std::sort(hit.begin(), hit.end());
+    for (int r : hit) out.add(static_cast<quint32>(r));
+    return out;
+}
+
+void JobStore::buildRangeIndex() {
+    auto build = [this](RangeIndex &index, const auto &keyOf) {
+        QVector<int> rows;
+        rows.reserve(size());
+        for (int r = 0; r < size(); ++r) {
+            if (monthlyHigh(r) > 0) rows.append(r);
+        }
+        QVector<double> keys(rows.size());
+        for (int i = 0; i < rows.size(); ++i) keys[i] = keyOf(rows[i]);
+        QVector<int> order(rows.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&keys](int a, int b) { return keys[a] < keys[b]; });
+        index.keys.resize(order.size());
+        index.rows.resize(order.size());
+        for (int i = 0; i < order.size(); ++i) {
+            index.keys[i] = keys[order[i]];
+            index.rows[i] = rows[order[i]];
+        }
+    };
+    build(m_salaryLowIndex, [this](int r) { return monthlyLow(r); });
+    build(m_salaryHighIndex, [this](int r) { return monthlyHigh(r); });
+    m_rangeIndexBuilt = true;
+}
+
+RoaringBitmap JobStore::salaryRangeBitmap(const SQLNS::SalaryBounds &bounds) const {
+    if (!m_rangeIndexBuilt) {
+        RoaringBitmap out;
+        for (int r = 0; r < size(); ++r) {
+            if (SQLNS::salaryInBounds(monthlyLow(r), monthlyHigh(r), bounds)) out.add(static_cast<quint32>(r));
+        }
+        return out;
+    }
+    // 两个索引都只含上限 > 0 的行（顺带排除面议）；只对有界的一侧二分，两侧都有界时求交
+    constexpr double inf = std::numeric_limits<double>::infinity();
+    const bool lowBounded = bounds.lowMin > -inf || bounds.lowMax < inf;
+    const bool highBounded = bounds.highMin > -inf || bounds.highMax < inf;
+    if (!lowBounded) return m_salaryHighIndex.between(bounds.highMin, bounds.highMax);
+    RoaringBitmap out = m_salaryLowIndex.between(bounds.lowMin, bounds.lowMax);
+    if (highBounded && !out.isEmpty()) out &= m_salaryHighIndex.between(bounds.highMin, bounds.highMax);
+    return out;
+}
+
+// ==================== JobStore：时间范围 ====================
+
+const QVector<qint64> &JobStore::epochColumn(SortColumn column) const {
+    switch (column) {
+    case SortColumn::UpdateTime: return m_updateEpoch;
+    case SortColumn::HrLastLoginTime: return m_hrLastLoginEpoch;
+    default: return m_createEpoch;
+    }
+}
+
+RoaringBitmap JobStore::epochAtLeast(SortColumn column, qint64 cutoff) const {
+    const QVector<qint64> &epochs = epochColumn(column);
+    // 未知时间（0）不命中
+    const qint64 lo = qMax<qint64>(cutoff, 1);
+    RoaringBitmap out;
+    if (!hasSortIndex()) {
+        for (int r = 0; r < size(); ++r) {
+            if (epochs[r] >= lo) out.add(static_cast<quint32>(r));
+        }
+        return out;
+    }
+    // 升序排列上二分找到第一个 ≥ lo 的位置，其后即命中段
+    const QVector<int> &ascending = m_sortIndex[static_cast<int>(column)].ascending;
+    const auto first = std::partition_point(ascending.constBegin(), ascending.constEnd(),
+                                            [&epochs, lo](int r) { return epochs[r] < lo; });
+    QVector<int> hit(first, ascending.constEnd());
+    std::sort(hit.begin(), hit.end());
+    for (int r : hit) out.add(static_cast<quint32>(r));
+    return out;
+}
+
+int JobStore::sort(QVector<int> &rows, const QString &field, bool asc, int limit) const {
+    const SortColumn column = sortColumn(field);
+    const int m = rows.size();
+
+    // 未预计算：对选择向量直接做稳定排序（比较键在排序前一次性确定）
+    if (!hasSortIndex()) {
+        auto sortBy = [&rows, asc](const auto &keyOf) {
+            if (asc) {
+                std::stable_sort(rows.begin(), rows.end(), [&keyOf](int a, int b) { return keyOf(a) < keyOf(b); });
+            } else {
+                std::stable_sort(rows.begin(), rows.end(), [&keyOf](int a, int b) { return keyOf(b) < keyOf(a); });
+            }
+        };
+        switch (column) {
+        case SortColumn::JobName: {
+            const QVector<int> ranks = m_jobNames.sortRanks();
+            sortBy([this, &ranks](int r) { return ranks[m_jobName[r]]; });
+            break;
+        }
+        case SortColumn::SalaryMin: sortBy([this](int r) { return m_salaryMin[r]; }); break;
+        case SortColumn::SalaryMax: sortBy([this](int r) { return m_salaryMax[r]; }); break;
+        case SortColumn::CreateTime:
+        case SortColumn::UpdateTime:
+        case SortColumn::HrLastLoginTime: {
+            const QVector<qint64> &epochs = epochColumn(column);
+            sortBy([&epochs](int r) { return epochs[r]; });
+            break;
+        }
+        case SortColumn::JobId: sortBy([this](int r) { return m_jobId[r]; }); break;
+        }
+        return m;
+    }
+
+    const SortIndex &index = m_sortIndex[static_cast<int>(column)];
+
+    // 升序行号的大选择：沿缓存排列筛出命中行，结果即稳定排序
+    if (static_cast<qint64>(m) * 8 >= size() && std::is_sorted(rows.constBegin(), rows.constEnd())) {
+        QVector<char> selected(size(), 0);
+        for (int r : rows) selected[r] = 1;
+        int w = 0;
+        for (int r : (asc ? index.ascending : index.descending)) {
+            if (selected[r]) rows[w++] = r;
+        }
+        return m;
+    }
+
+    // 一般情况：(名次, 输入位置) 打包为 64 位整数，排序结果等价于稳定排序；只需前 limit 个时做部分排序
+    const quint64 maxRank = static_cast<quint64>(size());
+    QVector<quint64> keys(m);
+    for (int i = 0; i < m; ++i) {
+        const quint64 rank = static_cast<quint64>(index.rank[rows[i]]);
+        keys[i] = ((asc ? rank : maxRank - rank) << 32) | static_cast<quint32>(i);
+    }
+    const int ordered = (limit < 0 || limit >= m) ? m : limit;
+    if (ordered == m) {
+        std::sort(keys.begin(), keys.end());
+    } else {
+        std::partial_sort(keys.begin(), keys.begin() + ordered, keys.end());
+        // 其余部分恢复输入相对顺序，便于之后接续排序
+        std::sort(keys.begin() + ordered, keys.end(),
+                  [](quint64 a, quint64 b) { return (a & 0xFFFFFFFFu) < (b & 0xFFFFFFFFu); });
+    }
+    QVector<int> sorted(m);
+    for (int i = 0; i < m; ++i) sorted[i] = rows[static_cast<int>(keys[i] & 0xFFFFFFFFu)];
+    rows = sorted;
+    return ordered;
+}
+
+QString JobStore::facetGroup(const QString &field) {
+    if (field == "tags" || field == "tagIds") return "tagNames";
+    return isFacetField(field) ? field : QString();
+}
+
+JobStore::FacetCounts JobStore::facetCounts() const {
+    return facetCounts(nullptr, {});
+}
+
+JobStore::FacetCounts JobStore::facetCounts(const QVector<int> *base, const QMap<QString, QVector<QString>> &fieldFilters) const {
+    // 条件拆分：分面字段按分组求位图（同组内多个字段名取交，如 tagNames 与 tagIds），其余字段作用于 base
+    QMap<QString, RoaringBitmap> selected;
+    QMap<QString, QVector<QString>> scanFilters;
+    for (auto it = fieldFilters.constBegin(); it != fieldFilters.constEnd(); ++it) {
+        if (it.value().isEmpty()) continue;
+        const QString group = facetGroup(it.key());
+        if (group.isEmpty()) {
+            scanFilters.insert(it.key(), it.value());
+            continue;
+        }
+        RoaringBitmap bits;
+        facetBitmap(it.key(), it.value(), bits);
+        auto sel = selected.find(group);
+        if (sel == selected.end()) {
+            selected.insert(group, bits);
+        } else {
+            sel.value() &= bits;
+        }
+    }
+
+    // 无搜索结果、无非分面条件时 base 为全部行，不必展开
+    const bool baseIsAll = !base && scanFilters.isEmpty();
+    RoaringBitmap baseBits;
+    if (!baseIsAll) {
+        QVector<int> rows = base ? *base : allRows();
+        applyScanFilters(rows, scanFilters);
+        std::sort(rows.begin(), rows.end());
+        for (int r : rows) baseBits.add(static_cast<quint32>(r));
+    }
+
+    FacetCounts counts;
+    const QStringList groups{"salary", "tagNames", "cityName", "recruitTypeName", "sourceName"};
+    for (const QString &group : groups) {
+        // 分面计数排除本字段自身的条件（字段内为 OR，已选值之外的选项仍给出可加选的数量）
+        bool all = baseIsAll;
+        RoaringBitmap cond = baseBits;
+        for (auto sel = selected.constBegin(); sel != selected.constEnd(); ++sel) {
+            if (sel.key() == group) continue;
+            if (all) {
+                cond = sel.value();
+                all = false;
+            } else {
+                cond &= sel.value();
+            }
+        }
+        auto count = [all, &cond](const RoaringBitmap &bits) {
+            return all ? bits.cardinality() : RoaringBitmap::intersectionCardinality(cond, bits);
+        };
+        auto countByCode = [&count](const StringDictionary &dict, const QVector<RoaringBitmap> &index) {
+            QMap<QString, int> values;
+            for (int c = 0; c < index.size() && c < dict.size(); ++c) {
+                const int n = count(index[c]);
+                if (n > 0) values.insert(dict.value(c), n);
+            }
+            return values;
+        };
+
+        QMap<QString, int> &values = counts[group];
+        if (!all && cond.isEmpty()) continue;
+        if (group == "salary") {
+            for (auto it = m_slabIndex.constBegin(); it != m_slabIndex.constEnd(); ++it) {
+                const int n = count(it.value());
+                if (n > 0) values.insert(QString::number(it.key()), n);
+            }
+        } else if (group == "tagNames") {
+            values = countByCode(m_tagNames, m_tagIndex);
+        } else if (group == "cityName") {
+            values = countByCode(m_cities, m_cityIndex);
+        } else if (group == "recruitTypeName") {
+            values = countByCode(m_recruitTypes, m_recruitTypeIndex);
+        } else {
+            values = countByCode(m_sources, m_sourceIndex);
+        }
+    }
+    return counts;
+}
+
+// ==================== JobSelection ====================
+
+JobSelection::JobSelection(std::shared_ptr<const JobStore> store, QVector<int> rows,
+                           int orderedCount, const QString &sortField, bool asc)
+    : m_store(std::move(store)), m_order(std::make_shared<Order>()) {
+    m_order->rows = std::move(rows);
+    const int n = m_order->rows.size();
+    m_order->size = n;
+    m_order->ordered = (orderedCount < 0 || orderedCount > n) ? n : orderedCount;
+    m_order->sortField = sortField;
+    m_order->asc = asc;
+}
+
+QVector<int> JobSelection::rows() const {
+    return orderedRows(0, -1);
+}
+
+QVector<SQLNS::JobInfoPrint> JobSelection::materialize(int from, int count) const {
+    if (!m_store || !m_order) return QVector<SQLNS::JobInfoPrint>();
+    // 只在锁内复制所需的一段行号，物化在锁外进行
+    const QVector<int> slice = orderedRows(from, count);
+    return m_store->materialize(slice, 0, slice.size());
+}
+
+int JobSelection::rowAt(int i) const {
+    QMutexLocker locker(&m_order->mutex);
+    ensureOrdered(i + 1);
+    return m_order->rows.at(i);
+}
+
+QVector<int> JobSelection::orderedRows(int from, int count) const {
+    if (!m_order) return QVector<int>();
+    QMutexLocker locker(&m_order->mutex);
+    const int n = m_order->size;
+    from = qBound(0, from, n);
+    const int end = (count < 0) ? n : static_cast<int>(qMin<qint64>(static_cast<qint64>(from) + count, n));
+    ensureOrdered(end);
+    return m_order->rows.mid(from, end - from);
+}
+
+void JobSelection::ensureOrdered(int end) const {
+    if (!m_store || !m_order) return;
+    Order &order = *m_order;
+    if (end <= order.ordered) return;
+    // 至少翻倍推进，逐个访问时总代价仍为 O(n log n)
+    const int target = qMin(order.rows.size(), qMax(end, qMax(order.ordered * 2, 256)));
+    QVector<int> tail = order.rows.mid(order.ordered);
+    const int done = m_store->sort(tail, order.sortField, order.asc, target - order.ordered);
+    std::copy(tail.constBegin(), tail.constEnd(), order.rows.begin() + order.ordered);
+    order.ordered += done;
+}
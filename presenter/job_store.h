@@ -0,0 +1,257 @@
+// presenter/job_store.h
+#ifndef JOB_STORE_H
+#define JOB_STORE_H
+
+#include <QVector>
+#include <QString>
+#include <QHash>
+#include <QMap>
+#include <QSet>
+#include <QMutex>
+#include <functional>
+#include <memory>
+#include "constants/db_types.h"
+#include "roaring_bitmap.h"
+
+// 字符串字典：每个不同的值只保存一份，列中只存 int 编码
+class StringDictionary {
+public:
+    int intern(const QString &value);
+    const QString &value(int code) const { return m_values[code]; }
+    int size() const { return m_values.size(); }
+    void clear();
+
+    // 对每个字典项求 pred，返回按编码索引的 0/1 掩码（长度为 size()）
+    QVector<char> mask(const std::function<bool(const QString &)> &pred) const;
+    // 编码 -> 排序名次，用整数比较代替 QString 比较
+    // 排序键：NFKC 规范化 + 大小写折叠后按中文排序规则（拼音序）比较，相同时按码点序；每个字典项只算一次
+    QVector<int> sortRanks() const;
+
+private:
+    QVector<QString> m_values;
+    QHash<QString, int> m_codes;
+};
+
+// 岗位要求（requirements）的外部来源：该列体积最大且只在详情 / 文本匹配时用到，不常驻 JobStore
+class RequirementsSource {
+public:
+    virtual ~RequirementsSource() = default;
+    // jobId -> 岗位要求原文（不存在的 id 不出现在结果中）
+    virtual QHash<long long, QString> fetch(const QVector<long long> &jobIds) const = 0;
+    // 岗位要求包含任一 needle（不区分大小写）的 jobId
+    virtual QSet<long long> matchAny(const QVector<QString> &needles) const = 0;
+};
+
+// 列式职位存储（structure of arrays）
+// - ID / 薪资 / 档次 / 时间（秒级 epoch）为定长数值列；公司、城市、来源、招聘类型、职位名、标签名做字典编码
+// - 时间只存 epoch，物化时才格式化为字符串（即只为可见行格式化）
+// - 标签按 CSR 布局：tagOffsets[row]..tagOffsets[row+1] 为该行在 tagIds/tagCodes 中的区间
+// - requirements 不入存储：append 时丢弃，物化结果中为空；匹配岗位要求时经 RequirementsSource 按需取回
+// - 城市 / 来源 / 招聘类型 / 薪资档 / 标签为分面字段，每个取值维护一张行号位图（追加时增量更新）
+// - 月薪区间字段（monthlySalaryMin / Max / Overlap）由按月薪下限、上限排序的数组二分定位，结果同样以位图参与求交
+// - 时间范围字段（postedWithinDays / hrActiveWithinDays）在对应时间列的预计算升序排列上二分定位
+// - 近重复折叠（collapseDuplicates）按规范职位 / 组员两张位图处理，与其它分面一起求交
+// 筛选与排序只在行号选择向量（QVector<int>）上进行，JobInfoPrint 仅为当前页物化。
+class JobStore {
+public:
+    void clear();
+    void reserve(int rows);
+    void append(const SQLNS::JobInfoPrint &job);
+    int size() const { return m_jobId.size(); }
+
+    // 物化单行 / 选择向量中 [from, from+count) 的行
+    SQLNS::JobInfoPrint row(int r) const;
+    QVector<SQLNS::JobInfoPrint> materialize(const QVector<int> &rows, int from, int count) const;
+
+    long long jobId(int r) const { return m_jobId[r]; }
+    // 岗位要求的数据源（发布快照前设置；为空时 requirements 相关匹配一律不命中）
+    void setRequirementsSource(std::shared_ptr<const RequirementsSource> source) { m_requirementsSource = std::move(source); }
+    // 时间列（秒级 epoch，未知为 0）
+    qint64 createEpoch(int r) const { return m_createEpoch[r]; }
+    qint64 updateEpoch(int r) const { return m_updateEpoch[r]; }
+    qint64 hrLastLoginEpoch(int r) const { return m_hrLastLoginEpoch[r]; }
+    // 近重复组的规范职位ID（0 表示自身即规范职位）
+    long long canonicalJobId(int r) const { return m_canonicalJobId[r]; }
+
+    // 0..size()-1
+    QVector<int> allRows() const;
+    // jobId 列表 -> 行号（保持输入顺序，忽略不存在的 id）
+    QVector<int> rowsForJobIds(const QVector<long long> &ids) const;
+    // 子串匹配 jobName / requirements / companyName / cityName / 标签名（不区分大小写）
+    QVector<int> matchText(const QString &query) const;
+    // 同上，只校验 candidates 中的行（保持其顺序），用于 n-gram 索引候选的回查
+    // 其它列未命中的候选不超过 kRequirementsFetchLimit 个时按 jobId 取回岗位要求校验，否则由数据源整体匹配
+    QVector<int> matchText(const QString &query, const QVector<int> &candidates) const;
+    // 字段筛选，语义同 Presenter::searchJobs(source, fieldFilters)：字段间 AND，字段内 OR，未知字段不命中
+    // 分面字段走位图（字段内 OR、字段间 AND），其余字段在结果上线性扫描；保持 rows 的原有顺序
+    QVector<int> filter(const QVector<int> &rows, const QMap<QString, QVector<QString>> &fieldFilters) const;
+    // 在全部行上筛选（结果按行号升序），无需先构造 allRows()
+    QVector<int> filter(const QMap<QString, QVector<QString>> &fieldFilters) const;
+    // 排序列（字段名只在入口解析一次）；未知字段回退为 JobId，同 Presenter::sortJobs
+    // 时间列按 epoch 比较（createTime / updateTime / hrLastLoginTime）
+    enum class SortColumn { JobId = 0, JobName, SalaryMin, SalaryMax, CreateTime, UpdateTime, HrLastLoginTime };
+    static SortColumn sortColumn(const QString &field);
+    // 预计算各排序列的键名次与稳定升 / 降序排列（加载完成后调用一次；之后 append 会使其失效）
+    void buildSortIndex();
+    bool hasSortIndex() const { return !m_sortIndex.isEmpty(); }
+    // 按换算月薪（下限 / 上限）排序的区间索引，只收有薪资信息的行（加载完成后调用一次；之后 append 会使其失效）
+    // 建立后区间筛选为 O(log n + 命中数)；未建立时逐行比较
+    void buildRangeIndex();
+    bool hasRangeIndex() const { return m_rangeIndexBuilt; }
+    // 稳定排序，返回 rows 中已就位的前缀长度
+    // - limit < 0：全部排序；否则至少前 limit 个就位（top-k），其余保持输入相对顺序，
+    //   对剩余部分再次调用 sort 即可接续（结果与一次全排序相同）
+    // - 已预计算且 rows 为升序行号、占比较大时，直接沿缓存排列筛出命中行（O(n)，不做比较）
+    int sort(QVector<int> &rows, const QString &field, bool asc, int limit = -1) const;
+    // 分面计数：字段（salary / tagNames / cityName / recruitTypeName / sourceName）-> 取值 -> 行数（只含非零项）
+    using FacetCounts = QMap<QString, QMap<QString, int>>;
+    // 全部行上的计数，即各取值位图的基数（随 append 增量维护），不扫描行
+    FacetCounts facetCounts() const;
+    // 按当前选择计数：base 为搜索结果（nullptr 表示全部行），fieldFilters 同 filter()；
+    // 每个分面字段的计数不受该字段自身条件约束（disjunctive），其余条件在位图上求交后只做基数统计
+    FacetCounts facetCounts(const QVector<int> *base, const QMap<QString, QVector<QString>> &fieldFilters) const;
+
+private:
+    QVector<int> applyFilters(const QVector<int> *input, const QMap<QString, QVector<QString>> &fieldFilters) const;
+    // 非分面字段（jobId / jobName / companyName / requirements / 未知字段）在 rows 上原地压缩
+    void applyScanFilters(QVector<int> &rows, const QMap<QString, QVector<QString>> &fieldFilters) const;
+    // 分面字段返回 true 并在 out 中给出字段内各取值位图的并集；非分面字段返回 false
+    bool facetBitmap(const QString &field, const QVector<QString> &vals, RoaringBitmap &out) const;
+    // 字典掩码命中的各编码位图之并
+    static RoaringBitmap uniteByMask(const QVector<RoaringBitmap> &index, const QVector<char> &codeMask);
+    static void indexRow(QVector<RoaringBitmap> &index, int code, int r);
+
+    // 有序数组区间索引：keys 升序，rows[i] 为键 keys[i] 所在行
+    struct RangeIndex {
+        QVector<double> keys;
+        QVector<int> rows;
+        // 键落在 [lo, hi] 内的行（二分定位后只遍历命中段）
+        RoaringBitmap between(double lo, double hi) const;
+    };
+    double monthlyLow(int r) const { return SQLNS::monthlySalary(m_salaryMin[r], m_recruitTypeId[r]); }
+    double monthlyHigh(int r) const { return SQLNS::monthlySalary(qMax(m_salaryMin[r], m_salaryMax[r]), m_recruitTypeId[r]); }
+    // 一个区间筛选值命中的行
+    RoaringBitmap salaryRangeBitmap(const SQLNS::SalaryBounds &bounds) const;
+    // 时间列 ≥ cutoff 且已知（> 0）的行；已预计算排序索引时沿升序排列二分定位
+    RoaringBitmap epochAtLeast(SortColumn column, qint64 cutoff) const;
+    const QVector<qint64> &epochColumn(SortColumn column) const;
+
+    struct SortIndex {
+        QVector<int> rank;         // 行 -> 键名次（键相等名次相同）
+        QVector<int> ascending;    // 稳定升序排列（同键按行号）
+        QVector<int> descending;   // 稳定降序排列（同键按行号）
+    };
+    SortIndex computeSortIndex(SortColumn column) const;
+
+    // 保留 codeMask[codes[r]] 为真的行
+    static void keepByCode(QVector<int> &rows, const QVector<int> &codes, const QVector<char> &codeMask);
+    // cityName / sourceName / recruitTypeName / salary / tagNames(tags) / tagIds / 月薪区间字段 / 时间范围字段 / collapseDuplicates
+    static bool isFacetField(const QString &field);
+    // 分面字段 -> 计数分组（tags / tagIds 归入 tagNames）；非分面字段返回空串
+    static QString facetGroup(const QString &field);
+    // 非空值中是否有任一被 value 包含（不区分大小写）
+    static std::function<bool(const QString &)> containsAny(const QVector<QString> &vals);
+
+    // 数值列
+    QVector<long long> m_jobId;
+    QVector<long long> m_companyId;
+    QVector<int> m_recruitTypeId;
+    QVector<int> m_cityId;
+    QVector<int> m_sourceId;
+    QVector<double> m_salaryMin;
+    QVector<double> m_salaryMax;
+    QVector<int> m_salarySlabId;
+    QVector<long long> m_canonicalJobId;
+
+    // 字典编码列
+    QVector<int> m_jobName;
+    QVector<int> m_companyName;
+    QVector<int> m_recruitTypeName;
+    QVector<int> m_cityName;
+    QVector<int> m_sourceName;
+    StringDictionary m_jobNames;
+    StringDictionary m_companies;
+    StringDictionary m_recruitTypes;
+    StringDictionary m_cities;
+    StringDictionary m_sources;
+
+    // 时间列（秒级 epoch）
+    QVector<qint64> m_createEpoch;
+    QVector<qint64> m_updateEpoch;
+    QVector<qint64> m_hrLastLoginEpoch;
+
+    // 标签（CSR）
+    QVector<int> m_tagOffsets{0};
+    QVector<int> m_tagIds;
+    QVector<int> m_tagCodes;
+    StringDictionary m_tagNames;
+
+    // 岗位要求（外部）
+    static constexpr int kRequirementsFetchLimit = 2000;
+    std::shared_ptr<const RequirementsSource> m_requirementsSource;
+
+    QHash<long long, int> m_rowByJobId;
+
+    // 按 SortColumn 下标；为空表示未预计算
+    QVector<SortIndex> m_sortIndex;
+
+    // 月薪区间索引（按下限 / 上限排序）
+    RangeIndex m_salaryLowIndex;
+    RangeIndex m_salaryHighIndex;
+    bool m_rangeIndexBuilt = false;
+
+    // 分面位图索引：字典编码 / 数值取值 -> 行号集合
+    QVector<RoaringBitmap> m_cityIndex;
+    QVector<RoaringBitmap> m_sourceIndex;
+    QVector<RoaringBitmap> m_recruitTypeIndex;
+    QVector<RoaringBitmap> m_tagIndex;
+    QHash<int, RoaringBitmap> m_slabIndex;
+    QHash<int, RoaringBitmap> m_tagIdIndex;
+    // 近重复组：规范职位（canonicalJobId = 0）/ 组员；两者之并为全部行
+    RoaringBitmap m_canonicalRows;
+    RoaringBitmap m_duplicateRows;
+};
+
+// 行号视图：共享一份只读 JobStore 快照 + 选择向量，传递时不复制职位数据
+// 快照在 PresenterTask 刷新时整体替换，旧视图仍持有旧快照，互不影响
+// 排序可只做到当前页（orderedCount），访问更靠后的位置时再按需接续 top-k 排序；
+// 副本之间共享选择向量与排序进度（加锁推进），可在查询缓存中保存并跨线程传递
+class JobSelection {
+public:
+    JobSelection() = default;
+    // orderedCount < 0 表示 rows 已全部有序；否则前 orderedCount 个已就位，其余待按 sortField/asc 排序
+    JobSelection(std::shared_ptr<const JobStore> store, QVector<int> rows,
+                 int orderedCount = -1, const QString &sortField = QString(), bool asc = true);
+
+    int size() const { return m_order ? m_order->size : 0; }
+    bool isEmpty() const { return size() == 0; }
+    // 完整有序的选择向量（必要时先排完；返回持锁时取得的副本）
+    QVector<int> rows() const;
+    const JobStore *store() const { return m_store.get(); }
+
+    // i 为视图内位置（0..size()-1）
+    long long jobId(int i) const { return m_store->jobId(rowAt(i)); }
+    SQLNS::JobInfoPrint at(int i) const { return m_store->row(rowAt(i)); }
+    QVector<SQLNS::JobInfoPrint> materialize(int from, int count) const;
+
+private:
+    // rows 会被接续排序原地改写（可能触发分离），读写都须持有 mutex；size 构造后不变
+    struct Order {
+        QMutex mutex;
+        QVector<int> rows;
+        int size = 0;
+        int ordered = 0;
+        QString sortField;
+        bool asc = true;
+    };
+    // 持锁推进排序后取出位置 i / [from, from + count) 的行号
+    int rowAt(int i) const;
+    QVector<int> orderedRows(int from, int count) const;
+    // 调用方须持有 m_order->mutex
+    void ensureOrdered(int end) const;
+
+    std::shared_ptr<const JobStore> m_store;
+    std::shared_ptr<Order> m_order;
+};
+
+#endif // JOB_STORE_H
@@ -0,0 +1,209 @@
+// presenter/ngram_index.cpp
+#include "ngram_index.h"
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+#include <QDebug>
+#include <algorithm>
+
+QStringList NgramIndex::searchableFields(const SQLNS::JobInfoPrint &job) {
+    QStringList fields;
+    fields.reserve(4 + job.tagNames.size());
+    fields << job.jobName << job.companyName << job.cityName;
+    for (const auto &t : job.tagNames) fields << t;
+    fields << job.requirements;
+    return fields;
+}
+
+QString NgramIndex::pathForDatabase(const QString &dbPath) {
+    return dbPath + ".ngram";
+}
+
+void NgramIndex::clear() {
+    m_docJobId.clear();
+    m_docByJobId.clear();
+    m_signatures.clear();
+    m_postings.clear();
+    m_dirty = true;
+}
+
+// gram 长度写入高位，二元与三元不会冲突
+quint64 NgramIndex::gramKey(const QChar *s, int n) {
+    quint64 key = static_cast<quint64>(n) << 48;
+    for (int i = 0; i < n; ++i) key |= static_cast<quint64>(s[i].unicode()) << (16 * (2 - i));
+    return key;
+}
+
+// FNV-1a（64 位），与 Qt 版本 / 哈希种子无关，可安全落盘
+quint64 NgramIndex::signature(const QStringList &fields) {
+    quint64 h = 14695981039346656037ULL;
+    auto mix = [&h](quint16 unit) {
+        h ^= unit;
+        h *= 1099511628211ULL;
+    };
+    for (const auto &f : fields) {
+        for (const QChar ch : f) mix(ch.unicode());
+        mix(0x1F);   // 字段分隔
+    }
+    return h;
+}
+
+void NgramIndex::indexText(const QString &folded, quint32 docId) {
+    const QChar *s = folded.constData();
+    const int len = folded.size();
+    for (int i = 0; i + 2 <= len; ++i) {
+        m_postings[gramKey(s + i, 2)].add(docId);
+        if (i + 3 <= len) m_postings[gramKey(s + i, 3)].add(docId);
+    }
+}
+
+bool NgramIndex::isCurrent(long long jobId, quint64 sig) const {
+    auto it = m_signatures.constFind(jobId);
+    return it != m_signatures.constEnd() && it.value() == sig;
+}
+
+bool NgramIndex::addJob(long long jobId, const QStringList &fields) {
+    return addJob(jobId, fields, signature(fields));
+}
+
+bool NgramIndex::addJob(long long jobId, const QStringList &fields, quint64 sig) {
+    if (isCurrent(jobId, sig)) return false;
+
+    // 新文档；旧 docId（若有）因不再出现在 m_docByJobId 中而自动作废
+    const quint32 docId = static_cast<quint32>(m_docJobId.size());
+    m_docJobId.append(jobId);
+    m_docByJobId.insert(jobId, docId);
+    m_signatures.insert(jobId, sig);
+    for (const auto &f : fields) indexText(f.toCaseFolded(), docId);
+    m_dirty = true;
+    return true;
+}
+
+void NgramIndex::retainOnly(const QSet<long long> &jobIds) {
+    for (auto it = m_docByJobId.begin(); it != m_docByJobId.end();) {
+        if (jobIds.contains(it.key())) {
+            ++it;
+        } else {
+            m_signatures.remove(it.key());
+            it = m_docByJobId.erase(it);
+            m_dirty = true;
+        }
+    }
+}
+
+bool NgramIndex::needsCompaction() const {
+    const int dead = m_docJobId.size() - m_docByJobId.size();
+    return dead > 0 && dead > m_docByJobId.size();
+}
+
+QVector<long long> NgramIndex::candidates(const QString &query, bool *usable) const {
+    QVector<long long> ids;
+    const QString folded = query.toCaseFolded();
+    if (folded.size() < 2) {
+        if (usable) *usable = false;
+        return ids;
+    }
+    if (usable) *usable = true;
+
+    // 查询的所有 n-gram（n = min(3, 长度)）倒排表求交，从最短的开始
+    const int n = qMin(3, static_cast<int>(folded.size()));
+    QVector<const RoaringBitmap *> lists;
+    for (int i = 0; i + n <= folded.size(); ++i) {
+        auto it = m_postings.constFind(gramKey(folded.constData() + i, n));
+        if (it == m_postings.constEnd()) return ids;
+        lists.append(&it.value());
+    }
+    std::sort(lists.begin(), lists.end(),
+              [](const RoaringBitmap *a, const RoaringBitmap *b) { return a->cardinality() < b->cardinality(); });
+    RoaringBitmap hits = *lists.first();
+    for (int i = 1; i < lists.size() && !hits.isEmpty(); ++i) hits &= *lists[i];
+
+    for (int docId : hits.toVector()) {
+        if (docId >= m_docJobId.size()) break;
+        const long long jobId = m_docJobId[docId];
+        // 跳过已作废的旧文档
+        auto live = m_docByJobId.constFind(jobId);
+        if (live != m_docByJobId.constEnd() && live.value() == static_cast<quint32>(docId)) ids.append(jobId);
+    }
+    return ids;
+}
+
+bool NgramIndex::save(const QString &path) {
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "NgramIndex: cannot write" << path << file.errorString();
+        return false;
+    }
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << kMagic << kVersion;
+    out << static_cast<qint32>(m_docJobId.size());
+    for (long long jobId : m_docJobId) out << static_cast<qint64>(jobId);
+    out << static_cast<qint32>(m_docByJobId.size());
+    for (auto it = m_docByJobId.constBegin(); it != m_docByJobId.constEnd(); ++it) {
+        out << static_cast<qint64>(it.key()) << it.value() << m_signatures.value(it.key());
+    }
+    out << static_cast<qint32>(m_postings.size());
+    for (auto it = m_postings.constBegin(); it != m_postings.constEnd(); ++it) out << it.key() << it.value();
+    if (out.status() != QDataStream::Ok || !file.commit()) {
+        qDebug() << "NgramIndex: failed to save" << path;
+        return false;
+    }
+    m_dirty = false;
+    return true;
+}
+
+bool NgramIndex::load(const QString &path) {
+    clear();
+    m_dirty = false;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0, version = 0;
+    in >> magic >> version;
+    if (magic != kMagic || version != kVersion) {
+        qDebug() << "NgramIndex: ignoring incompatible index file" << path;
+        return false;
+    }
+
+    qint32 docCount = 0;
+    in >> docCount;
+    m_docJobId.reserve(qMax(docCount, 0));
+    for (qint32 i = 0; i < docCount && in.status() == QDataStream::Ok; ++i) {
+        qint64 jobId = 0;
+        in >> jobId;
+        m_docJobId.append(jobId);
+    }
+    qint32 liveCount = 0;
+    in >> liveCount;
+    for (qint32 i = 0; i < liveCount && in.status() == QDataStream::Ok; ++i) {
+        qint64 jobId = 0;
+        quint32 docId = 0;
+        quint64 sig = 0;
+        in >> jobId >> docId >> sig;
+        if (docId >= static_cast<quint32>(m_docJobId.size())) {
+            in.setStatus(QDataStream::ReadCorruptData);
+            break;
+        }
+        m_docByJobId.insert(jobId, docId);
+        m_signatures.insert(jobId, sig);
+    }
+    qint32 gramTotal = 0;
+    in >> gramTotal;
+    m_postings.reserve(qMax(gramTotal, 0));
+    for (qint32 i = 0; i < gramTotal && in.status() == QDataStream::Ok; ++i) {
+        quint64 key = 0;
+        RoaringBitmap bitmap;
+        in >> key >> bitmap;
+        m_postings.insert(key, bitmap);
+    }
+
+    if (in.status() != QDataStream::Ok || docCount < 0 || liveCount < 0 || gramTotal < 0) {
+        qDebug() << "NgramIndex: corrupt index file" << path << ", rebuilding";
+        clear();
+        return false;
+    }
+    return true;
+}
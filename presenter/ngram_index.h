@@ -0,0 +1,65 @@
+// presenter/ngram_index.h
+#ifndef NGRAM_INDEX_H
+#define NGRAM_INDEX_H
+
+#include <QVector>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QSet>
+#include "constants/db_types.h"
+#include "roaring_bitmap.h"
+
+// 字符 n-gram 倒排索引（二元 + 三元），用于中文子串搜索
+// - 文档以 jobId 为键，内部按追加顺序分配 docId；倒排表为 docId 位图
+// - 各字段分别切分，不跨字段拼接 gram；文本先做大小写折叠
+// - 只产出候选：调用方需在真实文本上校验（gram 全命中不代表子串连续出现）
+// - 增量：同一 jobId 内容签名不变则跳过（PresenterTask 以不含岗位要求的字段 + updateTime 作签名）；内容变化或被删除时旧文档作废（不回收），作废过多时应整体重建
+// - 持久化到数据库旁的文件（pathForDatabase），启动时加载后只补齐新增 / 变化的职位
+class NgramIndex {
+public:
+    // 职位的可检索文本：jobName / companyName / cityName / 各标签名 / requirements
+    static QStringList searchableFields(const SQLNS::JobInfoPrint &job);
+    // crawler.db -> crawler.db.ngram
+    static QString pathForDatabase(const QString &dbPath);
+
+    // 内容签名（FNV-1a，与 Qt 版本 / 哈希种子无关，可落盘）
+    static quint64 signature(const QStringList &fields);
+
+    void clear();
+    // 加入或更新一个职位，返回索引是否发生变化（签名取自 fields）
+    bool addJob(long long jobId, const QStringList &fields);
+    // 同上，签名由调用方给出：可先用 isCurrent 判断，只为变化的职位取回大字段（如岗位要求）
+    bool addJob(long long jobId, const QStringList &fields, quint64 signature);
+    bool isCurrent(long long jobId, quint64 signature) const;
+    // 作废不在 jobIds 中的文档（对应职位已从数据库删除）
+    void retainOnly(const QSet<long long> &jobIds);
+
+    // 候选 jobId（未校验）；查询短于二元时 *usable = false，调用方应回退为扫描
+    QVector<long long> candidates(const QString &query, bool *usable = nullptr) const;
+
+    int documentCount() const { return m_docByJobId.size(); }
+    int gramCount() const { return m_postings.size(); }
+    bool isDirty() const { return m_dirty; }
+    // 作废文档数超过有效文档数时返回 true
+    bool needsCompaction() const;
+
+    // 失败时返回 false（文件不存在 / 版本不符 / 数据损坏），索引保持为空
+    bool load(const QString &path);
+    bool save(const QString &path);
+
+private:
+    static constexpr quint32 kMagic = 0x4E47524D;   // "NGRM"
+    static constexpr quint32 kVersion = 2;
+
+    static quint64 gramKey(const QChar *s, int n);
+    void indexText(const QString &folded, quint32 docId);
+
+    QVector<long long> m_docJobId;                // docId -> jobId
+    QHash<long long, quint32> m_docByJobId;       // 有效文档：jobId -> docId
+    QHash<long long, quint64> m_signatures;       // 有效文档：jobId -> 内容签名
+    QHash<quint64, RoaringBitmap> m_postings;     // gram -> docId 位图
+    bool m_dirty = false;
+};
+
+#endif // NGRAM_INDEX_H
@@ -7,6 +7,10 @@
 #include <QMap>
 #include "constants/db_types.h"
 
+class JobStore;
+class NgramIndex;
+class Bm25Index;
+
 // Forward declare SQLInterface to avoid depending on db/sqlinterface.h being present
 class SQLInterface;
 
@@ -32,6 +36,8 @@ public:
     
     // 辅助方法：格式化时间
     static QString formatTime(const QString& timeStr);
+    // 同上，直接使用秒级 epoch（不再解析字符串）；0 为无效时间
+    static QString formatTime(qint64 epoch);
 
     // 单行输出辅助（将 JobInfoPrint 格式化为单行字符串）
     static QString toLine(const SQLNS::JobInfoPrint &job);
@@ -41,8 +47,8 @@ public:
     // 通用分页函数
     static QVector<SQLNS::JobInfoPrint> paging(const QVector<SQLNS::JobInfoPrint>& source, int page, int pageSize);
     
-    // 排序业务（通用）：按指定字段排序（字段名，asc=true为升序）
-    // 支持字段示例："jobId"/"id", "jobName", "salary"(平均薪资), "salaryMin", "salaryMax"
+    // 排序业务（通用）：按指定字段排序（字段名，asc=true为升序），稳定排序
+    // 支持字段："jobId"/"id", "jobName"（规范化后按中文排序规则）, "salaryMin", "salaryMax"；其它字段按 jobId
     static QVector<SQLNS::JobInfoPrint> sortJobs(const QVector<SQLNS::JobInfoPrint>& jobs, const QString& field, bool asc = true);
 
     // 向后兼容：旧方法作为 wrapper（弃用），等价于 sortJobs(..., "salary", asc)
@@ -58,13 +64,24 @@ public:
     // - `companyName` 或 `cityName` 包含 query（不区分大小写）
     // - 任一 `tagNames` 条目包含 query（不区分大小写）
     // - 如果 `query` 是纯数字，则按 `jobId` 精确匹配
+    // 传入已连接 source 所在数据库的 fullText 时，非数字查询优先走 SQLInterface::searchJobIds（FTS5 全文索引），
+    // 结果按相关度排序；未传入或索引不可用时回退为上述逐条子串匹配（保持 source 顺序）。Presenter 不自行打开连接
     static QVector<SQLNS::JobInfoPrint> searchJobs(const QVector<SQLNS::JobInfoPrint>& source,
-                                                   const QString& query);
+                                                   const QString& query,
+                                                   SQLInterface* fullText = nullptr);
+
+    // 同上语义，作用于列式存储：返回命中行号
+    // 提供 n-gram 索引且查询不短于 2 个字符时：索引求候选 + 在存储上校验（按行序）；
+    // 否则传入 fullText（store 所在数据库的连接）且 FTS 可用时取 FTS 命中（bm25 序），再否则线性扫描（按行序）
+    // 提供 ranker 时，三条路径的命中都再按 BM25 分数降序排列（标题命中优先于岗位要求命中；同分保持原有顺序）
+    static QVector<int> searchRows(const JobStore& store, const QString& query, const NgramIndex* index = nullptr,
+                                   const Bm25Index* ranker = nullptr, SQLInterface* fullText = nullptr);
 
     // 搜索业务（按字段映射）：接收 QMap<字段名, QVector<匹配字符串>>，用于按列筛选
     // 语义：不同字段之间使用 AND（必须同时满足所有字段条件），同一字段内的多个值为 OR（任一匹配即可）
     // 支持字段: "jobName", "requirements", "companyName", "cityName", "sourceName", "tagNames", "jobId"
     // 对于文本字段，使用不区分大小写的子串匹配；对于 "jobId" 使用精确数值匹配。
+    // 月薪区间字段 "monthlySalaryMin" / "monthlySalaryMax" / "monthlySalaryOverlap" 见 db_types.h
     static QVector<SQLNS::JobInfoPrint> searchJobs(const QVector<SQLNS::JobInfoPrint>& source,
                                                    const QMap<QString, QVector<QString>>& fieldFilters);
 
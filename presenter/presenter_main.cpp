@@ -9,15 +9,21 @@ QVector<SQLNS::JobInfoPrint> Presenter::getAllJobs() {
 
 // 带参数版本（自定义分页）
 QVector<SQLNS::JobInfoPrint> Presenter::getAllJobs(int page, int pageSize) {
-    QVector<SQLNS::JobInfoPrint> allJobs;
+    QVector<SQLNS::JobInfoPrint> pageJobs;
+    if (page < 1) page = 1;
+    if (pageSize < 1) pageSize = 20;
+    const long long skip = static_cast<long long>(page - 1) * pageSize;
 
-    // 连接数据库并查询（使用解析后的展示接口）
+    // 连接数据库并流式读取：跳过前 (page-1)*pageSize 条，只保留当前页，读满即停止
     SQLInterface sqlInterface;
     if (sqlInterface.connectSqlite(Presenter::DEFAULT_DB_PATH)) {
-        allJobs = sqlInterface.queryAllJobsPrint();
+        long long seen = 0;
+        sqlInterface.forEachJobPrint([&](const SQLNS::JobInfoPrint &job) {
+            if (seen++ < skip) return true;
+            pageJobs.append(job);
+            return pageJobs.size() < pageSize;
+        });
         sqlInterface.disconnect();
     }
-
-    // 调用分页函数，使用传入的分页参数
-    return Presenter::paging(allJobs, page, pageSize);
+    return pageJobs;
 }
@@ -2,6 +2,13 @@
 #include "presenter.h"
 #include <QRegularExpression>
 #include <QDebug>
+#include <QHash>
+#include <QDateTime>
+#include "db/sqlinterface.h"
+#include "job_store.h"
+#include "ngram_index.h"
+#include "bm25_index.h"
+#include <algorithm>
 
 QVector<SQLNS::JobInfoPrint> Presenter::filterJobsByCity(const QVector<SQLNS::JobInfoPrint>& jobs, const QString& cityQuery) {
     if (cityQuery.isEmpty()) return jobs;
@@ -17,7 +24,8 @@ QVector<SQLNS::JobInfoPrint> Presenter::filterJobsByCity(const QVector<SQLNS::Jo
 
 // 搜索实现：模糊匹配名称/公司/城市/标签；若为纯数字，则仅按 jobId 精确匹配
 QVector<SQLNS::JobInfoPrint> Presenter::searchJobs(const QVector<SQLNS::JobInfoPrint>& source,
-                                             const QString& query) {
+                                             const QString& query,
+                                             SQLInterface* fullText) {
     QVector<SQLNS::JobInfoPrint> ret;
     if (query.isEmpty()) return source;
 
@@ -37,7 +45,22 @@ QVector<SQLNS::JobInfoPrint> Presenter::searchJobs(const QVector<SQLNS::JobInfoP
         return ret;
     }
 
-    // 非数字：按模糊文本匹配 jobName / requirements / companyName / cityName / tagNames
+    // 非数字：优先使用调用方连接上的 FTS5 全文索引，按相关度返回（名称命中优先于要求命中）
+    QVector<long long> rankedIds;
+    bool ftsOk = false;
+    if (fullText && fullText->isConnected()) rankedIds = fullText->searchJobIds(query, -1, &ftsOk);
+    if (ftsOk) {
+        QHash<long long, int> indexById;
+        indexById.reserve(source.size());
+        for (int i = 0; i < source.size(); ++i) indexById.insert(source[i].jobId, i);
+        for (long long id : rankedIds) {
+            auto it = indexById.constFind(id);
+            if (it != indexById.constEnd()) ret.append(source[it.value()]);
+        }
+        return ret;
+    }
+
+    // 回退（无全文索引）：按模糊文本匹配 jobName / requirements / companyName / cityName / tagNames
     for (const auto &job : source) {
         if (job.jobName.contains(query, Qt::CaseInsensitive)) { ret.append(job); continue; }
         if (job.requirements.contains(query, Qt::CaseInsensitive)) { ret.append(job); continue; }
@@ -52,12 +75,69 @@ QVector<SQLNS::JobInfoPrint> Presenter::searchJobs(const QVector<SQLNS::JobInfoP
     return ret;
 }
 
+// 按 BM25 分数降序重排命中行（同分 / 未计分的保持原有的行序）
+static void rankRows(const JobStore& store, const QString& query, const Bm25Index* ranker, QVector<int>& rows) {
+    if (!ranker || rows.size() < 2) return;
+    const QHash<long long, double> scores = ranker->scores(query);
+    if (scores.isEmpty()) return;
+    QVector<double> key(rows.size());
+    for (int i = 0; i < rows.size(); ++i) key[i] = scores.value(store.jobId(rows[i]), 0.0);
+    QVector<int> order(rows.size());
+    for (int i = 0; i < order.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&key](int a, int b) { return key[a] > key[b]; });
+    QVector<int> ranked;
+    ranked.reserve(rows.size());
+    for (int i : order) ranked.append(rows[i]);
+    rows = std::move(ranked);
+}
+
+// 搜索实现（列式存储）：与上面的 searchJobs(source, query) 判定一致，只产出行号不复制职位
+QVector<int> Presenter::searchRows(const JobStore& store, const QString& query, const NgramIndex* index, const Bm25Index* ranker,
+                                   SQLInterface* fullText) {
+    if (query.isEmpty()) return store.allRows();
+
+    static const QRegularExpression digitsRegex("^\\d+$");
+    if (digitsRegex.match(query.trimmed()).hasMatch()) {
+        bool ok = false;
+        const long long qid = query.toLongLong(&ok);
+        QVector<int> rows;
+        if (ok) {
+            for (int r = 0; r < store.size(); ++r) {
+                if (store.jobId(r) == qid) rows.append(r);
+            }
+        }
+        return rows;
+    }
+
+    // 进程内 n-gram 索引：倒排表求交得到候选，再回查真实文本排除假阳性
+    if (index) {
+        bool usable = false;
+        const QVector<long long> candidateIds = index->candidates(query, &usable);
+        if (usable) {
+            QVector<int> rows = store.rowsForJobIds(candidateIds);
+            std::sort(rows.begin(), rows.end());
+            QVector<int> hits = store.matchText(query, rows);
+            rankRows(store, query, ranker, hits);
+            return hits;
+        }
+    }
+
+    QVector<long long> rankedIds;
+    bool ftsOk = false;
+    if (fullText && fullText->isConnected()) rankedIds = fullText->searchJobIds(query, -1, &ftsOk);
+    // FTS 命中同样交给 ranker 重排，三条路径共用一个相关度口径；同分保持 FTS 的 bm25 顺序
+    QVector<int> hits = ftsOk ? store.rowsForJobIds(rankedIds) : store.matchText(query);
+    rankRows(store, query, ranker, hits);
+    return hits;
+}
+
 // 搜索实现（按字段映射）：QMap<字段名, QVector<值>>
 // 语义：不同字段之间使用 AND，字段内部值使用 OR
 QVector<SQLNS::JobInfoPrint> Presenter::searchJobs(const QVector<SQLNS::JobInfoPrint>& source,
                                                    const QMap<QString, QVector<QString>>& fieldFilters) {
     QVector<SQLNS::JobInfoPrint> ret;
     if (fieldFilters.isEmpty()) return source;
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
 
     for (const auto &job : source) {
         bool include = true;
@@ -108,6 +188,26 @@ QVector<SQLNS::JobInfoPrint> Presenter::searchJobs(const QVector<SQLNS::JobInfoP
                         if (!ok) continue;
                         if (job.salarySlabId == q) { fieldMatched = true; break; }
                 }
+            } else if (SQLNS::isRecencyField(field)) {
+                // N 天内发布 / HR N 天内活跃（时间未知不命中）
+                const bool posted = (field == "postedWithinDays");
+                const qint64 epoch = posted ? (job.createEpoch > 0 ? job.createEpoch : SQLNS::timeEpoch(job.createTime))
+                                            : (job.hrLastLoginEpoch > 0 ? job.hrLastLoginEpoch : SQLNS::timeEpoch(job.hrLastLoginTime));
+                for (const auto &v : vals) {
+                    qint64 cutoff = 0;
+                    if (epoch > 0 && SQLNS::recencyCutoff(v, now, &cutoff) && epoch >= cutoff) { fieldMatched = true; break; }
+                }
+            } else if (SQLNS::isCollapseField(field)) {
+                // 近重复折叠：开启时只保留规范职位，关闭时不限制
+                fieldMatched = !SQLNS::collapseEnabled(vals) || job.canonicalJobId == 0;
+            } else if (SQLNS::isSalaryRangeField(field)) {
+                // 月薪区间（换算口径见 db_types.h）
+                const double low = SQLNS::monthlySalary(job.salaryMin, job.recruitTypeId);
+                const double high = SQLNS::monthlySalary(qMax(job.salaryMin, job.salaryMax), job.recruitTypeId);
+                for (const auto &v : vals) {
+                    SQLNS::SalaryBounds b;
+                    if (SQLNS::salaryBounds(field, v, &b) && SQLNS::salaryInBounds(low, high, b)) { fieldMatched = true; break; }
+                }
             } else if (field == "tagNames" || field == "tags") {
                 for (const auto &v : vals) {
                     for (const auto &t : job.tagNames) {
@@ -1,29 +1,65 @@
 // presenter/presenter_sort.cpp
 #include "presenter.h"
+#include "job_store.h"
+#include <algorithm>
+#include <numeric>
 
 QVector<SQLNS::JobInfoPrint> Presenter::sortJobs(const QVector<SQLNS::JobInfoPrint>& jobs, const QString& field, bool asc) {
-    QVector<SQLNS::JobInfoPrint> sortedJobs = jobs;
-    QString key = field.trimmed().toLower();
+    // 字段名只解析一次；比较键预先算好，比较器内只做数值比较（规则与 JobStore::sort 一致）
+    QVector<int> order(jobs.size());
+    std::iota(order.begin(), order.end(), 0);
+    auto sortBy = [&order, asc](const auto &keyOf) {
+        if (asc) {
+            std::stable_sort(order.begin(), order.end(), [&keyOf](int a, int b) { return keyOf(a) < keyOf(b); });
+        } else {
+            std::stable_sort(order.begin(), order.end(), [&keyOf](int a, int b) { return keyOf(b) < keyOf(a); });
+        }
+    };
 
-    auto lessByField = [key](const SQLNS::JobInfoPrint& a, const SQLNS::JobInfoPrint& b) -> bool {
-        if (key == "jobid" || key == "id" || key == "job_id") {
-            return a.jobId < b.jobId;
-        } else if (key == "jobname" || key == "job_name") {
-            return a.jobName < b.jobName; // QString operator< uses code-point order
-        } else if (key == "salarymin" || key == "salary_min") {
-            return a.salaryMin < b.salaryMin;
-        } else if (key == "salarymax" || key == "salary_max") {
-            return a.salaryMax < b.salaryMax;
+    // 时间按 epoch 比较；行中没有 epoch 时解析字符串（与 JobStore::append 相同），每行只算一次
+    auto sortByEpoch = [&jobs, &sortBy](qint64 SQLNS::JobInfoPrint::*epoch, QString SQLNS::JobInfoPrint::*text) {
+        QVector<qint64> keys(jobs.size());
+        for (int i = 0; i < jobs.size(); ++i) {
+            keys[i] = jobs[i].*epoch > 0 ? jobs[i].*epoch : SQLNS::timeEpoch(jobs[i].*text);
         }
-        // fallback: by jobId to ensure deterministic order
-        return a.jobId < b.jobId;
+        sortBy([&keys](int i) { return keys[i]; });
     };
 
-    if (asc) {
-        std::stable_sort(sortedJobs.begin(), sortedJobs.end(), lessByField);
-    } else {
-        std::stable_sort(sortedJobs.begin(), sortedJobs.end(), [&lessByField](const SQLNS::JobInfoPrint& a, const SQLNS::JobInfoPrint& b){ return lessByField(b, a); });
+    switch (JobStore::sortColumn(field)) {
+    case JobStore::SortColumn::JobName: {
+        // 职位名按字典排序名次（规范化 + 中文排序规则）比较
+        StringDictionary names;
+        QVector<int> codes;
+        codes.reserve(jobs.size());
+        for (const auto &job : jobs) codes.append(names.intern(job.jobName));
+        const QVector<int> ranks = names.sortRanks();
+        sortBy([&codes, &ranks](int i) { return ranks[codes[i]]; });
+        break;
     }
+    case JobStore::SortColumn::SalaryMin:
+        sortBy([&jobs](int i) { return jobs[i].salaryMin; });
+        break;
+    case JobStore::SortColumn::SalaryMax:
+        sortBy([&jobs](int i) { return jobs[i].salaryMax; });
+        break;
+    case JobStore::SortColumn::CreateTime:
+        sortByEpoch(&SQLNS::JobInfoPrint::createEpoch, &SQLNS::JobInfoPrint::createTime);
+        break;
+    case JobStore::SortColumn::UpdateTime:
+        sortByEpoch(&SQLNS::JobInfoPrint::updateEpoch, &SQLNS::JobInfoPrint::updateTime);
+        break;
+    case JobStore::SortColumn::HrLastLoginTime:
+        sortByEpoch(&SQLNS::JobInfoPrint::hrLastLoginEpoch, &SQLNS::JobInfoPrint::hrLastLoginTime);
+        break;
+    case JobStore::SortColumn::JobId:
+        // 未知字段同样按 jobId，保证顺序确定
+        sortBy([&jobs](int i) { return jobs[i].jobId; });
+        break;
+    }
+
+    QVector<SQLNS::JobInfoPrint> sortedJobs;
+    sortedJobs.reserve(jobs.size());
+    for (int i : order) sortedJobs.append(jobs[i]);
     return sortedJobs;
 }
 
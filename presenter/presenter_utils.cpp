@@ -10,6 +10,10 @@ QString Presenter::formatTime(const QString& timeStr) {
     return dt.isValid() ? dt.toString("yyyy年MM月dd日") : "无效时间";
 }
 
+QString Presenter::formatTime(qint64 epoch) {
+    return epoch > 0 ? QDateTime::fromSecsSinceEpoch(epoch).toString("yyyy年MM月dd日") : "无效时间";
+}
+
 // 分页函数
 QVector<SQLNS::JobInfoPrint> Presenter::paging(const QVector<SQLNS::JobInfoPrint>& source, int page, int pageSize) {
     if (page < 1) page = 1;
@@ -32,7 +36,7 @@ QString Presenter::toLine(const SQLNS::JobInfoPrint &job) {
         .arg(job.cityName)
         .arg(job.salaryMin)
         .arg(job.salaryMax)
-        .arg(formatTime(job.createTime));
+        .arg(job.createEpoch > 0 ? formatTime(job.createEpoch) : formatTime(job.createTime));
 }
 
 // 按行打印岗位列表
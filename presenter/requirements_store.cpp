@@ -0,0 +1,55 @@
+// presenter/requirements_store.cpp
+#include "requirements_store.h"
+#include <QDebug>
+#include "db/sqlinterface.h"
+
+RequirementsStore::RequirementsStore(const QString &dbPath, int cacheCapacity) : m_dbPath(dbPath) {
+    m_recent.setMaxCost(cacheCapacity);
+}
+
+QString RequirementsStore::requirements(long long jobId) const {
+    {
+        QMutexLocker locker(&m_mutex);
+        if (const QString *cached = m_recent.object(jobId)) return *cached;
+    }
+    const QString text = fetch({jobId}).value(jobId);
+    QMutexLocker locker(&m_mutex);
+    m_recent.insert(jobId, new QString(text));
+    return text;
+}
+
+QHash<long long, QString> RequirementsStore::fetch(const QVector<long long> &jobIds) const {
+    QHash<long long, QString> texts;
+    QVector<long long> missing;
+    {
+        QMutexLocker locker(&m_mutex);
+        for (long long id : jobIds) {
+            if (const QString *cached = m_recent.object(id)) {
+                texts.insert(id, *cached);
+            } else {
+                missing.append(id);
+            }
+        }
+    }
+    if (missing.isEmpty()) return texts;
+
+    SQLInterface sqlInterface;
+    if (!sqlInterface.connectSqlite(m_dbPath)) {
+        qDebug() << "RequirementsStore: cannot open" << m_dbPath;
+        return texts;
+    }
+    texts.insert(sqlInterface.queryRequirements(missing));
+    sqlInterface.disconnect();
+    return texts;
+}
+
+QSet<long long> RequirementsStore::matchAny(const QVector<QString> &needles) const {
+    SQLInterface sqlInterface;
+    if (!sqlInterface.connectSqlite(m_dbPath)) {
+        qDebug() << "RequirementsStore: cannot open" << m_dbPath;
+        return {};
+    }
+    const QVector<long long> ids = sqlInterface.searchRequirementIds(needles);
+    sqlInterface.disconnect();
+    return QSet<long long>(ids.begin(), ids.end());
+}
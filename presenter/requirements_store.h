@@ -0,0 +1,29 @@
+// presenter/requirements_store.h
+#ifndef REQUIREMENTS_STORE_H
+#define REQUIREMENTS_STORE_H
+
+#include <QCache>
+#include <QMutex>
+#include <QString>
+#include "job_store.h"
+
+// 从数据库按需读取岗位要求（RequirementsSource 的 SQLite 实现）
+// - requirements(jobId)：详情对话框用，结果放入最近查看的小型 LRU
+// - fetch / matchAny：文本匹配用，批量查询，不写入 LRU（避免大批候选挤掉最近查看的条目）
+// 每次调用在当前线程的连接上执行，可在任意线程使用
+class RequirementsStore : public RequirementsSource {
+public:
+    explicit RequirementsStore(const QString &dbPath, int cacheCapacity = 64);
+
+    QString requirements(long long jobId) const;
+
+    QHash<long long, QString> fetch(const QVector<long long> &jobIds) const override;
+    QSet<long long> matchAny(const QVector<QString> &needles) const override;
+
+private:
+    QString m_dbPath;
+    mutable QMutex m_mutex;   // 保护 m_recent
+    mutable QCache<long long, QString> m_recent;
+};
+
+#endif // REQUIREMENTS_STORE_H
@@ -0,0 +1,285 @@
+// presenter/roaring_bitmap.cpp
+#include "roaring_bitmap.h"
+#include <algorithm>
+
+namespace {
+
+inline int popcount64(quint64 w) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(w);
+#else
+    int n = 0;
+    while (w) { w &= w - 1; ++n; }
+    return n;
+#endif
+}
+
+inline int ctz64(quint64 w) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(w);
+#else
+    int n = 0;
+    while (!(w & 1)) { w >>= 1; ++n; }
+    return n;
+#endif
+}
+
+} // namespace
+
+// ==================== Container ====================
+
+bool RoaringBitmap::Container::contains(quint16 low) const {
+    if (isBitset()) return (bits[low >> 6] >> (low & 63)) & 1;
+    return std::binary_search(array.constBegin(), array.constEnd(), low);
+}
+
+void RoaringBitmap::Container::add(quint16 low) {
+    if (isBitset()) {
+        quint64 &w = bits[low >> 6];
+        const quint64 mask = quint64(1) << (low & 63);
+        if (!(w & mask)) { w |= mask; ++cardinality; }
+        return;
+    }
+    // 升序追加是常见路径（行号递增写入）
+    if (array.isEmpty() || array.last() < low) {
+        array.append(low);
+    } else {
+        auto it = std::lower_bound(array.begin(), array.end(), low);
+        if (*it == low) return;
+        array.insert(it, low);
+    }
+    ++cardinality;
+    if (cardinality > kArrayMax) toBitset();
+}
+
+void RoaringBitmap::Container::toBitset() {
+    if (isBitset()) return;
+    bits = QVector<quint64>(kBitsetWords, 0);
+    for (quint16 v : array) bits[v >> 6] |= quint64(1) << (v & 63);
+    array.clear();
+    array.squeeze();
+}
+
+void RoaringBitmap::Container::toArrayIfSparse() {
+    if (!isBitset() || cardinality > kArrayMax) return;
+    array.clear();
+    array.reserve(cardinality);
+    for (int i = 0; i < kBitsetWords; ++i) {
+        quint64 w = bits[i];
+        while (w) {
+            const int bit = ctz64(w);
+            array.append(static_cast<quint16>(i * 64 + bit));
+            w &= w - 1;
+        }
+    }
+    bits.clear();
+    bits.squeeze();
+}
+
+RoaringBitmap::Container RoaringBitmap::unite(const Container &a, const Container &b) {
+    Container out;
+    out.key = a.key;
+    if (a.isBitset() || b.isBitset()) {
+        out = a.isBitset() ? a : b;
+        const Container &other = a.isBitset() ? b : a;
+        if (other.isBitset()) {
+            for (int i = 0; i < kBitsetWords; ++i) out.bits[i] |= other.bits[i];
+        } else {
+            for (quint16 v : other.array) out.bits[v >> 6] |= quint64(1) << (v & 63);
+        }
+        out.cardinality = 0;
+        for (quint64 w : out.bits) out.cardinality += popcount64(w);
+        return out;
+    }
+    out.array.reserve(a.array.size() + b.array.size());
+    std::set_union(a.array.constBegin(), a.array.constEnd(), b.array.constBegin(), b.array.constEnd(),
+                   std::back_inserter(out.array));
+    out.cardinality = out.array.size();
+    if (out.cardinality > kArrayMax) out.toBitset();
+    return out;
+}
+
+RoaringBitmap::Container RoaringBitmap::intersect(const Container &a, const Container &b) {
+    Container out;
+    out.key = a.key;
+    if (a.isBitset() && b.isBitset()) {
+        out.bits = QVector<quint64>(kBitsetWords, 0);
+        for (int i = 0; i < kBitsetWords; ++i) {
+            out.bits[i] = a.bits[i] & b.bits[i];
+            out.cardinality += popcount64(out.bits[i]);
+        }
+        out.toArrayIfSparse();
+        return out;
+    }
+    if (a.isBitset() || b.isBitset()) {
+        const Container &dense = a.isBitset() ? a : b;
+        const Container &sparse = a.isBitset() ? b : a;
+        for (quint16 v : sparse.array) {
+            if (dense.contains(v)) out.array.append(v);
+        }
+    } else {
+        std::set_intersection(a.array.constBegin(), a.array.constEnd(), b.array.constBegin(), b.array.constEnd(),
+                              std::back_inserter(out.array));
+    }
+    out.cardinality = out.array.size();
+    return out;
+}
+
+// ==================== RoaringBitmap ====================
+
+int RoaringBitmap::findContainer(quint16 key) const {
+    auto it = std::lower_bound(m_containers.constBegin(), m_containers.constEnd(), key,
+                               [](const Container &c, quint16 k) { return c.key < k; });
+    if (it == m_containers.constEnd() || it->key != key) return -1;
+    return static_cast<int>(it - m_containers.constBegin());
+}
+
+void RoaringBitmap::add(quint32 value) {
+    const quint16 key = static_cast<quint16>(value >> 16);
+    const quint16 low = static_cast<quint16>(value & 0xFFFF);
+    if (!m_containers.isEmpty() && m_containers.last().key == key) {
+        m_containers.last().add(low);
+        return;
+    }
+    auto it = std::lower_bound(m_containers.begin(), m_containers.end(), key,
+                               [](const Container &c, quint16 k) { return c.key < k; });
+    if (it == m_containers.end() || it->key != key) {
+        Container c;
+        c.key = key;
+        it = m_containers.insert(it, c);
+    }
+    it->add(low);
+}
+
+bool RoaringBitmap::contains(quint32 value) const {
+    const int idx = findContainer(static_cast<quint16>(value >> 16));
+    return idx >= 0 && m_containers[idx].contains(static_cast<quint16>(value & 0xFFFF));
+}
+
+int RoaringBitmap::cardinality() const {
+    int n = 0;
+    for (const auto &c : m_containers) n += c.cardinality;
+    return n;
+}
+
+RoaringBitmap &RoaringBitmap::operator|=(const RoaringBitmap &other) {
+    QVector<Container> merged;
+    merged.reserve(m_containers.size() + other.m_containers.size());
+    int i = 0, j = 0;
+    while (i < m_containers.size() || j < other.m_containers.size()) {
+        if (j >= other.m_containers.size() || (i < m_containers.size() && m_containers[i].key < other.m_containers[j].key)) {
+            merged.append(m_containers[i++]);
+        } else if (i >= m_containers.size() || other.m_containers[j].key < m_containers[i].key) {
+            merged.append(other.m_containers[j++]);
+        } else {
+            merged.append(unite(m_containers[i++], other.m_containers[j++]));
+        }
+    }
+    m_containers = merged;
+    return *this;
+}
+
+RoaringBitmap &RoaringBitmap::operator&=(const RoaringBitmap &other) {
+    QVector<Container> kept;
+    int i = 0, j = 0;
+    while (i < m_containers.size() && j < other.m_containers.size()) {
+        if (m_containers[i].key < other.m_containers[j].key) {
+            ++i;
+        } else if (other.m_containers[j].key < m_containers[i].key) {
+            ++j;
+        } else {
+            Container c = intersect(m_containers[i++], other.m_containers[j++]);
+            if (c.cardinality > 0) kept.append(c);
+        }
+    }
+    m_containers = kept;
+    return *this;
+}
+
+QVector<int> RoaringBitmap::toVector() const {
+    QVector<int> out;
+    out.reserve(cardinality());
+    for (const auto &c : m_containers) {
+        const int base = int(c.key) << 16;
+        if (c.isBitset()) {
+            for (int i = 0; i < kBitsetWords; ++i) {
+                quint64 w = c.bits[i];
+                while (w) {
+                    out.append(base + i * 64 + ctz64(w));
+                    w &= w - 1;
+                }
+            }
+        } else {
+            for (quint16 v : c.array) out.append(base + v);
+        }
+    }
+    return out;
+}
+
+int RoaringBitmap::intersectionCardinality(const RoaringBitmap &a, const RoaringBitmap &b) {
+    int n = 0;
+    int i = 0, j = 0;
+    while (i < a.m_containers.size() && j < b.m_containers.size()) {
+        const Container &ca = a.m_containers[i];
+        const Container &cb = b.m_containers[j];
+        if (ca.key < cb.key) { ++i; continue; }
+        if (cb.key < ca.key) { ++j; continue; }
+        if (ca.isBitset() && cb.isBitset()) {
+            for (int w = 0; w < kBitsetWords; ++w) n += popcount64(ca.bits[w] & cb.bits[w]);
+        } else if (ca.isBitset() || cb.isBitset()) {
+            const Container &dense = ca.isBitset() ? ca : cb;
+            const Container &sparse = ca.isBitset() ? cb : ca;
+            for (quint16 v : sparse.array) n += dense.contains(v) ? 1 : 0;
+        } else {
+            int x = 0, y = 0;
+            while (x < ca.array.size() && y < cb.array.size()) {
+                if (ca.array[x] < cb.array[y]) ++x;
+                else if (cb.array[y] < ca.array[x]) ++y;
+                else { ++n; ++x; ++y; }
+            }
+        }
+        ++i;
+        ++j;
+    }
+    return n;
+}
+
+QDataStream &operator<<(QDataStream &out, const RoaringBitmap &bitmap) {
+    out << static_cast<qint32>(bitmap.m_containers.size());
+    for (const auto &c : bitmap.m_containers) {
+        out << c.key << static_cast<qint32>(c.cardinality) << static_cast<quint8>(c.isBitset() ? 1 : 0);
+        if (c.isBitset()) {
+            out << c.bits;
+        } else {
+            out << c.array;
+        }
+    }
+    return out;
+}
+
+QDataStream &operator>>(QDataStream &in, RoaringBitmap &bitmap) {
+    bitmap.m_containers.clear();
+    qint32 count = 0;
+    in >> count;
+    if (count < 0 || count > 0x10000) {
+        in.setStatus(QDataStream::ReadCorruptData);
+        return in;
+    }
+    bitmap.m_containers.reserve(count);
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        RoaringBitmap::Container c;
+        qint32 cardinality = 0;
+        quint8 dense = 0;
+        in >> c.key >> cardinality >> dense;
+        if (dense) {
+            in >> c.bits;
+            if (c.bits.size() != RoaringBitmap::kBitsetWords) in.setStatus(QDataStream::ReadCorruptData);
+        } else {
+            in >> c.array;
+            if (c.array.size() != cardinality) in.setStatus(QDataStream::ReadCorruptData);
+        }
+        c.cardinality = cardinality;
+        bitmap.m_containers.append(c);
+    }
+    return in;
+}
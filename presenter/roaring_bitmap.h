@@ -0,0 +1,59 @@
+// presenter/roaring_bitmap.h
+#ifndef ROARING_BITMAP_H
+#define ROARING_BITMAP_H
+
+#include <QVector>
+#include <QDataStream>
+#include <QtGlobal>
+
+// Roaring 风格的压缩位图（用于 JobStore 的分面索引，元素为行号）
+// 按高 16 位分桶；每个桶内：元素不超过 4096 个时用有序 quint16 数组，
+// 否则用 65536 位的位图（1024 个 quint64）。与/或运算逐桶进行，
+// 稀疏桶走归并、稠密桶走按字运算。
+class RoaringBitmap {
+public:
+    // 插入元素；按升序追加时为 O(1)
+    void add(quint32 value);
+    bool contains(quint32 value) const;
+    int cardinality() const;
+    bool isEmpty() const { return m_containers.isEmpty(); }
+
+    RoaringBitmap &operator|=(const RoaringBitmap &other);
+    RoaringBitmap &operator&=(const RoaringBitmap &other);
+    friend RoaringBitmap operator|(RoaringBitmap a, const RoaringBitmap &b) { return a |= b; }
+    friend RoaringBitmap operator&(RoaringBitmap a, const RoaringBitmap &b) { return a &= b; }
+
+    // 升序展开为行号
+    QVector<int> toVector() const;
+    // |a ∩ b|，不生成交集
+    static int intersectionCardinality(const RoaringBitmap &a, const RoaringBitmap &b);
+
+    // 序列化（n-gram 索引持久化用）
+    friend QDataStream &operator<<(QDataStream &out, const RoaringBitmap &bitmap);
+    friend QDataStream &operator>>(QDataStream &in, RoaringBitmap &bitmap);
+
+private:
+    static constexpr int kArrayMax = 4096;
+    static constexpr int kBitsetWords = 1024;
+
+    struct Container {
+        quint16 key = 0;
+        int cardinality = 0;
+        QVector<quint16> array;   // 稀疏：有序数组
+        QVector<quint64> bits;    // 稠密：kBitsetWords 个字（非空即表示位图形态）
+
+        bool isBitset() const { return !bits.isEmpty(); }
+        bool contains(quint16 low) const;
+        void add(quint16 low);
+        void toBitset();
+        void toArrayIfSparse();
+    };
+
+    static Container unite(const Container &a, const Container &b);
+    static Container intersect(const Container &a, const Container &b);
+    int findContainer(quint16 key) const;
+
+    QVector<Container> m_containers;   // 按 key 升序
+};
+
+#endif // ROARING_BITMAP_H
@@ -0,0 +1,445 @@
+// presenter/segmenter.cpp
+#include "segmenter.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// 内置词表：招聘文本常用词（岗位、职能、能力要求、福利等），词频为相对量级
+// 技术名词放在用户词典 data/user_dict.txt，便于不改代码直接补充
+const char *const kBuiltinDictionary = R"(
+的 50000
+和 30000
+与 20000
+及 15000
+或 12000
+等 12000
+在 12000
+有 15000
+了 10000
+是 12000
+对 10000
+能 8000
+为 8000
+以上 6000
+以下 3000
+相关 9000
+负责 8000
+参与 5000
+具备 5000
+具有 4000
+熟悉 9000
+熟练 6000
+掌握 6000
+了解 6000
+精通 3000
+能力 9000
+良好 6000
+优秀 4000
+较强 4000
+优先 8000
+经验 9000
+工作 9000
+工作经验 4000
+项目 8000
+项目经验 4000
+团队 6000
+团队合作 2000
+合作 4000
+沟通 5000
+沟通能力 3000
+学习 5000
+学习能力 3000
+责任心 3000
+逻辑 2000
+思维 2000
+问题 4000
+分析 5000
+解决 4000
+设计 7000
+开发 9000
+研发 5000
+测试 6000
+运维 3000
+维护 3000
+优化 4000
+实现 4000
+编写 3000
+文档 3000
+需求 5000
+方案 3000
+架构 4000
+系统 8000
+平台 6000
+产品 7000
+业务 6000
+技术 8000
+数据 8000
+服务 5000
+应用 5000
+软件 5000
+硬件 3000
+网络 3000
+安全 3000
+性能 3000
+质量 3000
+代码 3000
+框架 3000
+工具 3000
+模块 2000
+接口 2000
+功能 3000
+用户 4000
+客户 3000
+市场 3000
+运营 4000
+销售 3000
+管理 6000
+行业 2000
+领域 2000
+方向 3000
+岗位 6000
+职位 4000
+职责 4000
+要求 6000
+任职 3000
+任职要求 2000
+岗位职责 2000
+工程师 8000
+开发工程师 3000
+测试工程师 1500
+算法工程师 1500
+研发工程师 1500
+实习生 3000
+实习 5000
+校招 2000
+社招 1500
+应届 1500
+应届生 1500
+毕业生 2000
+本科 4000
+硕士 3000
+博士 1500
+学历 3000
+专业 4000
+计算机 4000
+计算机专业 800
+软件工程 1500
+通信 2000
+电子 2000
+数学 2000
+统计 1500
+自动化 1500
+英语 2000
+前端 4000
+后端 4000
+客户端 2000
+服务端 2000
+服务器 2000
+全栈 1000
+移动端 1000
+嵌入式 2000
+算法 5000
+数据库 4000
+操作系统 1500
+数据结构 2000
+计算机网络 800
+编程 3000
+语言 3000
+编程语言 1000
+面向对象 1000
+多线程 1200
+并发 1500
+高并发 1200
+分布式 2000
+微服务 1200
+中间件 1200
+缓存 1200
+消息队列 800
+大数据 2000
+数据分析 2000
+数据挖掘 1000
+机器学习 2000
+深度学习 2000
+人工智能 2000
+自然语言处理 800
+计算机视觉 800
+推荐 2000
+推荐系统 800
+搜索 2000
+大模型 1500
+模型 3000
+训练 2000
+推理 1500
+图像 1500
+视觉 1500
+语音 1000
+芯片 1500
+云计算 1000
+游戏 2000
+引擎 1500
+图形 1000
+网页 1000
+小程序 1000
+交互 1500
+体验 2000
+视觉设计 500
+交互设计 500
+产品经理 1500
+项目经理 1000
+经理 2000
+主管 1000
+总监 800
+专员 1000
+助理 1200
+顾问 800
+分析师 1000
+架构师 1000
+设计师 1500
+运营专员 500
+公司 6000
+企业 3000
+集团 2000
+科技 4000
+有限公司 3000
+股份 1500
+互联网 3000
+北京 3000
+上海 3000
+深圳 3000
+广州 2000
+杭州 2000
+成都 1500
+南京 1500
+武汉 1500
+西安 1200
+苏州 1000
+薪资 2000
+薪酬 1000
+福利 2000
+五险一金 1500
+年终奖 1000
+奖金 1000
+补贴 1000
+餐补 500
+房补 500
+双休 1000
+弹性 1000
+加班 800
+转正 1200
+培训 1200
+晋升 1000
+发展 3000
+成长 1500
+机会 2000
+环境 2000
+氛围 1000
+地点 1000
+时间 3000
+每周 1000
+个月 2000
+年 4000
+天 3000
+周 2000
+)";
+
+// FNV-1a（64 位），与 Qt 版本 / 哈希种子无关
+quint64 fnv1a(const QString &text, quint64 h = 14695981039346656037ULL) {
+    for (const QChar ch : text) {
+        h ^= ch.unicode();
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+enum class CharKind { Separator, Han, Alnum };
+
+CharKind kindOf(QChar ch) {
+    if (ch.script() == QChar::Script_Han) return CharKind::Han;
+    if (ch.isLetterOrNumber()) return CharKind::Alnum;
+    return CharKind::Separator;
+}
+
+// 从 begin 起的一段连续字母数字的结束位置：
+// '.' 夹在字母数字之间时保留（node.js / 3.5），'+' '#' 出现在末尾时保留（c++ / c#）
+int alnumRunEnd(const QChar *s, int begin, int len) {
+    int i = begin;
+    while (i < len) {
+        const CharKind kind = kindOf(s[i]);
+        if (kind == CharKind::Alnum) { ++i; continue; }
+        if (kind == CharKind::Han || i == begin) break;
+        const bool nextAlnum = (i + 1 < len && kindOf(s[i + 1]) == CharKind::Alnum);
+        if (s[i] == QLatin1Char('.') && nextAlnum) { ++i; continue; }
+        if ((s[i] == QLatin1Char('+') || s[i] == QLatin1Char('#')) && !nextAlnum) { ++i; continue; }
+        break;
+    }
+    return i;
+}
+
+} // namespace
+
+Segmenter::Segmenter() {
+    loadDictionaryText(QString::fromUtf8(kBuiltinDictionary));
+    build();
+}
+
+const Segmenter &Segmenter::shared() {
+    static const Segmenter instance = []() {
+        Segmenter segmenter;
+        const QString path = userDictionaryPath();
+        if (!path.isEmpty() && segmenter.loadDictionary(path)) segmenter.build();
+        return segmenter;
+    }();
+    return instance;
+}
+
+QString Segmenter::userDictionaryPath() {
+    // 与 ConfigManager 查找 config.json 的方式一致：从可执行目录向上找
+    QDir dir(QCoreApplication::applicationDirPath());
+    for (int depth = 0; depth < 12; ++depth) {
+        const QString candidate = dir.filePath("data/user_dict.txt");
+        if (QFile::exists(candidate)) return candidate;
+        if (!dir.cdUp()) break;
+    }
+    return QString();
+}
+
+bool Segmenter::loadDictionary(const QString &path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qDebug() << "Segmenter: cannot open dictionary" << path << file.errorString();
+        return false;
+    }
+    const int added = loadDictionaryText(QString::fromUtf8(file.readAll()));
+    qDebug() << "Segmenter: loaded" << added << "words from" << path;
+    return true;
+}
+
+int Segmenter::loadDictionaryText(const QString &text) {
+    int added = 0;
+    for (const QString &rawLine : text.split(QLatin1Char('\n'))) {
+        const QString line = rawLine.trimmed();
+        if (line.isEmpty() || line.startsWith(QLatin1Char('#'))) continue;
+        const QStringList parts = line.split(QLatin1Char(' '), Qt::SkipEmptyParts);
+        bool ok = false;
+        const double freq = parts.size() > 1 ? parts[1].toDouble(&ok) : 0;
+        addWord(parts[0], ok && freq > 0 ? freq : kDefaultUserFreq);
+        ++added;
+    }
+    return added;
+}
+
+void Segmenter::addWord(const QString &word, double freq) {
+    const QString folded = word.trimmed().toCaseFolded();
+    if (folded.isEmpty() || freq <= 0) return;
+    auto it = m_freq.find(folded);
+    if (it == m_freq.end()) {
+        m_freq.insert(folded, freq);
+    } else {
+        it.value() = qMax(it.value(), freq);
+    }
+}
+
+void Segmenter::build() {
+    m_words.clear();
+    m_words.reserve(m_freq.size());
+    for (auto it = m_freq.constBegin(); it != m_freq.constEnd(); ++it) m_words.append(it.key());
+    std::sort(m_words.begin(), m_words.end());
+
+    double total = 0;
+    for (double f : m_freq) total += f;
+    const double logTotal = std::log(qMax(total, 1.0));
+    m_logProb.resize(m_words.size());
+    m_signature = 14695981039346656037ULL;
+    for (int i = 0; i < m_words.size(); ++i) {
+        const double freq = m_freq.value(m_words[i]);
+        m_logProb[i] = std::log(freq) - logTotal;
+        m_signature = fnv1a(m_words[i] + QLatin1Char(' ') + QString::number(freq), m_signature);
+    }
+    m_unknownLogProb = -logTotal;
+    m_trie.build(m_words);
+}
+
+QStringList Segmenter::segment(const QString &text) const {
+    QStringList tokens;
+    const QString folded = text.toCaseFolded();
+    const QChar *s = folded.constData();
+    const int len = folded.size();
+    QVector<int> atomEnds;
+    int i = 0;
+    while (i < len) {
+        if (kindOf(s[i]) == CharKind::Separator) { ++i; continue; }
+        // 一个不含分隔符的片段，记录各原子的结束位置
+        atomEnds.clear();
+        int j = i;
+        while (j < len) {
+            const CharKind kind = kindOf(s[j]);
+            if (kind == CharKind::Han) {
+                ++j;
+            } else if (kind == CharKind::Alnum) {
+                j = alnumRunEnd(s, j, len);
+            } else {
+                break;
+            }
+            atomEnds.append(j);
+        }
+        cutSpan(folded, i, atomEnds, tokens);
+        i = j;
+    }
+    return tokens;
+}
+
+// 片段 [start, atomEnds.last()) 上的最大概率切分：从后往前 DP，best[p] 为从 p 到片段末尾的最大 log 概率
+void Segmenter::cutSpan(const QString &folded, int start, const QVector<int> &atomEnds, QStringList &out) const {
+    const int n = atomEnds.last() - start;
+    const QChar *s = folded.constData() + start;
+    // nextBoundary[p]：p 为原子起点时，该原子的结束位置；-1 表示 p 不是原子边界
+    QVector<int> nextBoundary(n + 1, -1);
+    int prev = 0;
+    for (int end : atomEnds) {
+        nextBoundary[prev] = end - start;
+        prev = end - start;
+    }
+    nextBoundary[n] = n;
+
+    QVector<double> best(n + 1, -std::numeric_limits<double>::infinity());
+    QVector<int> cut(n + 1, n);
+    best[n] = 0;
+    for (int p = n - 1; p >= 0; --p) {
+        if (nextBoundary[p] < 0) continue;
+        best[p] = m_unknownLogProb + best[nextBoundary[p]];
+        cut[p] = nextBoundary[p];
+        // 同分取更长的词（回调按长度递增）
+        m_trie.commonPrefixSearch(s + p, n - p, [&](int length, int value) {
+            const int end = p + length;
+            if (nextBoundary[end] < 0) return;
+            const double score = m_logProb[value] + best[end];
+            if (score >= best[p]) {
+                best[p] = score;
+                cut[p] = end;
+            }
+        });
+    }
+    for (int p = 0; p < n; p = cut[p]) out.append(QString(s + p, cut[p] - p));
+}
+
+QStringList Segmenter::segmentForSearch(const QString &text) const {
+    QStringList tokens;
+    for (const QString &word : segment(text)) {
+        if (word.size() > 2) {
+            for (int n = 2; n <= 3 && n < word.size(); ++n) {
+                for (int i = 0; i + n <= word.size(); ++i) {
+                    const QString sub = word.mid(i, n);
+                    if (m_trie.exactMatch(sub) >= 0) tokens.append(sub);
+                }
+            }
+        }
+        tokens.append(word);
+    }
+    return tokens;
+}
@@ -0,0 +1,57 @@
+// presenter/segmenter.h
+#ifndef SEGMENTER_H
+#define SEGMENTER_H
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "double_array_trie.h"
+
+// 中文分词（词典 + 最大概率路径），供 BM25 相关度排序使用
+// - 词典为 "词 [词频] [词性]" 文本，一行一条；内置一份招聘文本常用词，可再叠加用户词典（技术名词等）
+// - 文本先做大小写折叠，按分隔符（空白 / 标点）切成片段；片段内每个汉字、每段连续字母数字（含 c++ / c# / node.js 中的 + # .）
+//   各为一个原子，词典词只能在原子边界上起止
+// - 片段内以词典前缀匹配建 DAG，动态规划取 log 词频之和最大的切分；不在词典中的原子按词频 1 计（未登录词不做 HMM 合并）
+// - 构建（build）后只读，可在多个线程中同时切分
+class Segmenter {
+public:
+    // 未给出词频的用户词
+    static constexpr double kDefaultUserFreq = 2000;
+
+    // 内置词表（已 build）
+    Segmenter();
+
+    // 内置词表 + 用户词典（userDictionaryPath，存在时），进程内共享
+    static const Segmenter &shared();
+    // 从可执行目录向上查找 data/user_dict.txt，找不到返回空串
+    static QString userDictionaryPath();
+
+    // 合并词典文件 / 文本（同一词取较大的词频），之后需 build
+    bool loadDictionary(const QString &path);
+    int loadDictionaryText(const QString &text);
+    void addWord(const QString &word, double freq = kDefaultUserFreq);
+    void build();
+
+    // 精确切分：每个原子恰好属于一个词
+    QStringList segment(const QString &text) const;
+    // 搜索切分：精确切分之外，长词（> 2 字）再补出其中的二字 / 三字词典词（用于建索引，提高召回）
+    QStringList segmentForSearch(const QString &text) const;
+
+    bool contains(const QString &word) const { return m_trie.exactMatch(word.toCaseFolded()) >= 0; }
+    int wordCount() const { return m_words.size(); }
+    // 词表签名（FNV-1a，词序无关）：词表变化后依赖切分结果的索引应重建
+    quint64 dictionarySignature() const { return m_signature; }
+
+private:
+    void cutSpan(const QString &folded, int start, const QVector<int> &atomEnds, QStringList &out) const;
+
+    QHash<QString, double> m_freq;   // 折叠后的词 -> 词频（构建前的词表）
+    QVector<QString> m_words;        // trie value -> 词
+    QVector<double> m_logProb;       // trie value -> log(词频 / 总词频)
+    double m_unknownLogProb = 0;
+    quint64 m_signature = 0;
+    DoubleArrayTrie m_trie;
+};
+
+#endif // SEGMENTER_H
@@ -35,6 +35,15 @@ AITransferTask::AITransferTask(QObject *parent)
     , progressBar(nullptr)
     , pythonServerUrl("http://localhost:8000")
     , operationCancelled(false)
+    , pendingChunkIndex(0)
+    , lastFetchedJobId(0)
+    , hasFetchedJobs(false)
+    , jobSourceExhausted(false)
+    , currentDataIndex(0)
+    , totalDataItems(0)
+    , successCount(0)
+    , skippedCount(0)
+    , errorCount(0)
 {
     qDebug() << "AITransferTask 初始化完成";
 }
@@ -115,16 +124,29 @@ void AITransferTask::updateKnowledgeBaseFromDatabase(QWidget *parentWidget, std:
             return;
         }
 
-        // 获取数据库数据
+        // 统计职位总数（数据本身按块流式读取，不一次性加载）
         qInfo() << "开始从数据库获取职位数据...";
-        QVector<QMap<QString, QVariant>> jobData = fetchJobDataFromDatabase();
-        
+        int totalJobs = 0;
+        {
+            SQLInterface sqlInterface;
+            if (sqlInterface.connectSqlite(getDatabasePath())) {
+                // 与 fetchNextJobChunk 相同口径：近重复组只计规范职位
+                SQLNS::JobPageQuery countQuery;
+                countQuery.fieldFilters["collapseDuplicates"] = {"1"};
+                countQuery.pageSize = 1;
+                totalJobs = qMax(sqlInterface.queryJobsPage(countQuery).totalCount, 0);
+                sqlInterface.disconnect();
+            } else {
+                qWarning() << "无法连接到数据库:" << getDatabasePath();
+            }
+        }
+
         // 更新进度并显示日志
-        QString progressMsg = QString("正在获取职位数据...\n获取到 %1 条职位数据\n\n开始逐个处理数据...").arg(jobData.size());
+        QString progressMsg = QString("正在获取职位数据...\n共 %1 条职位数据\n\n开始逐个处理数据...").arg(totalJobs);
         qInfo() << progressMsg;
         updateProgressMessage(progressMsg);
 
-        if (jobData.isEmpty()) {
+        if (totalJobs == 0) {
             qWarning() << "数据库中没有找到职位数据";
             updateProgressMessage("未找到职位数据");
             hideProgressDialog();
@@ -132,15 +154,8 @@ void AITransferTask::updateKnowledgeBaseFromDatabase(QWidget *parentWidget, std:
             return;
         }
 
-        // 格式化数据
-        qInfo() << "开始格式化" << jobData.size() << "条职位数据...";
-        QVector<QMap<QString, QVariant>> formattedData = formatJobDataForSingleProcessing(jobData);
-        QString formatMsg = QString("数据格式化完成，共 %1 条数据\n\n开始逐个发送数据到AI后端...").arg(formattedData.size());
-        qInfo() << formatMsg;
-        updateProgressMessage(formatMsg);
-
         // 开始逐个数据处理流程
-        startSingleDataProcessingLoop(formattedData);
+        startSingleDataProcessingLoop(totalJobs);
     });
 }
 
@@ -307,84 +322,99 @@ void AITransferTask::onNetworkError(const QString &errorDetails)
 
 
 
-QVector<QMap<QString, QVariant>> AITransferTask::fetchJobDataFromDatabase()
+QVector<QMap<QString, QVariant>> AITransferTask::fetchNextJobChunk()
 {
     QVector<QMap<QString, QVariant>> result;
-    
-    // 使用SQLInterface类获取数据
+    if (jobSourceExhausted) return result;
+
+    // 使用SQLInterface按 jobId keyset 读取下一块（每块独立连接，避免与其他窗口共享的连接被关闭）
     SQLInterface sqlInterface;
-    
-    // 首先需要连接数据库
-    QString dbPath = QCoreApplication::applicationDirPath() + "/crawler.db";
+    QString dbPath = getDatabasePath();
     if (!sqlInterface.connectSqlite(dbPath)) {
         qWarning() << "无法连接到数据库:" << dbPath;
+        jobSourceExhausted = true;
         return result;
     }
+
+    SQLNS::JobPageQuery pageQuery;
+    pageQuery.pageSize = kJobChunkSize;
+    pageQuery.hasCursor = hasFetchedJobs;
+    pageQuery.afterJobId = lastFetchedJobId;
+    pageQuery.withTotal = false;
+    // 近重复组只发送规范职位（跨来源重复发布的同一职位不重复向量化）
+    pageQuery.fieldFilters["collapseDuplicates"] = {"1"};
+    SQLNS::JobPage page = sqlInterface.queryJobsPage(pageQuery);
+    sqlInterface.disconnect();
+
+    for (const SQLNS::JobInfoPrint& job : page.rows) {
+        result.append(jobToDataMap(job));
+    }
+    if (!page.rows.isEmpty()) {
+        lastFetchedJobId = page.lastJobId;
+        hasFetchedJobs = true;
+    }
+    if (!page.hasMore) jobSourceExhausted = true;
+    return result;
+}
+
+QMap<QString, QVariant> AITransferTask::jobToDataMap(const SQLNS::JobInfoPrint& job)
+{
+    QMap<QString, QVariant> jobMap;
     
-    // 查询职位信息（包含解析后的名称和标签）
-    QVector<SQLNS::JobInfoPrint> jobs = sqlInterface.queryAllJobsPrint();
+    // 基本信息 - 确保所有数据库字段都被包含
+    jobMap["jobId"] = QVariant::fromValue(job.jobId);
+    jobMap["jobName"] = QVariant(job.jobName);
+    jobMap["title"] = QVariant(job.jobName);  // 保留兼容性
+    jobMap["companyId"] = QVariant::fromValue(job.companyId);
+    jobMap["companyName"] = QVariant(job.companyName.isEmpty() ? "未知公司" : job.companyName);
+    jobMap["company"] = QVariant(job.companyName.isEmpty() ? "未知公司" : job.companyName);  // 保留兼容性
+    jobMap["cityId"] = QVariant::fromValue(job.cityId);
+    jobMap["cityName"] = QVariant(job.cityName.isEmpty() ? "未知地点" : job.cityName);
+    jobMap["location"] = QVariant(job.cityName.isEmpty() ? "未知地点" : job.cityName);  // 保留兼容性
+    jobMap["recruitTypeId"] = QVariant::fromValue(job.recruitTypeId);
+    jobMap["recruitTypeName"] = QVariant(job.recruitTypeName);
+    jobMap["recruitType"] = QVariant(job.recruitTypeName);  // 保留兼容性
     
-    // 将数据转换为QMap格式
-    for (const SQLNS::JobInfoPrint& job : jobs) {
-        QMap<QString, QVariant> jobMap;
-        
-        // 基本信息 - 确保所有数据库字段都被包含
-        jobMap["jobId"] = QVariant::fromValue(job.jobId);
-        jobMap["jobName"] = QVariant(job.jobName);
-        jobMap["title"] = QVariant(job.jobName);  // 保留兼容性
-        jobMap["companyId"] = QVariant::fromValue(job.companyId);
-        jobMap["companyName"] = QVariant(job.companyName.isEmpty() ? "未知公司" : job.companyName);
-        jobMap["company"] = QVariant(job.companyName.isEmpty() ? "未知公司" : job.companyName);  // 保留兼容性
-        jobMap["cityId"] = QVariant::fromValue(job.cityId);
-        jobMap["cityName"] = QVariant(job.cityName.isEmpty() ? "未知地点" : job.cityName);
-        jobMap["location"] = QVariant(job.cityName.isEmpty() ? "未知地点" : job.cityName);  // 保留兼容性
-        jobMap["recruitTypeId"] = QVariant::fromValue(job.recruitTypeId);
-        jobMap["recruitTypeName"] = QVariant(job.recruitTypeName);
-        jobMap["recruitType"] = QVariant(job.recruitTypeName);  // 保留兼容性
-        
-        // 薪资信息
-        jobMap["salaryMin"] = QVariant::fromValue(job.salaryMin);
-        jobMap["salaryMax"] = QVariant::fromValue(job.salaryMax);
-        jobMap["salarySlabId"] = QVariant::fromValue(job.salarySlabId);
-        
-        QString salaryStr;
-        if (job.salaryMin > 0 && job.salaryMax > 0) {
-            salaryStr = QString("%1-%2元").arg(job.salaryMin).arg(job.salaryMax);
-        } else if (job.salaryMin > 0) {
-            salaryStr = QString("最低%1元").arg(job.salaryMin);
-        } else if (job.salaryMax > 0) {
-            salaryStr = QString("最高%1元").arg(job.salaryMax);
-        } else {
-            salaryStr = "薪资面议";
-        }
-        jobMap["salary"] = QVariant(salaryStr);
-        
-        // 职位描述
-        jobMap["description"] = QVariant(job.requirements);
-        jobMap["requirements"] = QVariant(job.requirements);  // 保留兼容性
-        
-        // 时间信息
-        jobMap["createTime"] = QVariant(job.createTime);
-        jobMap["updateTime"] = QVariant(job.updateTime);
-        
-        // 来源
-        jobMap["source"] = QVariant(job.sourceName);
-        
-        // 标签
-        QString tagList;
-        if (!job.tagNames.isEmpty()) {
-            tagList = job.tagNames.join(", ");
-        }
-        jobMap["tags"] = QVariant(tagList);
-        
-        // 创建时间和更新时间
-        jobMap["createTime"] = QVariant(job.createTime);
-        jobMap["updateTime"] = QVariant(job.updateTime);
-        
-        result.append(jobMap);
+    // 薪资信息
+    jobMap["salaryMin"] = QVariant::fromValue(job.salaryMin);
+    jobMap["salaryMax"] = QVariant::fromValue(job.salaryMax);
+    jobMap["salarySlabId"] = QVariant::fromValue(job.salarySlabId);
+    
+    QString salaryStr;
+    if (job.salaryMin > 0 && job.salaryMax > 0) {
+        salaryStr = QString("%1-%2元").arg(job.salaryMin).arg(job.salaryMax);
+    } else if (job.salaryMin > 0) {
+        salaryStr = QString("最低%1元").arg(job.salaryMin);
+    } else if (job.salaryMax > 0) {
+        salaryStr = QString("最高%1元").arg(job.salaryMax);
+    } else {
+        salaryStr = "薪资面议";
     }
+    jobMap["salary"] = QVariant(salaryStr);
     
-    return result;
+    // 职位描述
+    jobMap["description"] = QVariant(job.requirements);
+    jobMap["requirements"] = QVariant(job.requirements);  // 保留兼容性
+    
+    // 时间信息
+    jobMap["createTime"] = QVariant(job.createTime);
+    jobMap["updateTime"] = QVariant(job.updateTime);
+    
+    // 来源
+    jobMap["source"] = QVariant(job.sourceName);
+    
+    // 标签
+    QString tagList;
+    if (!job.tagNames.isEmpty()) {
+        tagList = job.tagNames.join(", ");
+    }
+    jobMap["tags"] = QVariant(tagList);
+    
+    // 创建时间和更新时间
+    jobMap["createTime"] = QVariant(job.createTime);
+    jobMap["updateTime"] = QVariant(job.updateTime);
+
+    return jobMap;
 }
 
 QVector<QMap<QString, QVariant>> AITransferTask::formatJobDataForSingleProcessing(const QVector<QMap<QString, QVariant>>& jobData)
@@ -392,44 +422,53 @@ QVector<QMap<QString, QVariant>> AITransferTask::formatJobDataForSingleProcessin
     QVector<QMap<QString, QVariant>> result;
 
     for (const auto& job : jobData) {
-        QMap<QString, QVariant> formattedJob;
-        
-        // 生成jobId（使用jobId作为标识）
-        QString jobId = QString::number(job.value("jobId").toLongLong());
-        if (jobId.isEmpty()) {
-            jobId = "未知职位";
-        }
-        
-        // 创建info字段，包含所有相关信息
-        QString info;
-        info += "【职位标题】: " + job.value("title").toString() + "\n";
-        info += "【公司名称】: " + job.value("company").toString() + "\n";
-        info += "【工作地点】: " + job.value("location").toString() + "\n";
-        info += "【招聘类型】: " + job.value("recruitType").toString() + "\n";
-        info += "【薪资待遇】: " + job.value("salary").toString() + "\n";
-        info += "【数据来源】: " + job.value("source").toString() + "\n";
-        info += "【职位标签】: " + job.value("tags").toString() + "\n";
-        info += "【职位描述和要求】: " + job.value("description").toString() + "\n";
-        info += "【发布时间】: " + job.value("createTime").toString() + "\n";
-        info += "【最后更新时间】: " + job.value("updateTime").toString() + "\n";
-        info += "【数据提取时间】: " + QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss");
-        
-        // 设置为单个数据处理格式
-        formattedJob["jobId"] = QVariant(jobId);
-        formattedJob["info"] = QVariant(info);
-        
-        result.append(formattedJob);
+        result.append(formatJobForSingleProcessing(job));
     }
 
     return result;
 }
 
-void AITransferTask::startSingleDataProcessingLoop(const QVector<QMap<QString, QVariant>>& formattedData)
+QMap<QString, QVariant> AITransferTask::formatJobForSingleProcessing(const QMap<QString, QVariant>& job)
+{
+    QMap<QString, QVariant> formattedJob;
+    
+    // 生成jobId（使用jobId作为标识）
+    QString jobId = QString::number(job.value("jobId").toLongLong());
+    if (jobId.isEmpty()) {
+        jobId = "未知职位";
+    }
+    
+    // 创建info字段，包含所有相关信息
+    QString info;
+    info += "【职位标题】: " + job.value("title").toString() + "\n";
+    info += "【公司名称】: " + job.value("company").toString() + "\n";
+    info += "【工作地点】: " + job.value("location").toString() + "\n";
+    info += "【招聘类型】: " + job.value("recruitType").toString() + "\n";
+    info += "【薪资待遇】: " + job.value("salary").toString() + "\n";
+    info += "【数据来源】: " + job.value("source").toString() + "\n";
+    info += "【职位标签】: " + job.value("tags").toString() + "\n";
+    info += "【职位描述和要求】: " + job.value("description").toString() + "\n";
+    info += "【发布时间】: " + job.value("createTime").toString() + "\n";
+    info += "【最后更新时间】: " + job.value("updateTime").toString() + "\n";
+    info += "【数据提取时间】: " + QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss");
+    
+    // 设置为单个数据处理格式
+    formattedJob["jobId"] = QVariant(jobId);
+    formattedJob["info"] = QVariant(info);
+
+    return formattedJob;
+}
+
+void AITransferTask::startSingleDataProcessingLoop(int totalItems)
 {
-    // 存储所有数据以供循环处理
-    pendingDataItems = formattedData;
+    // 数据按块读取：pendingDataItems 只保存当前块
+    pendingDataItems.clear();
+    pendingChunkIndex = 0;
+    lastFetchedJobId = 0;
+    hasFetchedJobs = false;
+    jobSourceExhausted = false;
     currentDataIndex = 0;
-    totalDataItems = formattedData.size();
+    totalDataItems = totalItems;
     successCount = 0;
     skippedCount = 0;
     errorCount = 0;
@@ -483,8 +522,18 @@ void AITransferTask::processNextDataItem()
         return;
     }
 
-    // 获取当前要处理的数据项
-    const QMap<QString, QVariant>& currentDataItem = pendingDataItems[currentDataIndex];
+    // 获取当前要处理的数据项：当前块用完时从数据库读取下一块
+    if (pendingChunkIndex >= pendingDataItems.size()) {
+        pendingDataItems = formatJobDataForSingleProcessing(fetchNextJobChunk());
+        pendingChunkIndex = 0;
+        if (pendingDataItems.isEmpty()) {
+            // 数据库实际条数少于统计值（期间被删除等），按已处理数量收尾
+            totalDataItems = currentDataIndex;
+            processNextDataItem();
+            return;
+        }
+    }
+    const QMap<QString, QVariant> currentDataItem = pendingDataItems[pendingChunkIndex++];
     QString jobId = currentDataItem.value("jobId").toString();
     QString info = currentDataItem.value("info").toString();
 
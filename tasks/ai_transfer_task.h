@@ -26,6 +26,7 @@
 #include <QCoreApplication>
 #include <QDebug>
 #include <QJsonObject>
+#include "constants/db_types.h"
 
 /**
  * @brief AITransferTask - AI数据传输任务
@@ -89,6 +90,9 @@ public:
     // This is a convenience for callers that run in worker threads and
     // need the vectorization request to be performed immediately.
     // Returns true if the backend responded with success.
+    // Thread-safe: the network manager, reply and event loop are locals created in
+    // the calling thread and no shared state is touched, so crawler lanes may call it
+    // concurrently (each request blocks only its own lane, at most 15 s).
     static bool sendSingleJobBlocking(const QJsonObject &jobObj, const QString &serverUrl = QStringLiteral("http://localhost:8000"));
 
 signals:
@@ -146,10 +150,17 @@ private:
     void disconnectFromDatabase();
 
     /**
-     * @brief 从数据库获取职位数据
-     * @return 职位数据向量
+     * @brief 从数据库读取下一批职位（按 jobId keyset 分块，内存占用与库大小无关）
+     * @return 本批职位数据（已读完时为空）
      */
-    QVector<QMap<QString, QVariant>> fetchJobDataFromDatabase();
+    QVector<QMap<QString, QVariant>> fetchNextJobChunk();
+
+    /**
+     * @brief 将单条职位转换为 QMap 格式
+     * @param job 职位数据
+     * @return 职位字段映射
+     */
+    static QMap<QString, QVariant> jobToDataMap(const SQLNS::JobInfoPrint& job);
 
     /**
      * @brief 格式化职位数据为API要求的JSON格式（批量处理）
@@ -166,10 +177,17 @@ private:
     QVector<QMap<QString, QVariant>> formatJobDataForSingleProcessing(const QVector<QMap<QString, QVariant>>& jobData);
 
     /**
-     * @brief 开始单个数据处理循环
-     * @param formattedData 格式化后的数据
+     * @brief 格式化单条职位数据为单个处理格式
+     * @param job 原始职位数据
+     * @return 格式化后的数据项（jobId + info）
+     */
+    QMap<QString, QVariant> formatJobForSingleProcessing(const QMap<QString, QVariant>& job);
+
+    /**
+     * @brief 开始单个数据处理循环（数据按块从数据库流式读取）
+     * @param totalItems 待处理总数
      */
-    void startSingleDataProcessingLoop(const QVector<QMap<QString, QVariant>>& formattedData);
+    void startSingleDataProcessingLoop(int totalItems);
 
     /**
      * @brief 处理下一个数据项
@@ -223,7 +241,12 @@ private:
     bool operationCancelled;                                     /**< 操作取消标志 */
 
     // 逐个数据处理相关变量
-    QVector<QMap<QString, QVariant>> pendingDataItems;          /**< 待处理的数据项 */
+    QVector<QMap<QString, QVariant>> pendingDataItems;          /**< 当前块中待处理的数据项（最多 kJobChunkSize 条） */
+    int pendingChunkIndex;                                       /**< 当前块内的处理索引 */
+    long long lastFetchedJobId;                                  /**< 已读取的最后一个 jobId（keyset 游标） */
+    bool hasFetchedJobs;                                         /**< 是否已读取过至少一块（决定 keyset 游标是否生效） */
+    bool jobSourceExhausted;                                     /**< 数据库是否已读完 */
+    static constexpr int kJobChunkSize = 64;                     /**< 每次从数据库读取的条数 */
     int currentDataIndex;                                        /**< 当前处理的索引 */
     int totalDataItems;                                          /**< 总数据项数 */
     int successCount;                                            /**< 成功处理计数 */
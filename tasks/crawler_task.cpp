@@ -11,11 +11,43 @@
 #include <QJsonObject>
 #include "config/config_manager.h"
 #include "maintenance/email_alert.h"
+#include <chrono>
+
+namespace {
+
+// 需要主线程会话浏览器逐页抓取的来源，同一时刻只能有一个来源使用：
+// - wuyi 的翻页靠页内 clickNext，会话状态就是当前页面，整个来源期间独占浏览器
+// - liepin 每页按 URL 重新导航，只在每次抓取期间占用
+bool needsSessionBrowser(const std::string& src) {
+    return src == "wuyi" || src == "liepin";
+}
+
+// 单条车道的请求节流：相邻两次列表请求的开始时间至少间隔 interval（处理入库的耗时计入间隔）
+class RequestPacer {
+public:
+    explicit RequestPacer(std::chrono::milliseconds interval) : m_interval(interval) {}
+
+    void wait(const std::atomic<bool>& terminated) {
+        if (m_started) {
+            const auto ready = m_last + m_interval;
+            // 分段睡眠，终止时及时返回
+            while (!terminated && std::chrono::steady_clock::now() < ready) QThread::msleep(100);
+        }
+        m_started = true;
+        m_last = std::chrono::steady_clock::now();
+    }
+
+private:
+    std::chrono::milliseconds m_interval;
+    std::chrono::steady_clock::time_point m_last;
+    bool m_started = false;
+};
+
+} // namespace
 
 
 CrawlerTask::CrawlerTask(SQLInterface *sqlInterface, WebView2BrowserWRL *sessionBrowser)
         : m_sqlInterface(sqlInterface),
-            m_internetTask(),
             m_sqlTask(sqlInterface),
             m_isPaused(false),
             m_isTerminated(false),
@@ -55,148 +87,253 @@ void CrawlerTask::setSourceProgressCallback(std::function<void(size_t, double)>
     m_sourceProgressCallback = callback;
 }
 
+// 各车道线程都会上报进度：回调串行调用
+void CrawlerTask::reportProgress(int current, int total, const std::string& message) {
+    std::lock_guard<std::mutex> lock(m_callbackMutex);
+    if (m_progressCallback) m_progressCallback(current, total, message);
+}
+
+void CrawlerTask::reportSubProgress(int currentPage, int expectedPages) {
+    std::lock_guard<std::mutex> lock(m_callbackMutex);
+    if (m_subProgressCallback) m_subProgressCallback(currentPage, expectedPages);
+}
+
+void CrawlerTask::reportSourceProgress(size_t sourceIndex, double fraction) {
+    std::lock_guard<std::mutex> lock(m_callbackMutex);
+    if (m_sourceProgressCallback) m_sourceProgressCallback(sourceIndex, fraction);
+}
+
 int CrawlerTask::crawlAll(const std::vector<std::string>& sources, const std::vector<int>& maxPagesPerSourceList, int pageSize) {
     qDebug() << "[CrawlerTask] crawlAll 启动，sources size=" << sources.size() << " maxPagesPerSourceList size=" << maxPagesPerSourceList.size() << " pageSize=" << pageSize;
 
-    int totalStored = 0;
+    CrawlRun run;
+    run.sourceCount = sources.size();
+    run.pageSize = pageSize;
     // Read configuration flag to decide whether to call the vectorization endpoint.
-    bool doVectorize = ConfigManager::getSaveAndVectorize(true);
+    run.doVectorize = ConfigManager::getSaveAndVectorize(true);
+    // 增量模式：已知且列表字段未变的职位不再入库，连续 knownPagesToStop 页全部已知时提前结束
+    // （zhipin 的城市、nowcode 的招聘类型各自计数）
+    run.incremental = ConfigManager::getIncrementalCrawl(false);
+    run.knownPagesToStop = ConfigManager::getKnownPagesToStop(2);
     // per-source statistics
-    std::vector<int> storedPerSource(sources.size(), 0);
-    std::vector<int> pagesFetchedPerSource(sources.size(), 0);
+    run.storedPerSource.assign(sources.size(), 0);
+    run.knownPerSource.assign(sources.size(), 0);
+    run.pagesFetchedPerSource.assign(sources.size(), 0);
     m_isPaused = false;
     m_isTerminated = false;
 
-    // 控制是否在页间暂停，以及哪些来源需要暂停（可按需修改）
-    std::vector<std::string> pauseSources = { "zhipin", "liepin", "wuyi" };
+    // 车道划分：各来源访问不同站点、限流互相独立，每个来源一条车道并发爬取；
+    // 依赖同一个会话浏览器的来源（wuyi/liepin）按原顺序共用一条车道
+    std::vector<std::vector<size_t>> lanes;
+    std::vector<size_t> browserLane;
     for (size_t sourceIndex = 0; sourceIndex < sources.size(); ++sourceIndex) {
-        if (m_isTerminated) break;
-        const auto& src = sources[sourceIndex];
-        if (m_progressCallback) {
-            m_progressCallback(sourceIndex, sources.size(), "开始处理来源: " + src);
-        }
-        qDebug() << "[CrawlerTask] 开始来源:" << src.c_str();
-        // 对于需要浏览器会话的来源（zhipin/liepin/wuyi），不要在子线程直接调用 updateCookieBySource（会创建 QWidget）
-        if (src != "zhipin" && src != "wuyi" && src != "liepin") {
-            m_internetTask.updateCookieBySource(src);
+        if (needsSessionBrowser(sources[sourceIndex])) browserLane.push_back(sourceIndex);
+        else lanes.push_back({sourceIndex});
+    }
+    if (!browserLane.empty()) lanes.push_back(browserLane);
+
+    std::vector<QThread*> threads;
+    for (const auto &lane : lanes) {
+        QThread *thread = QThread::create([this, &run, &sources, &maxPagesPerSourceList, lane]() {
+            // 每条车道各自的 InternetTask（重试 / 挂起页记录互不影响）；数据库连接按线程打开
+            InternetTask internetTask;
+            for (size_t sourceIndex : lane) {
+                if (m_isTerminated) break;
+                // compute per-source max pages (0 means no limit)
+                int perSourceMax = 0;
+                if (sourceIndex < maxPagesPerSourceList.size()) perSourceMax = maxPagesPerSourceList[sourceIndex];
+                // 会话浏览器由 crawlSource 按次（每页 / 每次刷新）加锁，不在整个来源期间持有
+                crawlSource(run, sourceIndex, sources[sourceIndex], perSourceMax, internetTask);
+            }
+        });
+        thread->start();
+        threads.push_back(thread);
+    }
+    for (QThread *thread : threads) {
+        thread->wait();
+        delete thread;
+    }
+
+    int totalStored = 0;
+    for (int stored : run.storedPerSource) totalStored += stored;
+    // After all sources finished, send a summary message listing per-source pages and stored counts and overall total
+    {
+        std::ostringstream ss;
+        ss << "爬取完成，来源统计：\n";
+        for (size_t i = 0; i < sources.size(); ++i) {
+            ss << "- " << sources[i] << ": 爬取 " << run.pagesFetchedPerSource[i] << " 页，存储 " << run.storedPerSource[i] << " 条";
+            if (run.incremental) ss << "，跳过已知 " << run.knownPerSource[i] << " 条";
+            ss << "\n";
         }
+        ss << "总计存储: " << totalStored << " 条";
+        // also log summary to debug
+        qDebug() << "[CrawlerTask] Summary:\n" << QString::fromStdString(ss.str());
+        reportProgress(static_cast<int>(sources.size()), static_cast<int>(sources.size()), ss.str());
+    }
+    qDebug() << "[CrawlerTask] crawlAll 完成，总计存储:" << totalStored;
+    return totalStored;
+}
 
-        // sourceId mapping is provided by constants/network_types.h
+void CrawlerTask::crawlSource(CrawlRun& run, size_t sourceIndex, const std::string& src, int perSourceMax, InternetTask& internetTask) {
+    if (m_isTerminated) return;
+    reportProgress(static_cast<int>(sourceIndex), static_cast<int>(run.sourceCount), "开始处理来源: " + src);
+    qDebug() << "[CrawlerTask] 开始来源:" << src.c_str();
+    // 对于需要浏览器会话的来源（zhipin/liepin/wuyi），不要在子线程直接调用 updateCookieBySource（会创建 QWidget）
+    if (src != "zhipin" && src != "wuyi" && src != "liepin") {
+        internetTask.updateCookieBySource(src);
+    }
 
-        // compute per-source max pages (0 means no limit)
-        int perSourceMax = 0;
-        if (sourceIndex < maxPagesPerSourceList.size()) perSourceMax = maxPagesPerSourceList[sourceIndex];
+    // sourceId mapping is provided by constants/network_types.h
+    int sourceId = 0;
+    auto sourceIt = SOURCE_ID_MAP.find(src);
+    if (sourceIt != SOURCE_ID_MAP.end()) sourceId = sourceIt->second;
+
+    // 已知职位集合在来源开始时整体读入；isKnown 为空表示非增量（或读取失败），照常全量爬取
+    KnownJobIndex knownJobs;
+    KnownJobFilter isKnown;
+    if (run.incremental && sourceId > 0 && m_sqlTask.loadKnownJobs(sourceId, knownJobs)) {
+        isKnown = [&knownJobs](int64_t jobId, uint64_t fingerprint) { return knownJobs.contains(jobId, fingerprint); };
+        qDebug() << "[CrawlerTask] 增量模式，来源" << src.c_str() << "已知职位" << knownJobs.size() << "条";
+    }
+    int consecutiveKnownPages = 0;
+
+    // 本车道自己的请求节流：需要浏览器会话 / 有反爬的来源相邻两次列表请求至少间隔 3 秒
+    const bool paced = (src == "zhipin" || src == "liepin" || src == "wuyi");
+    RequestPacer pacer(std::chrono::milliseconds(paced ? 3000 : 0));
+
+    // wuyi 从会话初始化起到最后一页抓取都持有浏览器锁：init / clickNext 与随后的捕获之间
+    // 若被其它车道（zhipin 刷新 cookie）导航走，页内翻页状态即丢失
+    std::unique_lock<std::mutex> sessionLock(m_browserMutex, std::defer_lock);
+    if (src == "wuyi" && m_sessionBrowser) sessionLock.lock();
+
+    // For session-based sources like wuyi, 使用主线程创建的 m_sessionBrowser
+    if (src == "wuyi" && m_sessionBrowser) {
+        QMetaObject::invokeMethod(m_sessionBrowser, "enableRequestCapture", Qt::QueuedConnection, Q_ARG(bool, true));
+        // Navigate to the list page to initialize session (city may be empty)
+        QString initUrl = QLatin1String("https://we.51job.com/pc/search");
+        QMetaObject::invokeMethod(m_sessionBrowser, "fetchCookies", Qt::QueuedConnection, Q_ARG(QString, initUrl));
+        // give the page a moment to initialize before the first capture
+        QThread::sleep(1);
+    }
 
-        // For session-based sources like wuyi, 使用主线程创建的 m_sessionBrowser
-        if (src == "wuyi" && m_sessionBrowser) {
-            QMetaObject::invokeMethod(m_sessionBrowser, "enableRequestCapture", Qt::QueuedConnection, Q_ARG(bool, true));
-            // Navigate to the list page to initialize session (city may be empty)
-            QString initUrl = QLatin1String("https://we.51job.com/pc/search");
-            QMetaObject::invokeMethod(m_sessionBrowser, "fetchCookies", Qt::QueuedConnection, Q_ARG(QString, initUrl));
-            // give the page a moment to initialize before the first capture
-            QThread::sleep(1);
-        }
+    // 若为 nowcode，则初始化 recruitType 列表（1-3）并使用索引切换
+    size_t recruitIndex = 0;
+    int currentRecruitType = 1;
+    if (src == "nowcode") {
+        recruitIndex = 0;
+        currentRecruitType = static_cast<int>(recruitIndex) + 1; // 1,2,3
+    }
 
-        // 若为 nowcode，则初始化 recruitType 列表（1-3）并使用索引切换
-        size_t recruitIndex = 0;
-        int currentRecruitType = 1;
-        if (src == "nowcode") {
-            recruitIndex = 0;
-            currentRecruitType = static_cast<int>(recruitIndex) + 1; // 1,2,3
-        }
+    // 若为 zhipin，则初始化当前城市为列表首项（可为空）
+    size_t cityIndex = 0;
+    std::string currentCity = "";
+    if (src == "zhipin" && !ZHIPIN_CITY_LIST.empty()) currentCity = ZHIPIN_CITY_LIST[0];
 
-        // 若为 zhipin，则初始化当前城市为列表首项（可为空）
-        size_t cityIndex = 0;
-        std::string currentCity = "";
-        if (src == "zhipin" && !ZHIPIN_CITY_LIST.empty()) currentCity = ZHIPIN_CITY_LIST[0];
 
+    int page = 1;
+    int totalPage = 0;  // 总页数计数，用于zhipin跨城市合计
 
-        int page = 1;
-        int totalPage = 0;  // 总页数计数，用于zhipin跨城市合计
-        int pagesFetchedForSource = 0; // 累计已抓取页数（不随城市重置）
-        int expectedPagesForSource = (perSourceMax > 0) ? perSourceMax : 0;
-        bool isZhipin = (src == "zhipin");
-        std::vector<std::string> seenCities;
-        while (true) {
-            if (m_isTerminated) break;
-            while (m_isPaused) {
-                QThread::sleep(1);  // 等待恢复
-                if (m_isTerminated) break;
-            }
+    // 抓取当前页。liepin 经会话浏览器抓取时只在这一次请求期间持有浏览器锁（每页重新导航），
+    // 其它车道（zhipin 遇反爬码刷新 cookie）最多等待一页；wuyi 已由 sessionLock 持有
+    auto fetchPage = [&]() {
+        if ((src == "wuyi" || src == "liepin") && m_sessionBrowser) {
+            std::unique_lock<std::mutex> browserLock(m_browserMutex, std::defer_lock);
+            if (!sessionLock.owns_lock()) browserLock.lock();
+            return internetTask.fetchBySource(src, page, run.pageSize, m_sessionBrowser, currentRecruitType, currentCity, isKnown);
+        }
+        return internetTask.fetchBySource(src, page, run.pageSize, currentRecruitType, currentCity, isKnown);
+    };
+    int pagesFetchedForSource = 0; // 累计已抓取页数（不随城市重置）
+    int expectedPagesForSource = (perSourceMax > 0) ? perSourceMax : 0;
+    bool isZhipin = (src == "zhipin");
+    std::vector<std::string> seenCities;
+    while (true) {
+        if (m_isTerminated) break;
+        while (m_isPaused) {
+            QThread::sleep(1);  // 等待恢复
             if (m_isTerminated) break;
-            // 达到用户指定的最大页数上限则停止（按来源独立限制）
-            if (perSourceMax > 0 && totalPage >= perSourceMax) {
-                qDebug() << "[CrawlerTask] 达到最大页数上限，停止来源:" << src.c_str();
-                break;
-            }
+        }
+        if (m_isTerminated) break;
+        // 达到用户指定的最大页数上限则停止（按来源独立限制）
+        if (perSourceMax > 0 && totalPage >= perSourceMax) {
+            qDebug() << "[CrawlerTask] 达到最大页数上限，停止来源:" << src.c_str();
+            break;
+        }
 
-            qDebug() << "[CrawlerTask] 来源" << src.c_str() << "城市" << currentCity.c_str()
-                     << "类型" << currentRecruitType << "第" << page << "页开始抓取...";
-            std::pair<std::vector<JobInfo>, MappingData> res;
-            if ((src == "wuyi" || src == "liepin") && m_sessionBrowser) {
-                res = m_internetTask.fetchBySource(src, page, pageSize, m_sessionBrowser, currentRecruitType, currentCity);
+        pacer.wait(m_isTerminated);
+        if (m_isTerminated) break;
+        qDebug() << "[CrawlerTask] 来源" << src.c_str() << "城市" << currentCity.c_str()
+                 << "类型" << currentRecruitType << "第" << page << "页开始抓取...";
+        auto [jobs, mapping] = fetchPage();
+
+        // For sources like zhipin that iterate cities, accumulate expected pages per city
+        if (isZhipin && expectedPagesForSource == 0 && mapping.totalPage > 0) {
+            // only add when seeing a new city
+            bool already = false;
+            for (const auto &c : seenCities) if (c == currentCity) { already = true; break; }
+            if (!already) {
+                expectedPagesForSource += mapping.totalPage;
+                seenCities.push_back(currentCity);
+            }
+        }
+        // decide effective expected pages for reporting
+        int effectiveExpected = (expectedPagesForSource > 0) ? expectedPagesForSource : (perSourceMax > 0 ? perSourceMax : (mapping.totalPage > 0 ? mapping.totalPage : 10));
+
+        // 任意来源遇到反爬码37则发送告警、更新cookie并重试一次
+        if (mapping.last_api_code == 37) {
+            qDebug() << "[CrawlerTask] 检测到 反爬码 37，发送告警并尝试更新 cookie 重试此页...";
+            // Send immediate email alert (best-effort). Maintenance will skip if config missing.
+            QString subj = QString::fromUtf8("反爬码37 - %1").arg(QString::fromStdString(src));
+            QString body = QString::fromUtf8("Detected anti-crawl code 37 on source %1 page %2. jobs=%3 totalPage=%4")
+                    .arg(QString::fromStdString(src)).arg(page).arg(static_cast<int>(jobs.size())).arg(mapping.totalPage);
+            Maintenance::sendEmailAlertAsync(subj, body);
+
+            bool ok = false;
+            // 如果来源需要浏览器会话并且我们有主线程创建的 session browser，则使用它来更新cookie
+            if ((src == "wuyi" || src == "liepin" || src == "zhipin") && m_sessionBrowser) {
+                // wuyi 自身已持有 sessionLock；其它来源等浏览器空闲（wuyi 抓取期间会等到该来源结束）
+                std::unique_lock<std::mutex> browserLock(m_browserMutex, std::defer_lock);
+                if (!sessionLock.owns_lock()) browserLock.lock();
+                ok = internetTask.updateCookieBySource(src, m_sessionBrowser);
             } else {
-                res = m_internetTask.fetchBySource(src, page, pageSize, currentRecruitType, currentCity);
+                ok = internetTask.updateCookieBySource(src);
             }
-            auto [jobs, mapping] = res;
-
-            // For sources like zhipin that iterate cities, accumulate expected pages per city
-            if (isZhipin && expectedPagesForSource == 0 && mapping.totalPage > 0) {
-                // only add when seeing a new city
-                bool already = false;
-                for (const auto &c : seenCities) if (c == currentCity) { already = true; break; }
-                if (!already) {
-                    expectedPagesForSource += mapping.totalPage;
-                    seenCities.push_back(currentCity);
-                }
+            if (ok) {
+                qDebug() << "[CrawlerTask] cookie 更新成功，稍作等待后重试第" << page << "页...";
+                QThread::msleep(2000);
+                std::tie(jobs, mapping) = fetchPage();
+            } else {
+                qDebug() << "[CrawlerTask] cookie 更新失败";
             }
-            // decide effective expected pages for reporting
-            int effectiveExpected = (expectedPagesForSource > 0) ? expectedPagesForSource : (perSourceMax > 0 ? perSourceMax : (mapping.totalPage > 0 ? mapping.totalPage : 10));
-
-            // 任意来源遇到反爬码37则发送告警、更新cookie并重试一次
-            if (mapping.last_api_code == 37) {
-                qDebug() << "[CrawlerTask] 检测到 反爬码 37，发送告警并尝试更新 cookie 重试此页...";
-                // Send immediate email alert (best-effort). Maintenance will skip if config missing.
-                QString subj = QString::fromUtf8("反爬码37 - %1").arg(QString::fromStdString(src));
-                QString body = QString::fromUtf8("Detected anti-crawl code 37 on source %1 page %2. jobs=%3 totalPage=%4")
-                        .arg(QString::fromStdString(src)).arg(page).arg(static_cast<int>(jobs.size())).arg(mapping.totalPage);
-                Maintenance::sendEmailAlertAsync(subj, body);
-
-                bool ok = false;
-                // 如果来源需要浏览器会话并且我们有主线程创建的 session browser，则使用它来更新cookie
-                if ((src == "wuyi" || src == "liepin" || src == "zhipin") && m_sessionBrowser) {
-                    ok = m_internetTask.updateCookieBySource(src, m_sessionBrowser);
+        }
+
+        bool pageSuccess = false;
+        if (!jobs.empty()) {
+            // expected pages: prefer configured per-source max, then mapping.totalPage, else fallback to a reasonable default
+            int expectedPages = (perSourceMax > 0) ? perSourceMax : (mapping.totalPage > 0 ? mapping.totalPage : 10);
+
+            int storedCount = 0;
+            int knownCount = 0;
+            // store jobs one by one to enable fine-grained progress updates
+            for (size_t i = 0; i < jobs.size(); ++i) {
+                const uint64_t fingerprint = job_fingerprint(jobs[i]);
+                if (isKnown && isKnown(jobs[i].info_id, fingerprint)) {
+                    // 已在库中且列表字段未变（详情页可能已被跳过）：不重复入库、不再向量化
+                    knownCount++;
                 } else {
-                    ok = m_internetTask.updateCookieBySource(src);
-                }
-                if (ok) {
-                    qDebug() << "[CrawlerTask] cookie 更新成功，稍作等待后重试第" << page << "页...";
-                    QThread::msleep(2000);
-                    if ((src == "wuyi" || src == "liepin") && m_sessionBrowser) {
-                        std::tie(jobs, mapping) = m_internetTask.fetchBySource(src, page, pageSize, m_sessionBrowser, currentRecruitType, currentCity);
-                    } else {
-                        std::tie(jobs, mapping) = m_internetTask.fetchBySource(src, page, pageSize, currentRecruitType, currentCity);
+                    long long canonical = 0;
+                    long long res = -1;
+                    {
+                        // 各车道共用同一数据库：入库（含近重复分组）逐条串行，避免写锁竞争与分组交错
+                        std::lock_guard<std::mutex> lock(m_storeMutex);
+                        res = m_sqlTask.storeJobDataWithSource(jobs[i], sourceId, &canonical);
                     }
-                } else {
-                    qDebug() << "[CrawlerTask] cookie 更新失败";
-                }
-            }
-
-            bool pageSuccess = false;
-            if (!jobs.empty()) {
-                int sourceId = 0;
-                auto it = SOURCE_ID_MAP.find(src);
-                if (it != SOURCE_ID_MAP.end()) sourceId = it->second;
-
-                // expected pages: prefer configured per-source max, then mapping.totalPage, else fallback to a reasonable default
-                int expectedPages = (perSourceMax > 0) ? perSourceMax : (mapping.totalPage > 0 ? mapping.totalPage : 10);
-
-                int storedCount = 0;
-                // store jobs one by one to enable fine-grained progress updates
-                for (size_t i = 0; i < jobs.size(); ++i) {
-                    int res = m_sqlTask.storeJobDataWithSource(jobs[i], sourceId);
                     if (res >= 0) {
                         storedCount++;
+                        if (isKnown) knownJobs.insert(res, fingerprint);
+                        // Near-duplicate of a job already stored (from this or another source):
+                        // the group's canonical job is the one vectorized, the repost is not sent again
+                        const bool duplicate = canonical > 0 && canonical != static_cast<long long>(jobs[i].info_id);
 
                         // After storing, send this single job to Python backend for vectorization.
                         // Build a compact JSON object similar to AITransferTask::formatJobDataForAPI
@@ -211,121 +348,114 @@ int CrawlerTask::crawlAll(const std::vector<std::string>& sources, const std::ve
                         jobObj["info"] = info;
 
                         // Optionally call blocking sender for vectorization based on config
-                        if (doVectorize) {
+                        // (safe from several lanes at once: each call uses its own network manager / event loop)
+                        if (run.doVectorize && !duplicate) {
                             bool ok = AITransferTask::sendSingleJobBlocking(jobObj);
                             if (!ok) qWarning() << "Vectorization request failed for job" << res;
                         }
                     }
-                    // compute fractional progress: (pagesFetched + fractionWithinPage) / effectiveExpected
-                    double fracWithinPage = (static_cast<double>(i) + 1.0) / static_cast<double>(jobs.size());
-                    double fraction = (static_cast<double>(pagesFetchedForSource) + fracWithinPage) / static_cast<double>(effectiveExpected);
-                    if (fraction > 1.0) fraction = 1.0;
-                    if (m_sourceProgressCallback) m_sourceProgressCallback(sourceIndex, fraction);
-                    // also update sub-progress callback for backward compatibility
-                    if (m_subProgressCallback) {
-                        // report current page being processed (pagesFetchedForSource + 1)
-                        m_subProgressCallback(pagesFetchedForSource + 1, effectiveExpected);
-                    }
-                }
-
-                // finished this page: consider success only when we got parsed jobs or mapping reports OK
-                if (!jobs.empty() || mapping.last_api_code == 0) pageSuccess = true;
-
-                if (pageSuccess) pagesFetchedForSource += 1;
-                totalStored += storedCount;
-                // accumulate per-source stored count
-                storedPerSource[sourceIndex] += storedCount;
-                qDebug() << "[CrawlerTask] 来源" << src.c_str() << "第" << page << "页存储" << storedCount << "条" << " pageSuccess=" << pageSuccess;
-
-                // 进度回调 信息显示使用累计页数而非单城页码
-                if (m_progressCallback) {
-                    int displayPage = pagesFetchedForSource; // show cumulative pages fetched for source
-                    int cumulativeStored = storedPerSource[sourceIndex];
-                    std::string msg = "来源 " + src + " 已抓取 " + std::to_string(displayPage) + " 页，存储 " + std::to_string(storedCount) + " 条，来源累计存储 " + std::to_string(cumulativeStored) + " 条";
-                    m_progressCallback(sourceIndex, sources.size(), msg);
-                }
-                // increment totalPage only on success (controls maxPagesPerSource)
-                if (pageSuccess) {
-                    totalPage += 1;
-                    if (perSourceMax > 0 && totalPage >= perSourceMax) {
-                        qDebug() << "[CrawlerTask] 达到 perSourceMax，停止来源:" << src.c_str();
-                        // mark sub-progress complete
-                        if (m_subProgressCallback) {
-                            int expected = perSourceMax > 0 ? perSourceMax : (mapping.totalPage > 0 ? mapping.totalPage : page);
-                            m_subProgressCallback(expected, expected);
-                        }
-                        break;
-                    }
                 }
-            } else {
-                qDebug() << "[CrawlerTask] 第" << page << "页无数据";
+                // compute fractional progress: (pagesFetched + fractionWithinPage) / effectiveExpected
+                double fracWithinPage = (static_cast<double>(i) + 1.0) / static_cast<double>(jobs.size());
+                double fraction = (static_cast<double>(pagesFetchedForSource) + fracWithinPage) / static_cast<double>(effectiveExpected);
+                if (fraction > 1.0) fraction = 1.0;
+                reportSourceProgress(sourceIndex, fraction);
+                // also update sub-progress callback for backward compatibility
+                // report current page being processed (pagesFetchedForSource + 1)
+                reportSubProgress(pagesFetchedForSource + 1, effectiveExpected);
             }
 
-            // 只有当 doPause 为 true 且当前来源在 pauseSources 列表中时才等待
-            if (std::find(pauseSources.begin(), pauseSources.end(), src) != pauseSources.end()) {
-                QThread::sleep(3);
+            // 每页写入后递增数据代数，读端缓存据此失效
+            if (storedCount > 0) {
+                std::lock_guard<std::mutex> lock(m_storeMutex);
+                m_sqlTask.bumpDataGeneration();
             }
 
-            // For wuyi, trigger the in-page next button after processing this page
-            if (src == "wuyi") {
-                // If has_more is false, do not click next
-                if (mapping.has_more) {
-                    qDebug() << "[CrawlerTask] wuyi: clicking next page button in session browser";
-                    if (m_sessionBrowser) QMetaObject::invokeMethod(m_sessionBrowser, "clickNext", Qt::QueuedConnection);
-                    // small pause to allow page to fire requests
-                    QThread::sleep(1);
-                } else {
-                    qDebug() << "[CrawlerTask] wuyi: no more pages according to mapping.has_more";
-                }
+            // finished this page: consider success only when we got parsed jobs or mapping reports OK
+            if (!jobs.empty() || mapping.last_api_code == 0) pageSuccess = true;
+
+            if (pageSuccess) pagesFetchedForSource += 1;
+            // accumulate per-source stored count
+            run.storedPerSource[sourceIndex] += storedCount;
+            run.knownPerSource[sourceIndex] += knownCount;
+            // 整页都是已知职位才累计，出现新职位 / 变化职位即清零
+            consecutiveKnownPages = (knownCount == static_cast<int>(jobs.size())) ? consecutiveKnownPages + 1 : 0;
+            qDebug() << "[CrawlerTask] 来源" << src.c_str() << "第" << page << "页存储" << storedCount << "条，已知" << knownCount << "条" << " pageSuccess=" << pageSuccess;
+
+            // 进度回调 信息显示使用累计页数而非单城页码
+            {
+                int displayPage = pagesFetchedForSource; // show cumulative pages fetched for source
+                int cumulativeStored = run.storedPerSource[sourceIndex];
+                std::string msg = "来源 " + src + " 已抓取 " + std::to_string(displayPage) + " 页，存储 " + std::to_string(storedCount) + " 条，来源累计存储 " + std::to_string(cumulativeStored) + " 条";
+                reportProgress(static_cast<int>(sourceIndex), static_cast<int>(run.sourceCount), msg);
             }
-
-            // 终止条件统一由 has_more 控制；当 has_more == false 时：
-            // - 若是 zhipin 且还有未遍历的城市，则切换到下一个城市并从 page=1 继续
-            // - 否则结束该来源
-            if (!mapping.has_more) {
-                if (src == "zhipin" && cityIndex + 1 < ZHIPIN_CITY_LIST.size()) {
-                    cityIndex++;
-                    currentCity = ZHIPIN_CITY_LIST[cityIndex];
-                    page = 1;
-                    qDebug() << "[CrawlerTask] 切换到 zhipin 下一个城市:" << currentCity.c_str();
-                    continue;
-                } else if (src == "nowcode" && recruitIndex + 1 < 3) {
-                    // 切换到下一个 recruitType (1->2->3)
-                    recruitIndex++;
-                    currentRecruitType = static_cast<int>(recruitIndex) + 1;
-                    page = 1;
-                    qDebug() << "[CrawlerTask] 切换到 nowcode 下一个 recruitType:" << currentRecruitType;
-                    continue;
-                } else {
-                    qDebug() << "[CrawlerTask] 来源" << src.c_str() << "无更多数据，结束来源抓取";
-                    // If finished before reaching expected pages, mark sub-progress complete
-                    if (m_subProgressCallback) {
-                        int expected = perSourceMax > 0 ? perSourceMax : (mapping.totalPage > 0 ? mapping.totalPage : page);
-                        m_subProgressCallback(expected, expected);
-                    }
+            // increment totalPage only on success (controls maxPagesPerSource)
+            if (pageSuccess) {
+                totalPage += 1;
+                if (perSourceMax > 0 && totalPage >= perSourceMax) {
+                    qDebug() << "[CrawlerTask] 达到 perSourceMax，停止来源:" << src.c_str();
+                    // mark sub-progress complete
+                    int expected = perSourceMax > 0 ? perSourceMax : (mapping.totalPage > 0 ? mapping.totalPage : page);
+                    reportSubProgress(expected, expected);
                     break;
                 }
             }
+        } else {
+            qDebug() << "[CrawlerTask] 第" << page << "页无数据";
+        }
 
-            page++;
+        // 增量模式下连续 knownPagesToStop 页全部已知，视同没有更多数据（更早发布的职位上次已爬过）
+        bool exhausted = !mapping.has_more;
+        if (isKnown && consecutiveKnownPages >= run.knownPagesToStop) {
+            qDebug() << "[CrawlerTask] 来源" << src.c_str() << "连续" << consecutiveKnownPages << "页均为已知职位，提前结束";
+            exhausted = true;
         }
-        // record per-source pages fetched when this source finishes
-        pagesFetchedPerSource[sourceIndex] = pagesFetchedForSource;
-    }
-    // After all sources finished, send a summary message listing per-source pages and stored counts and overall total
-    if (m_progressCallback) {
-        std::ostringstream ss;
-        ss << "爬取完成，来源统计：\n";
-        for (size_t i = 0; i < sources.size(); ++i) {
-            ss << "- " << sources[i] << ": 爬取 " << pagesFetchedPerSource[i] << " 页，存储 " << storedPerSource[i] << " 条\n";
+
+        // For wuyi, trigger the in-page next button after processing this page
+        if (src == "wuyi") {
+            // If has_more is false, do not click next
+            if (!exhausted) {
+                // 仍在 sessionLock 内：点击与下一页的捕获之间浏览器不会被其它车道使用
+                qDebug() << "[CrawlerTask] wuyi: clicking next page button in session browser";
+                if (m_sessionBrowser) QMetaObject::invokeMethod(m_sessionBrowser, "clickNext", Qt::QueuedConnection);
+                // small pause to allow page to fire requests
+                QThread::sleep(1);
+            } else {
+                qDebug() << "[CrawlerTask] wuyi: no more pages according to mapping.has_more";
+            }
         }
-        ss << "总计存储: " << totalStored << " 条";
-        // also log summary to debug
-        qDebug() << "[CrawlerTask] Summary:\n" << QString::fromStdString(ss.str());
-        m_progressCallback(static_cast<int>(sources.size()), static_cast<int>(sources.size()), ss.str());
+
+        // 终止条件统一由 has_more（及增量模式的已知页计数）控制；当 exhausted 时：
+        // - 若是 zhipin 且还有未遍历的城市，则切换到下一个城市并从 page=1 继续
+        // - 否则结束该来源
+        if (exhausted) {
+            consecutiveKnownPages = 0;
+            if (src == "zhipin" && cityIndex + 1 < ZHIPIN_CITY_LIST.size()) {
+                cityIndex++;
+                currentCity = ZHIPIN_CITY_LIST[cityIndex];
+                page = 1;
+                qDebug() << "[CrawlerTask] 切换到 zhipin 下一个城市:" << currentCity.c_str();
+                continue;
+            } else if (src == "nowcode" && recruitIndex + 1 < 3) {
+                // 切换到下一个 recruitType (1->2->3)
+                recruitIndex++;
+                currentRecruitType = static_cast<int>(recruitIndex) + 1;
+                page = 1;
+                qDebug() << "[CrawlerTask] 切换到 nowcode 下一个 recruitType:" << currentRecruitType;
+                continue;
+            } else {
+                qDebug() << "[CrawlerTask] 来源" << src.c_str() << "无更多数据，结束来源抓取";
+                // If finished before reaching expected pages, mark sub-progress complete
+                int expected = perSourceMax > 0 ? perSourceMax : (mapping.totalPage > 0 ? mapping.totalPage : page);
+                reportSubProgress(expected, expected);
+                break;
+            }
+        }
+
+        page++;
     }
-    qDebug() << "[CrawlerTask] crawlAll 完成，总计存储:" << totalStored;
-    return totalStored;
+    // record per-source pages fetched when this source finishes
+    run.pagesFetchedPerSource[sourceIndex] = pagesFetchedForSource;
 }
 
 // 旧签名的包装器：将单个 maxPagesPerSource 拓展为列表并调用新实现
@@ -6,6 +6,7 @@
 #include <vector>
 #include <atomic>
 #include <functional>
+#include <mutex>
 #include <QObject>
 
 class WebView2BrowserWRL;
@@ -14,6 +15,7 @@ class WebView2BrowserWRL;
  * @brief CrawlerTask - 总任务协调器
  * 协调网络爬取(InternetTask)和数据存储(SqlTask)
  * 提供完整的"爬取→存储"一站式服务
+ * 各来源在各自的车道线程中并发爬取（依赖会话浏览器的 wuyi/liepin 共用一条车道），入库串行写入同一数据库
  */
 class CrawlerTask : public QObject {
     Q_OBJECT
@@ -64,7 +66,9 @@ public:
 
     
     /**
-     * @brief 按来源爬取所有数据（两层循环），会调用internet_task.updateCookieBySource并在失败时重试
+     * @brief 按来源爬取所有数据：每个来源一条车道线程按页循环，全部车道结束后返回
+     * 车道各有自己的 InternetTask、请求节流与重试状态；进度回调可能来自不同车道线程（已串行化）
+     * 会调用internet_task.updateCookieBySource并在失败时重试
      * @param sources 要爬取的来源列表
      * @param maxPagesPerSource 每个来源的最大页数上限（避免无限循环），0 表示无限制
      * @param pageSize 每页大小
@@ -74,8 +78,25 @@ public:
     int crawlAll(const std::vector<std::string>& sources, const std::vector<int>& maxPagesPerSourceList, int pageSize = 15);
     
 private:
+    // 一次 crawlAll 的设置与统计；统计按 sourceIndex 分槽，每个来源只由自己的车道写入
+    struct CrawlRun {
+        size_t sourceCount = 0;
+        int pageSize = 15;
+        bool doVectorize = true;
+        bool incremental = false;
+        int knownPagesToStop = 2;
+        std::vector<int> storedPerSource;
+        std::vector<int> knownPerSource;
+        std::vector<int> pagesFetchedPerSource;
+    };
+
+    // 在当前车道线程中按页爬取单个来源（zhipin 遍历城市、nowcode 遍历招聘类型）
+    void crawlSource(CrawlRun& run, size_t sourceIndex, const std::string& src, int perSourceMax, InternetTask& internetTask);
+    void reportProgress(int current, int total, const std::string& message);
+    void reportSubProgress(int currentPage, int expectedPages);
+    void reportSourceProgress(size_t sourceIndex, double fraction);
+
     SQLInterface *m_sqlInterface;
-    InternetTask m_internetTask;
     SqlTask m_sqlTask;
     std::atomic<bool> m_isPaused;
     std::atomic<bool> m_isTerminated;
@@ -83,6 +104,9 @@ private:
     std::function<void(int, int)> m_subProgressCallback;
     std::function<void(size_t, double)> m_sourceProgressCallback;
     WebView2BrowserWRL *m_sessionBrowser; // 非拥有指针，主线程创建
+    std::mutex m_storeMutex;     // 入库与数据代数递增
+    std::mutex m_browserMutex;   // m_sessionBrowser：wuyi 整个来源期间持有；liepin 与 cookie 刷新按次持有
+    std::mutex m_callbackMutex;  // 三个进度回调
 };
 
 #endif // CRAWLER_TASK_H
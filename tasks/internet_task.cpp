@@ -27,7 +27,8 @@ std::pair<std::vector<JobInfo>, MappingData> InternetTask::fetchJobData(int page
 }
 
 std::pair<std::vector<JobInfo>, MappingData> InternetTask::fetchBySource(
-    const std::string& sourceCode, int pageNo, int pageSize, int recruitType, const std::string& city) {
+    const std::string& sourceCode, int pageNo, int pageSize, int recruitType, const std::string& city,
+    const KnownJobFilter& isKnown) {
     
     qDebug() << "[InternetTask] 按来源爬取:" << sourceCode.c_str() << ", 页码:" << pageNo;
     
@@ -39,10 +40,10 @@ std::pair<std::vector<JobInfo>, MappingData> InternetTask::fetchBySource(
         return ZhipinCrawler::crawlZhipin(pageNo, pageSize, useCity);
         } else if (sourceCode == "chinahr") {
             // Chinahr 使用默认 localId=1，可在后续扩展为参数
-            return ChinahrCrawler::crawlChinahr(pageNo, pageSize, "1");
+            return ChinahrCrawler::crawlChinahr(pageNo, pageSize, "1", isKnown);
         } else if (sourceCode == "liepin") {
             // 使用 WebView2 注入脚本捕获 liepin 后台API响应；当前不会做parser，先捕获原始JSON并生成映射建议供人工确认
-            return LiepinCrawler::crawlLiepin(pageNo, pageSize, city);
+            return LiepinCrawler::crawlLiepin(pageNo, pageSize, city, nullptr, isKnown);
         } else if (sourceCode == "wuyi") {
             return WuyiCrawler::crawlWuyi(pageNo, pageSize, city);
     } else {
@@ -53,13 +54,13 @@ std::pair<std::vector<JobInfo>, MappingData> InternetTask::fetchBySource(
 
 std::pair<std::vector<JobInfo>, MappingData> InternetTask::fetchBySource(
     const std::string& sourceCode, int pageNo, int pageSize, WebView2BrowserWRL* browser,
-    int recruitType, const std::string& city) {
+    int recruitType, const std::string& city, const KnownJobFilter& isKnown) {
 
     qDebug() << "[InternetTask] (browser) 按来源爬取:" << sourceCode.c_str() << ", 页码:" << pageNo;
     if (sourceCode == "wuyi") {
         return WuyiCrawler::crawlWuyi(pageNo, pageSize, city, browser);
     } else if (sourceCode == "liepin") {
-        return LiepinCrawler::crawlLiepin(pageNo, pageSize, city, browser);
+        return LiepinCrawler::crawlLiepin(pageNo, pageSize, city, browser, isKnown);
     } else {
         qDebug() << "[InternetTask] (browser) 未实现的带浏览器的来源:" << sourceCode.c_str();
         return {{}, {}};
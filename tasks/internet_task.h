@@ -47,16 +47,17 @@ public:
      * @param pageNo 页码
      * @param pageSize 每页数量
      * @param recruitType 招聘类型（仅对nowcode有效）
+     * @param isKnown 增量爬取的已知职位判定（可为空）；需要逐条抓取详情页的来源（chinahr/liepin）据此跳过已知职位的详情页
      * @return 爬取到的JobInfo列表和映射数据
      */
     std::pair<std::vector<JobInfo>, MappingData> fetchBySource(
         const std::string& sourceCode, int pageNo, int pageSize, int recruitType = DEFAULT_RECRUIT_TYPE,
-        const std::string& city = "");
+        const std::string& city = "", const KnownJobFilter& isKnown = {});
 
     // 同步版本：为需要保持会话的来源（如 wuyi）提供一个能传入外部 WebView2 实例的重载
     std::pair<std::vector<JobInfo>, MappingData> fetchBySource(
         const std::string& sourceCode, int pageNo, int pageSize, WebView2BrowserWRL* browser,
-        int recruitType = DEFAULT_RECRUIT_TYPE, const std::string& city = "");
+        int recruitType = DEFAULT_RECRUIT_TYPE, const std::string& city = "", const KnownJobFilter& isKnown = {});
 
     /**
      * @brief 根据数据源执行Cookie更新（使用WebView2等方式），并将结果写入config.json
@@ -1,64 +1,344 @@
 // tasks/presenter_task.cpp
 #include "presenter_task.h"
 #include <QDebug>
+#include <QDateTime>
 #include <algorithm>
 #include "presenter/presenter.h"
 #include "db/sqlinterface.h" // 引入SQLInterface和queryAllJobs
 
-QVector<SQLNS::JobInfoPrint> PresenterTask::cachedJobs;
+std::shared_ptr<const JobStore> PresenterTask::cachedStore;
+std::shared_ptr<const NgramIndex> PresenterTask::searchIndex;
+std::shared_ptr<const Bm25Index> PresenterTask::rankIndex;
+qint64 PresenterTask::storeGeneration = -1;
+QList<PresenterTask::CachedQuery> PresenterTask::queryCache;
+QMutex PresenterTask::stateMutex;
+QMutex PresenterTask::rebuildMutex;
+std::atomic<bool> PresenterTask::buildRunning{false};
+std::atomic<int> PresenterTask::buildLoaded{0};
+std::atomic<int> PresenterTask::buildTotal{0};
+std::atomic<bool> PresenterTask::snapshotReady{false};
+
+TaskNS::BuildProgress PresenterTask::buildProgress() {
+    TaskNS::BuildProgress progress;
+    progress.running = buildRunning.load();
+    progress.ready = snapshotReady.load();
+    progress.loaded = buildLoaded.load();
+    progress.total = buildTotal.load();
+    return progress;
+}
+
+std::shared_ptr<RequirementsStore> PresenterTask::requirementsStore() {
+    static const std::shared_ptr<RequirementsStore> store = std::make_shared<RequirementsStore>(Presenter::DEFAULT_DB_PATH);
+    return store;
+}
+
+QString PresenterTask::jobRequirements(long long jobId) {
+    return requirementsStore()->requirements(jobId);
+}
+
+// 索引签名：不含岗位要求的可检索字段 + updateTime（职位被重新爬取时 updateTime 变化）
+static quint64 indexSignature(const SQLNS::JobInfoPrint &job) {
+    return NgramIndex::signature(NgramIndex::searchableFields(job) << job.updateTime);
+}
+
+// 为待索引职位批量取回岗位要求后写入 n-gram 索引与 BM25 索引（sqlInterface 为空时只索引其余字段）
+void PresenterTask::indexPendingJobs(SQLInterface* sqlInterface, QVector<SQLNS::JobInfoPrint>& pending,
+                                     NgramIndex& ngram, Bm25Index& ranker) {
+    if (pending.isEmpty()) return;
+    QHash<long long, QString> texts;
+    if (sqlInterface) {
+        QVector<long long> ids;
+        ids.reserve(pending.size());
+        for (const auto &job : pending) ids.append(job.jobId);
+        texts = sqlInterface->queryRequirements(ids);
+    }
+    for (auto &job : pending) {
+        const quint64 sig = indexSignature(job);
+        auto text = texts.constFind(job.jobId);
+        if (text != texts.constEnd()) job.requirements = text.value();
+        ngram.addJob(job.jobId, NgramIndex::searchableFields(job), sig);
+        ranker.addJob(job.jobId, Bm25Index::fieldTexts(job), sig);
+    }
+    pending.clear();
+}
+
+// 搜索索引与列式存储对齐：作废已删除的职位，作废过多时两份索引一起重建（岗位要求只取一次），有改动才落盘
+void PresenterTask::syncSearchIndex(SQLInterface* sqlInterface, const JobStore& store, const QSet<long long>& liveJobIds,
+                                    NgramIndex& ngram, Bm25Index& ranker) {
+    ngram.retainOnly(liveJobIds);
+    ranker.retainOnly(liveJobIds);
+    if (ngram.needsCompaction() || ranker.needsCompaction()) {
+        ngram.clear();
+        ranker.clear();
+        QVector<SQLNS::JobInfoPrint> pending;
+        for (int r = 0; r < store.size(); ++r) {
+            pending.append(store.row(r));
+            if (pending.size() >= kIndexBatch) indexPendingJobs(sqlInterface, pending, ngram, ranker);
+        }
+        indexPendingJobs(sqlInterface, pending, ngram, ranker);
+        qDebug() << "Search indexes compacted, documents:" << ngram.documentCount() << ranker.documentCount();
+    }
+    if (ngram.isDirty()) {
+        ngram.save(NgramIndex::pathForDatabase(Presenter::DEFAULT_DB_PATH));
+    }
+    if (ranker.isDirty()) {
+        ranker.save(Bm25Index::pathForDatabase(Presenter::DEFAULT_DB_PATH));
+    }
+}
+
+// 查询缓存键：规范化查询串（去首尾空白、大小写折叠）+ 字段筛选（字段内取值排序去重）+ 排序列与方向
+// “N 天内”筛选的结果随当前时间变化：取值后附上解析出的截止 epoch（按天截断），跨天后不再命中旧结果
+QString PresenterTask::queryCacheKey(const QString& query,
+                                     const QMap<QString, QVector<QString>>& fieldFilters,
+                                     const QString& sortField,
+                                     bool asc) {
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+    QStringList parts;
+    parts << query.trimmed().toCaseFolded();
+    for (auto it = fieldFilters.constBegin(); it != fieldFilters.constEnd(); ++it) {
+        if (it.value().isEmpty()) continue;
+        QStringList vals(it.value().begin(), it.value().end());
+        if (SQLNS::isRecencyField(it.key())) {
+            for (QString &v : vals) {
+                qint64 cutoff = 0;
+                if (SQLNS::recencyCutoff(v, now, &cutoff)) v += QLatin1Char('@') + QString::number(cutoff / 86400);
+            }
+        }
+        vals.sort();
+        vals.removeDuplicates();
+        parts << it.key() + QLatin1Char('=') + vals.join(QChar(0x1F));
+    }
+    if (sortField.isEmpty()) {
+        parts << QStringLiteral("unsorted");
+    } else {
+        parts << QString::number(static_cast<int>(JobStore::sortColumn(sortField))) + (asc ? "+" : "-");
+    }
+    return parts.join(QChar(0x1E));
+}
+
+// 快照过期时重建。构建在 stateMutex 之外进行，其间其他查询照常使用旧快照，完成后在锁内整体替换；
+// 同一时刻只有一个重建：已有快照时不等待正在进行的重建（沿用旧快照），没有快照时等它完成
+void PresenterTask::refreshSnapshot(SQLInterface* sqlInterface, qint64 generation, bool refresh) {
+    auto isStale = [generation, refresh]() {
+        return !cachedStore || cachedStore->size() == 0
+               || (generation >= 0 ? generation != storeGeneration : refresh);
+    };
+    bool hasSnapshot = false;
+    {
+        QMutexLocker locker(&stateMutex);
+        if (!isStale()) {
+            qDebug() << "Using cached data, store size:" << cachedStore->size() << "generation:" << generation;
+            return;
+        }
+        hasSnapshot = cachedStore && cachedStore->size() > 0;
+    }
+    if (hasSnapshot) {
+        if (!rebuildMutex.tryLock()) {
+            qDebug() << "Snapshot rebuild in progress, using the previous snapshot";
+            return;
+        }
+    } else {
+        rebuildMutex.lock();
+    }
+    {
+        // 排队期间可能已由另一个查询重建完成
+        QMutexLocker locker(&stateMutex);
+        if (cachedStore && cachedStore->size() > 0 && (generation >= 0 ? generation == storeGeneration : !refresh)) {
+            rebuildMutex.unlock();
+            return;
+        }
+    }
+    rebuildStore(sqlInterface, generation);
+    rebuildMutex.unlock();
+}
+
+// 从数据库重建列式快照，并增量更新搜索索引（n-gram / BM25）与排序索引（持有 rebuildMutex，不持有 stateMutex）
+void PresenterTask::rebuildStore(SQLInterface* sqlInterface, qint64 generation) {
+    auto fresh = std::make_shared<JobStore>();
+    // 在当前索引的副本上增量更新（容器隐式共享，复制本身是 O(1)），查询继续读取已发布的索引；
+    // 搜索索引首次从磁盘加载，之后每次只为新增 / 内容变化的职位补索引
+    std::shared_ptr<NgramIndex> ngram;
+    std::shared_ptr<Bm25Index> ranker;
+    {
+        QMutexLocker locker(&stateMutex);
+        if (searchIndex) ngram = std::make_shared<NgramIndex>(*searchIndex);
+        if (rankIndex) ranker = std::make_shared<Bm25Index>(*rankIndex);
+    }
+    if (!ngram) {
+        ngram = std::make_shared<NgramIndex>();
+        ngram->load(NgramIndex::pathForDatabase(Presenter::DEFAULT_DB_PATH));
+    }
+    if (!ranker) {
+        // 词表在此处（而非查询线程中）解析，已发布的索引不再写入任何成员
+        ranker = std::make_shared<Bm25Index>(&Segmenter::shared());
+        ranker->load(Bm25Index::pathForDatabase(Presenter::DEFAULT_DB_PATH));
+    }
+    QSet<long long> liveJobIds;
+    // 列表读取不带岗位要求；只有新增 / 变化的职位才批量取回岗位要求建索引
+    QVector<SQLNS::JobInfoPrint> pending;
+    auto ingest = [&fresh, &liveJobIds, &pending, &ngram, &ranker, sqlInterface](const SQLNS::JobInfoPrint &job) {
+        fresh->append(job);
+        const quint64 sig = indexSignature(job);
+        if (!ngram->isCurrent(job.jobId, sig) || !ranker->isCurrent(job.jobId, sig)) {
+            pending.append(job);
+            if (pending.size() >= kIndexBatch) indexPendingJobs(sqlInterface, pending, *ngram, *ranker);
+        }
+        liveJobIds.insert(job.jobId);
+        buildLoaded.store(fresh->size(), std::memory_order_relaxed);
+    };
+    buildLoaded.store(0);
+    buildTotal.store(0);
+    buildRunning.store(true);
+    if (sqlInterface) {
+        const int total = sqlInterface->countJobs();
+        buildTotal.store(qMax(total, 0));
+        fresh->reserve(total);
+        const bool complete = sqlInterface->forEachJobPrint([&ingest](const SQLNS::JobInfoPrint &job) {
+            ingest(job);
+            return true;
+        }, false);
+        if (!complete) qDebug() << "Job cursor stopped on an error, snapshot is incomplete";
+        qDebug() << "Connected to DB, store size:" << fresh->size();
+    } else {
+        for (const auto &job : Presenter::getAllJobs(1, INT_MAX)) ingest(job);
+        qDebug() << "Failed to connect DB, fallback store size:" << fresh->size();
+    }
+    indexPendingJobs(sqlInterface, pending, *ngram, *ranker);
+    syncSearchIndex(sqlInterface, *fresh, liveJobIds, *ngram, *ranker);
+    fresh->buildSortIndex();
+    fresh->buildRangeIndex();
+    fresh->setRequirementsSource(requirementsStore());
+
+    QMutexLocker locker(&stateMutex);
+    cachedStore = fresh;
+    searchIndex = ngram;
+    rankIndex = ranker;
+    storeGeneration = generation;
+    snapshotReady.store(true);
+    buildRunning.store(false);
+    // 旧快照上的查询结果全部失效
+    queryCache.clear();
+}
 
 // 单一入口：分页 + 搜索 + 字段映射筛选 + 排序
+// 各阶段只在同一份只读快照的行号选择向量上进行，不复制职位；最后仅物化当前页
+// 同一 (数据代数, 查询, 筛选, 排序) 的结果从 LRU 缓存取出，翻页只需物化当前页
 TaskNS::PagingResult PresenterTask::queryJobsWithPaging(const QString& query,
                                                         const QMap<QString, QVector<QString>>& fieldFilters,
                                                         const QString& sortField,
                                                         bool asc,
                                                         int page,
                                                         int pageSize,
-                                                        bool refresh) {
+                                                        bool refresh,
+                                                        const std::function<bool()>& isCancelled) {
     qDebug() << "queryJobsWithPaging called with query:" << query << "fieldFilters:" << fieldFilters << "sortField:" << sortField << "asc:" << asc << "page:" << page << "pageSize:" << pageSize;
     TaskNS::PagingResult result;
+    if (page < 1) page = 1;
+    if (pageSize < 1) pageSize = 20;
     result.currentPage = page;
     result.pageSize = pageSize;
 
-    // 步骤1：连接数据库并获取解析后的全量数据
-    QVector<SQLNS::JobInfoPrint> jobList1;
-    if (refresh || cachedJobs.isEmpty()) {
-        SQLInterface sqlInterface;
-        if (sqlInterface.connectSqlite(Presenter::DEFAULT_DB_PATH)) {
-            jobList1 = sqlInterface.queryAllJobsPrint();
-            sqlInterface.disconnect();
-            qDebug() << "Connected to DB, jobList1 size:" << jobList1.size();
+    // 步骤1：读取数据代数，数据有变化（或代数不可用且要求刷新）时重建列式快照（不持有 stateMutex）
+    // 连接保持到搜索结束：n-gram 索引不可用时 searchRows 在同一连接上查询 FTS
+    SQLInterface sqlInterface;
+    const bool connected = sqlInterface.connectSqlite(Presenter::DEFAULT_DB_PATH);
+    refreshSnapshot(connected ? &sqlInterface : nullptr, connected ? sqlInterface.dataGeneration() : -1, refresh);
+
+    QMutexLocker locker(&stateMutex);
+    auto cancelled = [&isCancelled, &result]() {
+        if (!isCancelled || !isCancelled()) return false;
+        qDebug() << "queryJobsWithPaging cancelled";
+        result.cancelled = true;
+        return true;
+    };
+    if (cancelled()) return result;
+
+    // 本次查询固定使用当前快照（之后的刷新不影响已返回的视图）
+    const std::shared_ptr<const JobStore> snapshot = cachedStore;
+    const JobStore &store = *snapshot;
+    const std::shared_ptr<const NgramIndex> ngram = searchIndex;
+    const std::shared_ptr<const Bm25Index> ranker = rankIndex;
+
+    // 步骤2：查询缓存
+    const QString cacheKey = queryCacheKey(query, fieldFilters, sortField, asc);
+    auto cached = std::find_if(queryCache.begin(), queryCache.end(), [&cacheKey](const CachedQuery &entry) {
+        return entry.generation == storeGeneration && entry.key == cacheKey;
+    });
+    if (cached != queryCache.end()) {
+        // 命中：移到最前（最近使用）
+        std::rotate(queryCache.begin(), cached, cached + 1);
+        result.view = queryCache.first().view;
+        result.facetCounts = queryCache.first().facetCounts;
+        qDebug() << "Query cache hit, rows:" << result.view.size();
+    } else {
+        // 步骤3：单字符串搜索 + 按字段映射筛选
+        // 无搜索词时直接由分面位图给出结果，不必先展开全部行号
+        const QString trimmedQuery = query.trimmed();
+        QVector<int> rows;
+        if (trimmedQuery.isEmpty()) {
+            rows = store.filter(fieldFilters);
+            result.facetCounts = store.facetCounts(nullptr, fieldFilters);
         } else {
-            jobList1 = Presenter::getAllJobs(0, INT_MAX);
-            qDebug() << "Failed to connect DB, fallback jobList1 size:" << jobList1.size();
+            const QVector<int> hits = Presenter::searchRows(store, trimmedQuery, ngram.get(), ranker.get(),
+                                                            connected ? &sqlInterface : nullptr);
+            qDebug() << "After search, rows:" << hits.size();
+            if (cancelled()) return result;
+            rows = store.filter(hits, fieldFilters);
+            result.facetCounts = store.facetCounts(&hits, fieldFilters);
         }
-        cachedJobs = jobList1;
-    } else {
-        jobList1 = cachedJobs;
-        qDebug() << "Using cached data, jobList1 size:" << jobList1.size();
-    }
+        qDebug() << "After filter, rows:" << rows.size();
+        if (cancelled()) return result;
 
-    // 步骤2：单字符串搜索
-    QVector<SQLNS::JobInfoPrint> jobList2 = Presenter::searchJobs(jobList1, query);
-    qDebug() << "After search, jobList2 size:" << jobList2.size();
-
-    // 步骤3：按字段映射筛选
-    QVector<SQLNS::JobInfoPrint> jobList3 = Presenter::searchJobs(jobList2, fieldFilters);
-    qDebug() << "After filter, jobList3 size:" << jobList3.size();
+        // 步骤4：排序（若提供 sortField），只保证排到当前页末尾（top-k），其余由视图按需接续
+        int ordered = -1;
+        if (!sortField.isEmpty()) {
+            const qint64 pageEnd = static_cast<qint64>(page) * pageSize;
+            ordered = store.sort(rows, sortField, asc, static_cast<int>(qMin<qint64>(pageEnd, rows.size())));
+        }
+        result.view = JobSelection(snapshot, std::move(rows), ordered, sortField, asc);
 
-    // 步骤4：排序（若提供 sortField）
-    QVector<SQLNS::JobInfoPrint> jobList4 = jobList3;
-    if (!sortField.isEmpty()) {
-        jobList4 = Presenter::sortJobs(jobList3, sortField, asc);
-        qDebug() << "After sort, jobList4 size:" << jobList4.size();
+        queryCache.prepend(CachedQuery{storeGeneration, cacheKey, result.view, result.facetCounts});
+        while (queryCache.size() > kQueryCacheCapacity) queryCache.removeLast();
     }
 
-    // 步骤5：分页并返回
-    result.allData = jobList4;
-    result.totalPage = (result.allData.size() + pageSize - 1) / pageSize;
-    result.pageData = Presenter::paging(result.allData, page, pageSize);
-    qDebug() << "Final: allData size:" << result.allData.size() << "pageData size:" << result.pageData.size() << "totalPage:" << result.totalPage;
+    if (connected) sqlInterface.disconnect();
+
+    // 步骤5：分页，只物化当前页
+    result.totalCount = result.view.size();
+    result.totalPage = static_cast<int>((static_cast<qint64>(result.totalCount) + pageSize - 1) / pageSize);
+    result.pageData = result.view.materialize(static_cast<int>(qMin<qint64>(static_cast<qint64>(page - 1) * pageSize, result.totalCount)), pageSize);
+    qDebug() << "Final: totalCount:" << result.totalCount << "pageData size:" << result.pageData.size() << "totalPage:" << result.totalPage;
 
     return result;
 }
 
+// keyset 分页：筛选/搜索/排序在 SQL 中完成，首页耗时与表大小无关
+SQLNS::JobPage PresenterTask::queryJobsPage(const QString& query,
+                                            const QMap<QString, QVector<QString>>& fieldFilters,
+                                            const QString& sortField,
+                                            bool asc,
+                                            int pageSize,
+                                            const SQLNS::JobPage& cursor,
+                                            bool withTotal) {
+    SQLNS::JobPageQuery pageQuery;
+    pageQuery.query = query;
+    pageQuery.fieldFilters = fieldFilters;
+    pageQuery.sortField = sortField;
+    pageQuery.asc = asc;
+    pageQuery.pageSize = pageSize;
+    pageQuery.hasCursor = !cursor.rows.isEmpty();
+    pageQuery.afterSortKey = cursor.lastSortKey;
+    pageQuery.afterJobId = cursor.lastJobId;
+    // 翻页时总数沿用首页结果，避免每页重新 COUNT
+    pageQuery.withTotal = withTotal && !pageQuery.hasCursor;
+
+    SQLNS::JobPage page;
+    SQLInterface sqlInterface;
+    if (sqlInterface.connectSqlite(Presenter::DEFAULT_DB_PATH)) {
+        page = sqlInterface.queryJobsPage(pageQuery);
+        sqlInterface.disconnect();
+    }
+    if (pageQuery.hasCursor) page.totalCount = cursor.totalCount;
+    qDebug() << "queryJobsPage: rows" << page.rows.size() << "total" << page.totalCount << "hasMore" << page.hasMore;
+    return page;
+}
@@ -3,16 +3,37 @@
 #define PRESENTER_TASK_H
 
 #include "presenter/presenter.h"
+#include "presenter/job_store.h"
+#include "presenter/ngram_index.h"
+#include "presenter/bm25_index.h"
+#include "presenter/requirements_store.h"
 #include <QVector>
+#include <QSet>
+#include <QList>
+#include <QStringList>
+#include <QMutex>
+#include <functional>
+#include <atomic>
 
 // 声明分页结果结构体（存在.h里）
 namespace TaskNS {
 struct PagingResult {
-    QVector<SQLNS::JobInfoPrint> pageData;   // 分页后数据
-    QVector<SQLNS::JobInfoPrint> allData;    // 原始全量数据
-    int totalPage;                      // 总页数
+    JobSelection view;                       // 搜索+筛选+排序后的全部命中（行号视图，不复制职位）
+    QVector<SQLNS::JobInfoPrint> pageData;   // 分页后数据（只有当前页物化为 JobInfoPrint）
+    int totalCount = 0;                      // 搜索+筛选后的命中总数（= view.size()）
+    JobStore::FacetCounts facetCounts;       // 各筛选字段的取值 -> 命中数（按当前选择计数，见 JobStore::facetCounts）
+    int totalPage = 0;                  // 总页数
     int currentPage;                    // 当前页
     int pageSize;                       // 每页条数
+    bool cancelled = false;             // 被更新的查询取代而提前放弃（此时其余字段无意义）
+};
+
+// 列式快照的构建进度
+struct BuildProgress {
+    bool running = false;   // 正在从数据库构建快照与索引
+    bool ready = false;     // 已有可用快照
+    int loaded = 0;         // 已读入的职位数
+    int total = 0;          // 预计总数（未知时为 0）
 };
 }
 
@@ -27,17 +48,83 @@ public:
     // - asc: 是否升序
     // - page: 当前页（从1开始）
     // - pageSize: 每页大小
-    // - refresh: 是否重新从数据库读取数据
+    // - refresh: 是否检查并重新读取数据库；数据库提供数据代数时，只有代数变化才重建快照，
+    //   且代数变化时即使 refresh=false 也会自动重建
+    // - isCancelled: 可选，在各阶段之间检查；返回 true 时放弃本次查询（result.cancelled = true，不写入缓存）。
+    //   快照重建不会被中断（重建结果对后续查询仍有效）
+    // 线程安全：可在任意线程调用，同一时刻只有一个查询在执行搜索 / 筛选 / 排序；
+    //   快照重建在锁外进行，重建期间其他查询继续使用旧快照（尚无快照时等待重建完成）
     static TaskNS::PagingResult queryJobsWithPaging(const QString& query,
                                                     const QMap<QString, QVector<QString>>& fieldFilters,
                                                     const QString& sortField,
                                                     bool asc,
                                                     int page,
                                                     int pageSize,
-                                                    bool refresh = true);
+                                                    bool refresh = true,
+                                                    const std::function<bool()>& isCancelled = {});
+
+    // 下推到 SQL 的 keyset 分页：只读取当前页（+总数），不加载全量数据
+    // - cursor: 上一页返回的 JobPage（首页传空 JobPage 即可）
+    // - withTotal: 首页是否统计总数；为 false 时 totalCount = -1，耗时与表大小无关（启动时的首屏预览用）
+    // 注意：按 jobName 排序时 SQL 按码点比较，与 queryJobsWithPaging（QCollator 中文排序）的顺序不同
+    static SQLNS::JobPage queryJobsPage(const QString& query,
+                                        const QMap<QString, QVector<QString>>& fieldFilters,
+                                        const QString& sortField,
+                                        bool asc,
+                                        int pageSize,
+                                        const SQLNS::JobPage& cursor = SQLNS::JobPage(),
+                                        bool withTotal = true);
+
+    // 岗位要求按需读取（列表查询与快照均不含该列）；最近查看的条目缓存在小型 LRU 中
+    static QString jobRequirements(long long jobId);
+
+    // 快照构建进度（可在任意线程读取，不等待正在执行的查询）
+    static TaskNS::BuildProgress buildProgress();
 
 private:
-    static QVector<SQLNS::JobInfoPrint> cachedJobs;
+    // 查询结果缓存项：同一数据代数下的有序选择视图
+    struct CachedQuery {
+        qint64 generation;
+        QString key;
+        JobSelection view;
+        JobStore::FacetCounts facetCounts;
+    };
+    static constexpr int kQueryCacheCapacity = 16;
+
+    static QString queryCacheKey(const QString& query,
+                                 const QMap<QString, QVector<QString>>& fieldFilters,
+                                 const QString& sortField,
+                                 bool asc);
+    // 快照过期时（不持有 stateMutex）重建并在锁内替换；sqlInterface 为空时回退为 Presenter::getAllJobs
+    static void refreshSnapshot(SQLInterface* sqlInterface, qint64 generation, bool refresh);
+    static void rebuildStore(SQLInterface* sqlInterface, qint64 generation);
+    static void syncSearchIndex(SQLInterface* sqlInterface, const JobStore& store, const QSet<long long>& liveJobIds,
+                                NgramIndex& ngram, Bm25Index& ranker);
+    // 批量取回 pending 的岗位要求并写入 n-gram 索引与 BM25 索引，之后清空 pending
+    static void indexPendingJobs(SQLInterface* sqlInterface, QVector<SQLNS::JobInfoPrint>& pending,
+                                 NgramIndex& ngram, Bm25Index& ranker);
+    static std::shared_ptr<RequirementsStore> requirementsStore();
+    static constexpr int kIndexBatch = 500;
+
+    // 列式缓存快照（只读；refresh 时从数据库流式构建新快照后整体替换）
+    static std::shared_ptr<const JobStore> cachedStore;
+    // 自由文本搜索的 n-gram 索引（持久化于数据库旁；重建时在副本上增量更新后整体替换，首次为空指针）
+    static std::shared_ptr<const NgramIndex> searchIndex;
+    // 搜索结果的相关度排序索引（分词 + BM25，与 n-gram 索引同步增量更新、同时替换）
+    static std::shared_ptr<const Bm25Index> rankIndex;
+    // 当前快照对应的数据代数（-1 表示数据库未提供代数）
+    static qint64 storeGeneration;
+    // LRU：最近使用在前，快照重建时清空
+    static QList<CachedQuery> queryCache;
+    // 保护以上静态状态（快照与索引的替换、查询缓存）；快照构建期间不持有
+    static QMutex stateMutex;
+    // 串行化快照重建（重建期间已有快照的查询不等待）
+    static QMutex rebuildMutex;
+    // 构建进度（原子量，不受 stateMutex 保护）
+    static std::atomic<bool> buildRunning;
+    static std::atomic<int> buildLoaded;
+    static std::atomic<int> buildTotal;
+    static std::atomic<bool> snapshotReady;
 };
 
 #endif // PRESENTER_TASK_H
\ No newline at end of file
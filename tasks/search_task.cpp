@@ -0,0 +1,58 @@
+// tasks/search_task.cpp
+#include "search_task.h"
+#include <QDebug>
+#include <QMetaObject>
+
+SearchTask::SearchTask(QObject *parent)
+    : QObject(parent), m_latest(std::make_shared<std::atomic<quint64>>(0)) {
+    // PresenterTask 内部串行执行查询，多开线程只会排队；保留线程以复用其数据库连接
+    m_pool.setMaxThreadCount(1);
+    m_pool.setExpiryTimeout(-1);
+}
+
+SearchTask::~SearchTask() {
+    cancelAll();
+    m_pool.waitForDone();
+}
+
+quint64 SearchTask::submit(const SearchRequest &request) {
+    // 序号推进后，排队中的旧查询开始时即放弃，执行中的旧查询在下一个阶段检查点放弃
+    const quint64 ticket = m_latest->fetch_add(1) + 1;
+    emit searchStarted(ticket);
+
+    std::shared_ptr<std::atomic<quint64>> latest = m_latest;
+    ++m_running;
+    m_pool.start([this, request, ticket, latest]() {
+        auto isCancelled = [&latest, ticket]() { return latest->load() != ticket; };
+        TaskNS::PagingResult result;
+        if (!isCancelled()) {
+            result = PresenterTask::queryJobsWithPaging(request.query, request.fieldFilters, request.sortField,
+                                                        request.asc, request.page, request.pageSize,
+                                                        request.refresh, isCancelled);
+        } else {
+            result.cancelled = true;
+        }
+        // 结果回到 GUI 线程再判断是否仍是最新（期间可能又有新提交）
+        QMetaObject::invokeMethod(this, [this, ticket, result]() {
+            --m_running;
+            if (result.cancelled || ticket != m_latest->load()) {
+                qDebug() << "SearchTask: dropping stale result" << ticket;
+                return;
+            }
+            emit searchFinished(ticket, result);
+        }, Qt::QueuedConnection);
+    });
+    return ticket;
+}
+
+void SearchTask::submitFirstPage(const SearchRequest &request) {
+    m_pool.start([this, request]() {
+        const SQLNS::JobPage page = PresenterTask::queryJobsPage(request.query, request.fieldFilters, request.sortField,
+                                                                 request.asc, request.pageSize, SQLNS::JobPage(), false);
+        QMetaObject::invokeMethod(this, [this, page]() { emit firstPageReady(page.rows); }, Qt::QueuedConnection);
+    });
+}
+
+void SearchTask::cancelAll() {
+    m_latest->fetch_add(1);
+}
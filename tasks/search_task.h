@@ -0,0 +1,56 @@
+// tasks/search_task.h
+#ifndef SEARCH_TASK_H
+#define SEARCH_TASK_H
+
+#include <QObject>
+#include <QThreadPool>
+#include <QString>
+#include <QMap>
+#include <QVector>
+#include <atomic>
+#include <memory>
+#include "tasks/presenter_task.h"
+
+// 查询参数（与 PresenterTask::queryJobsWithPaging 一一对应）
+struct SearchRequest {
+    QString query;
+    QMap<QString, QVector<QString>> fieldFilters;
+    QString sortField;
+    bool asc = true;
+    int page = 1;
+    int pageSize = 20;
+    bool refresh = false;
+};
+
+// 异步查询：在后台线程池执行 PresenterTask::queryJobsWithPaging，结果经排队调用回到本对象所在线程（GUI 线程）
+// - 每次 submit 分配递增序号；更新的提交会取消尚未完成的旧查询（排队中的直接跳过，执行中的在阶段之间放弃）
+// - 只有最新序号的结果会通过 searchFinished 发出，界面始终显示最近一次完成的查询
+class SearchTask : public QObject {
+    Q_OBJECT
+
+public:
+    explicit SearchTask(QObject *parent = nullptr);
+    ~SearchTask();
+
+    // 提交查询，返回其序号
+    quint64 submit(const SearchRequest &request);
+    // 首屏预览：只用带 LIMIT 的 SQL 取第一页（不统计总数、不构建快照），耗时与表大小无关
+    // 在之后 submit 的完整查询之前执行；不参与序号取消，由调用方决定是否仍需显示
+    void submitFirstPage(const SearchRequest &request);
+    // 取消所有未完成的查询
+    void cancelAll();
+    bool isBusy() const { return m_running.load() > 0; }
+
+signals:
+    void searchStarted(quint64 ticket);
+    void searchFinished(quint64 ticket, const TaskNS::PagingResult &result);
+    void firstPageReady(const QVector<SQLNS::JobInfoPrint> &rows);
+
+private:
+    QThreadPool m_pool;
+    // 最新提交的序号（与工作线程共享；序号不等于它的查询视为已取消）
+    std::shared_ptr<std::atomic<quint64>> m_latest;
+    std::atomic<int> m_running{0};
+};
+
+#endif // SEARCH_TASK_H
@@ -5,9 +5,17 @@
 SqlTask::SqlTask(SQLInterface *sqlInterface)
     : m_sqlInterface(sqlInterface) {}
 
+namespace {
+// 职位当前的标签集合：优先按名称插入得到的 tagId，否则为原始 tag_ids
+QVector<int> currentTagIds(const QVector<int>& insertedTagIds, const ::JobInfo& crawledJob) {
+    if (!insertedTagIds.isEmpty()) return insertedTagIds;
+    return QVector<int>(crawledJob.tag_ids.begin(), crawledJob.tag_ids.end());
+}
+}
+
 // ========== 桥梁方法实现 ==========
 
-int SqlTask::storeJobData(const ::JobInfo& crawledJob) {
+long long SqlTask::storeJobData(const ::JobInfo& crawledJob, long long *canonicalJobId) {
     if (!m_sqlInterface) {
         qDebug() << "Error: SQLInterface is null";
         return -1;
@@ -16,6 +24,9 @@ int SqlTask::storeJobData(const ::JobInfo& crawledJob) {
     // 1. 转换数据类型
     SQLNS::JobInfo sqlJob = convertJobInfo(crawledJob);
     
+    // 1.5 旧版 std::hash ID 的行先改写为稳定 ID，之后 insertJob 的 upsert 才能命中并更新已有行
+    remapLegacyIds(crawledJob);
+
     // 2. 依赖数据：严格使用JSON中的ID，不生成占位名称
     // 注意：若需要公司/城市/标签名称，应在爬虫阶段解析并传入，当前仅依赖ID。
     
@@ -58,34 +69,35 @@ int SqlTask::storeJobData(const ::JobInfo& crawledJob) {
              << ", slabId=" << sqlJob.salarySlabId
              << ", createTime=" << sqlJob.createTime
              << ", updateTime=" << sqlJob.updateTime;
-    int insertRes = m_sqlInterface->insertJob(sqlJob);
+    long long insertRes = m_sqlInterface->insertJob(sqlJob);
     if (insertRes < 0) {
         qDebug() << "Failed to insert job:" << crawledJob.info_id << "; DB connected:" << m_sqlInterface->isConnected();
         // Try to (re)create tables in case schema missing, then retry once
         if (m_sqlInterface->isConnected()) {
             qDebug() << "Attempting to create tables and retry insert...";
             m_sqlInterface->createAllTables();
-            int retry = m_sqlInterface->insertJob(sqlJob);
-            if (retry >= 0) return retry;
-            qDebug() << "Retry insert failed for job:" << crawledJob.info_id;
+            insertRes = m_sqlInterface->insertJob(sqlJob);
+            if (insertRes < 0) qDebug() << "Retry insert failed for job:" << crawledJob.info_id;
         }
-        return -1;
+        // 行未写入：不建关联、不写指纹，下次爬取仍视为新职位 / 变化职位
+        if (insertRes < 0) return -1;
     }
     long long jobId = sqlJob.jobId; // use full 64-bit id for subsequent mappings
     
     // 4. 建立JobTagMapping关联
-    // 优先使用通过名称增量插入得到的tagId；若为空则回退使用原始tag_ids
-    if (!insertedTagIds.isEmpty()) {
-        for (int tagId : insertedTagIds) {
-            insertJobTagMapping(jobId, tagId);
-        }
-    } else {
-        for (int tagId : crawledJob.tag_ids) {
-            insertJobTagMapping(jobId, tagId);
-        }
-    }
+    // 优先使用通过名称增量插入得到的tagId；若为空则回退使用原始tag_ids。
+    // 已有职位重新入库时按当前标签集合替换（标签属于指纹，旧标签必须移除）
+    const bool tagsOk = m_sqlInterface->replaceJobTags(jobId, currentTagIds(insertedTagIds, crawledJob));
+
+    // 5. 近重复分组（失败只记录，不影响入库结果）
+    const long long canonical = m_sqlInterface->groupNearDuplicate(jobId);
+    if (canonicalJobId) *canonicalJobId = canonical;
+
+    // 6. 行与标签都写入成功后才记录列表字段指纹（已有行由 insertJob 的 upsert 一并更新），供增量爬取的已知职位判定；
+    //    标签替换失败则不记指纹，下次爬取仍视为变化职位并重写
+    if (tagsOk) m_sqlInterface->updateJobFingerprint(jobId, job_fingerprint(crawledJob));
     
-    return static_cast<int>(jobId);
+    return jobId;
 }
 
 int SqlTask::storeJobDataBatch(const std::vector<::JobInfo>& crawledJobs) {
@@ -95,10 +107,11 @@ int SqlTask::storeJobDataBatch(const std::vector<::JobInfo>& crawledJobs) {
             successCount++;
         }
     }
+    if (successCount > 0) bumpDataGeneration();
     return successCount;
 }
 
-int SqlTask::storeJobDataWithSource(const ::JobInfo& crawledJob, int sourceId) {
+long long SqlTask::storeJobDataWithSource(const ::JobInfo& crawledJob, int sourceId, long long *canonicalJobId) {
     if (!m_sqlInterface) {
         qDebug() << "Error: SQLInterface is null";
         return -1;
@@ -108,6 +121,8 @@ int SqlTask::storeJobDataWithSource(const ::JobInfo& crawledJob, int sourceId) {
     SQLNS::JobInfo sqlJob = convertJobInfo(crawledJob);
     sqlJob.sourceId = sourceId; // 设置sourceId
     
+    remapLegacyIds(crawledJob);
+
     // 2. 依赖数据处理（与storeJobData相同）
     if (crawledJob.company_id > 0 && !crawledJob.company_name.empty()) {
         insertCompany(crawledJob.company_id, stdStringToQString(crawledJob.company_name));
@@ -136,32 +151,32 @@ int SqlTask::storeJobDataWithSource(const ::JobInfo& crawledJob, int sourceId) {
     qDebug() << "[SqlTask] Insert Job with sourceId=" << sourceId
              << ", jobId=" << static_cast<qlonglong>(sqlJob.jobId)
              << ", jobName=" << sqlJob.jobName;
-    int insertRes = m_sqlInterface->insertJob(sqlJob);
+    long long insertRes = m_sqlInterface->insertJob(sqlJob);
     if (insertRes < 0) {
         qDebug() << "Failed to insert job:" << crawledJob.info_id << "; DB connected:" << m_sqlInterface->isConnected();
         if (m_sqlInterface->isConnected()) {
             qDebug() << "Attempting to create tables and retry insert...";
             m_sqlInterface->createAllTables();
-            int retry = m_sqlInterface->insertJob(sqlJob);
-            if (retry >= 0) return retry;
-            qDebug() << "Retry insert failed for job:" << crawledJob.info_id;
+            insertRes = m_sqlInterface->insertJob(sqlJob);
+            if (insertRes < 0) qDebug() << "Retry insert failed for job:" << crawledJob.info_id;
         }
-        return -1;
+        // 行未写入：不建关联、不写指纹，下次爬取仍视为新职位 / 变化职位
+        if (insertRes < 0) return -1;
     }
     long long jobId = sqlJob.jobId;
     
-    // 4. 建立JobTagMapping关联
-    if (!insertedTagIds.isEmpty()) {
-        for (int tagId : insertedTagIds) {
-            insertJobTagMapping(jobId, tagId);
-        }
-    } else {
-        for (int tagId : crawledJob.tag_ids) {
-            insertJobTagMapping(jobId, tagId);
-        }
-    }
+    // 4. 建立JobTagMapping关联（按当前标签集合替换，同 storeJobData）
+    const bool tagsOk = m_sqlInterface->replaceJobTags(jobId, currentTagIds(insertedTagIds, crawledJob));
+
+    // 5. 近重复分组（失败只记录，不影响入库结果）
+    const long long canonical = m_sqlInterface->groupNearDuplicate(jobId);
+    if (canonicalJobId) *canonicalJobId = canonical;
+
+    // 6. 行与标签都写入成功后才记录列表字段指纹（已有行由 insertJob 的 upsert 一并更新），供增量爬取的已知职位判定；
+    //    标签替换失败则不记指纹，下次爬取仍视为变化职位并重写
+    if (tagsOk) m_sqlInterface->updateJobFingerprint(jobId, job_fingerprint(crawledJob));
     
-    return static_cast<int>(jobId);
+    return jobId;
 }
 
 int SqlTask::storeJobDataBatchWithSource(const std::vector<::JobInfo>& crawledJobs, int sourceId) {
@@ -171,9 +186,38 @@ int SqlTask::storeJobDataBatchWithSource(const std::vector<::JobInfo>& crawledJo
             successCount++;
         }
     }
+    if (successCount > 0) bumpDataGeneration();
     return successCount;
 }
 
+bool SqlTask::loadKnownJobs(int sourceId, KnownJobIndex &index) {
+    if (!m_sqlInterface) return false;
+    bool ok = false;
+    const QVector<QPair<long long, quint64>> rows = m_sqlInterface->queryJobFingerprints(sourceId, &ok);
+    if (!ok) return false;
+    std::vector<std::pair<int64_t, uint64_t>> entries;
+    entries.reserve(rows.size());
+    for (const auto &row : rows) entries.emplace_back(row.first, row.second);
+    index.assign(std::move(entries));
+    return true;
+}
+
+bool SqlTask::bumpDataGeneration() {
+    if (!m_sqlInterface) return false;
+    // 先补建本批职位的二元组索引（失败只记录：待建职位仍由搜索的 LIKE 兜底）
+    if (m_sqlInterface->indexPendingBigrams() < 0) qDebug() << "Bigram indexing failed; pending jobs stay on LIKE";
+    return m_sqlInterface->bumpDataGeneration();
+}
+
+void SqlTask::remapLegacyIds(const ::JobInfo& crawledJob) {
+    if (crawledJob.legacy_company_id != 0 && crawledJob.company_id > 0) {
+        m_sqlInterface->remapLegacyCompanyId(crawledJob.legacy_company_id, crawledJob.company_id);
+    }
+    if (crawledJob.legacy_info_id != 0 && crawledJob.info_id > 0) {
+        m_sqlInterface->remapLegacyJobId(crawledJob.legacy_info_id, crawledJob.info_id);
+    }
+}
+
 // ========== 内部转换方法实现 ==========
 
 SQLNS::JobInfo SqlTask::convertJobInfo(const ::JobInfo& crawledJob) {
@@ -236,10 +280,10 @@ int SqlTask::calculateSalarySlabId(double salaryMin, double salaryMax, int recru
 
 // === 一般ID部分 (需要传入ID) ===
 
-int SqlTask::insertJob(int jobId, const QString &jobName, int companyId, int recruitTypeId,
-                       int cityId, const QString &requirements, double salaryMin, double salaryMax,
-                       int salarySlabId, const QString &createTime, const QString &updateTime,
-                       const QString &hrLastLoginTime) {
+long long SqlTask::insertJob(long long jobId, const QString &jobName, long long companyId, int recruitTypeId,
+                             int cityId, const QString &requirements, double salaryMin, double salaryMax,
+                             int salarySlabId, const QString &createTime, const QString &updateTime,
+                             const QString &hrLastLoginTime) {
     if (!m_sqlInterface) return -1;
     
     SQLNS::JobInfo job;
@@ -259,7 +303,7 @@ int SqlTask::insertJob(int jobId, const QString &jobName, int companyId, int rec
     return m_sqlInterface->insertJob(job);
 }
 
-int SqlTask::insertCompany(int companyId, const QString &companyName) {
+long long SqlTask::insertCompany(long long companyId, const QString &companyName) {
     if (!m_sqlInterface) return -1;
     
     // Company表需要手动指定companyId (一般ID)
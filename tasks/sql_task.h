@@ -5,6 +5,7 @@
 #include <QVector>
 #include "db/sqlinterface.h"
 #include "network/job_crawler.h"
+#include "network/known_job_index.h"
 
 /**
  * @brief SqlTask桥梁类
@@ -23,12 +24,16 @@ public:
      * 1. 类型转换 (::JobInfo → SQLNS::JobInfo)
      * 2. 依赖数据存储 (Company, City, Tags)
      * 3. 主数据存储 (Job)
-     * 4. 关联数据存储 (JobTagMapping)
+     * 4. 关联数据存储 (JobTagMapping，按当前标签集合替换)
+     * 5. 近重复分组 (SQLInterface::groupNearDuplicate)
+     * 6. 记录列表字段指纹 (job_fingerprint → Job.fingerprint)
+     * 入库前先把该职位 / 公司的旧版 std::hash ID（若仍在库中）改写为稳定 ID
      * 
      * @param crawledJob 爬虫获取的Job数据
+     * @param canonicalJobId 可选输出：所属近重复组的规范职位ID（自身为规范职位时即 jobId，分组失败为 -1）
      * @return 成功返回jobId，失败返回-1
      */
-    int storeJobData(const ::JobInfo& crawledJob);
+    long long storeJobData(const ::JobInfo& crawledJob, long long *canonicalJobId = nullptr);
     
     /**
      * @brief 批量存储爬虫Job数据
@@ -41,9 +46,10 @@ public:
      * @brief 存储单条职位数据并指定sourceId
      * @param crawledJob 爬虫数据
      * @param sourceId 数据来源ID
+     * @param canonicalJobId 可选输出，同 storeJobData
      * @return 成功返回jobId，失败返回-1
      */
-    int storeJobDataWithSource(const ::JobInfo& crawledJob, int sourceId);
+    long long storeJobDataWithSource(const ::JobInfo& crawledJob, int sourceId, long long *canonicalJobId = nullptr);
     
     /**
      * @brief 批量存储职位数据并指定sourceId
@@ -53,18 +59,24 @@ public:
      */
     int storeJobDataBatchWithSource(const std::vector<::JobInfo>& crawledJobs, int sourceId);
 
+    /**
+     * @brief 读入某来源全部已记录指纹的职位，替换 index 的内容（增量爬取开始时调用）
+     * @return 查询失败返回false（index 不变）
+     */
+    bool loadKnownJobs(int sourceId, KnownJobIndex &index);
+
     // ========== 基础SQL操作方法 ==========
     
     // === 一般ID部分 (需要传入ID) ===
     
     // Job - jobId required
-    int insertJob(int jobId, const QString &jobName, int companyId, int recruitTypeId, 
-                  int cityId, const QString &requirements, double salaryMin, double salaryMax,
-                  int salarySlabId, const QString &createTime, const QString &updateTime,
-                  const QString &hrLastLoginTime);
+    long long insertJob(long long jobId, const QString &jobName, long long companyId, int recruitTypeId,
+                        int cityId, const QString &requirements, double salaryMin, double salaryMax,
+                        int salarySlabId, const QString &createTime, const QString &updateTime,
+                        const QString &hrLastLoginTime);
     
     // Company - companyId required
-    int insertCompany(int companyId, const QString &companyName);
+    long long insertCompany(long long companyId, const QString &companyName);
 
     // === 自增ID部分 (不传入ID，数据库自增) ===
     
@@ -80,6 +92,14 @@ public:
     // === Query operations ===
     QVector<SQLNS::JobInfo> queryAllJobs();
 
+    /**
+     * @brief 一批写入完成后递增数据库数据代数（DbMeta.generation）
+     * 读端（PresenterTask 查询缓存等）据此判断数据是否变化；
+     * 递增前先为本批职位建立 JobBigram 索引（SQLInterface::indexPendingBigrams）
+     * @return 成功返回true
+     */
+    bool bumpDataGeneration();
+
 private:
     SQLInterface *m_sqlInterface;
     
@@ -89,6 +109,12 @@ private:
      * @brief 将爬虫JobInfo转换为SQL JobInfo
      */
     SQLNS::JobInfo convertJobInfo(const ::JobInfo& crawledJob);
+
+    /**
+     * @brief 旧版 ID 重映射：crawledJob 带有 legacy_info_id / legacy_company_id 时，
+     * 把迁移 12 登记的旧行改写为稳定 ID（SQLInterface::remapLegacyJobId / remapLegacyCompanyId）
+     */
+    void remapLegacyIds(const ::JobInfo& crawledJob);
     
     /**
      * @brief 计算薪资档次ID（根据recruitType区分实习的元/天 vs 校招社招的K/月）
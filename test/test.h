@@ -25,6 +25,9 @@ void test_internet_task_unit();
  *   - 类型转换验证 (::JobInfo → SQLNS::JobInfo)
  *   - 数据库查询验证
  *   - 基础SQL操作测试
+ *   - 数据一致性验证与数据代数递增
+ *   - 变化职位重新入库（行、标签与指纹同步更新）
+ *   - 旧合成ID重映射后的全文检索
  */
 void test_sql_task_unit();
 
@@ -49,5 +52,15 @@ void test_batch_crawl();
 // PresenterTask 功能测试 - 数据查询与处理
 void test_presenter_task();
 
+// ============================================================
+// 性能基准
+// ============================================================
+
+// SQLInterface 全量加载基准：不同行数下 queryAllJobs / queryAllJobsPrint 的耗时
+void test_sql_benchmark();
+
+// 搜索基准：分词速度、n-gram / BM25 建索引耗时与查询延迟（合成职位）
+void test_search_benchmark();
+
 
 #endif // TEST_H
@@ -1,5 +1,6 @@
 #include "test.h"
 #include "tasks/internet_task.h"
+#include "network/known_job_index.h"
 #include <QDebug>
 #include <iostream>
 
@@ -11,6 +12,8 @@
  *   2. 多页批量爬取
  *   3. 数据结构验证
  *   4. 映射数据完整性
+ *   5. 稳定合成ID（XXH64 参考值、来源区分、取值区间）
+ *   6. 增量爬取的列表指纹与已知职位集合
  */
 void test_internet_task_unit() {
     qDebug() << "\n========== InternetTask 单元测试 ==========\n";
@@ -89,5 +92,49 @@ void test_internet_task_unit() {
         }
     }
     
+    // ========== 场景5: 稳定合成ID ==========
+    // 字符串键来源（BOSS直聘 / 中华英才网）的 ID 必须与构建 / 标准库无关，重新编译后增量爬取仍能去重
+    qDebug() << "\n[场景5] 稳定合成ID";
+    const std::string sample = "Nobody inspects the spammish repetition";
+    const bool xxhOk = xxhash64("", 0) == 0xEF46DB3751D8E999ULL
+                       && xxhash64(sample.data(), sample.size()) == 0xFBCEA83C8A378BF1ULL;
+    const int64_t zhipinId = stable_synthetic_id("zhipin", "a1b2c3~");
+    const bool rangeOk = zhipinId >= static_cast<int64_t>(kSyntheticIdBase)
+                         && zhipinId == stable_synthetic_id("zhipin", "a1b2c3~")
+                         && zhipinId != stable_synthetic_id("chinahr", "a1b2c3~");
+    qDebug() << "  - XXH64 参考值:" << (xxhOk ? "一致" : "不一致") << " zhipin 示例ID:" << zhipinId;
+    if (!xxhOk) qDebug() << "❌ XXH64 与参考值不一致，合成ID在不同构建间不稳定";
+    if (!rangeOk) qDebug() << "❌ 合成ID不稳定、未按来源区分或不在合成ID区间";
+    if (xxhOk && rangeOk) qDebug() << "✓ 合成ID稳定、按来源区分且位于合成ID区间";
+
+    // ========== 场景6: 已知职位集合 ==========
+    // 指纹只看列表字段：详情页文本与抓取时间变化不影响，薪资变化则视为内容变化
+    qDebug() << "\n[场景6] 增量爬取的已知职位集合";
+    JobInfo listed{};
+    listed.info_id = zhipinId;
+    listed.info_name = "C++ 开发工程师";
+    listed.company_name = "示例科技";
+    listed.area_name = "北京";
+    listed.type_id = 1;
+    listed.salary_min = 20;
+    listed.salary_max = 35;
+    listed.tag_names = {"C++", "Linux"};
+    JobInfo detailed = listed;
+    detailed.requirements = "熟悉C++17";
+    detailed.create_time = "2026-01-01 00:00:00";
+    JobInfo raised = listed;
+    raised.salary_max = 40;
+    const uint64_t fingerprint = job_fingerprint(listed);
+
+    KnownJobIndex known;
+    known.assign({{3, 1}, {listed.info_id, fingerprint}, {1, 7}});
+    known.insert(42, 9);
+    const bool indexOk = fingerprint == job_fingerprint(detailed)
+                         && known.lookup(listed.info_id, job_fingerprint(detailed)) == KnownJobIndex::State::Known
+                         && known.lookup(listed.info_id, job_fingerprint(raised)) == KnownJobIndex::State::Changed
+                         && known.lookup(2, fingerprint) == KnownJobIndex::State::Unknown
+                         && known.contains(1, 7) && known.contains(42, 9) && known.size() == 4;
+    qDebug() << (indexOk ? "✓ 已知 / 变化 / 未知判定正确" : "❌ 已知职位判定异常");
+
     qDebug() << "\n✅ InternetTask 单元测试完成!\n";
 }
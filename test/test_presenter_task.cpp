@@ -4,6 +4,7 @@
 #include "presenter/presenter.h"
 #include "db/sqlinterface.h"
 #include <QDebug>
+#include <QElapsedTimer>
 
 void test_presenter_task() {
     qDebug() << "[Test] PresenterTask 测试开始";
@@ -18,7 +19,7 @@ void test_presenter_task() {
     TaskNS::PagingResult result = PresenterTask::queryJobsWithPaging(emptyQuery, emptyFilters, emptySort, true, testPage, testPageSize);
 
     qDebug() << "===== 分页测试结果 =====";
-    qDebug() << "总数据量：" << result.allData.size();
+    qDebug() << "总数据量：" << result.totalCount;
     qDebug() << "总页数：" << result.totalPage;
     qDebug() << "当前页：" << result.currentPage;
     qDebug() << "当前页数据量：" << result.pageData.size();
@@ -35,35 +36,145 @@ void test_presenter_task() {
     }
 
     // 测试3：按城市名称筛选（示例使用第一条记录的 cityName，如果存在）
-    QString sampleCity = result.allData.isEmpty() ? QString() : result.allData.first().cityName;
+    const QVector<SQLNS::JobInfoPrint> allJobs = Presenter::getAllJobs(1, INT_MAX);
+    QString sampleCity = allJobs.isEmpty() ? QString() : allJobs.first().cityName;
     TaskNS::PagingResult cityFiltered = PresenterTask::queryJobsWithPaging(emptyQuery, { {"cityName", {sampleCity}} }, "", true, 1, INT_MAX);
-    qDebug() << "\n===== 城市('" << sampleCity << "') 的职位数量 =====" << cityFiltered.allData.size();
+    qDebug() << "\n===== 城市('" << sampleCity << "') 的职位数量 =====" << cityFiltered.totalCount;
 
     // 验证：Presenter::searchJobs 的映射过滤与 Task 行为一致
     QMap<QString, QVector<QString>> mapFilters;
     mapFilters.insert("cityName", {sampleCity});
-    QVector<SQLNS::JobInfoPrint> filteredByMap = Presenter::searchJobs(result.allData, mapFilters);
-    if (filteredByMap.size() == cityFiltered.allData.size()) qDebug() << "✓ 映射过滤与 Task 行为一致";
+    QVector<SQLNS::JobInfoPrint> filteredByMap = Presenter::searchJobs(allJobs, mapFilters);
+    if (filteredByMap.size() == cityFiltered.totalCount) qDebug() << "✓ 映射过滤与 Task 行为一致";
 
     // 测试：未知字段不应产生回退匹配（保证不会产生意外命中）
     QMap<QString, QVector<QString>> badFilter;
     badFilter.insert("unknown_field", {"no-such-value"});
-    QVector<SQLNS::JobInfoPrint> badFiltered = Presenter::searchJobs(result.allData, badFilter);
+    QVector<SQLNS::JobInfoPrint> badFiltered = Presenter::searchJobs(allJobs, badFilter);
     qDebug() << "\n===== 未知字段滤器应返回0条（或与预期一致） =====" << badFiltered.size();
     if (badFiltered.size() == 0) qDebug() << "✓ 未知字段不会回退匹配";
     // 测试4：搜索示例（单字符串查询）
     qDebug() << "\n===== 搜索测试：单字符串查询示例 =====";
     TaskNS::PagingResult qres1 = PresenterTask::queryJobsWithPaging("后端", emptyFilters, "", true, 1, INT_MAX);
-    qDebug() << "查询 '后端' 搜索结果数量：" << qres1.allData.size();
-    if (!qres1.allData.isEmpty()) Presenter::printJobsLineByLine(qres1.pageData);
+    qDebug() << "查询 '后端' 搜索结果数量：" << qres1.totalCount;
+    if (!qres1.pageData.isEmpty()) Presenter::printJobsLineByLine(qres1.pageData);
 
     TaskNS::PagingResult qres2 = PresenterTask::queryJobsWithPaging("提供住宿", emptyFilters, "", true, 1, INT_MAX);
-    qDebug() << "查询 '提供住宿' 搜索结果数量：" << qres2.allData.size();
-    if (!qres2.allData.isEmpty()) Presenter::printJobsLineByLine(qres2.pageData);
+    qDebug() << "查询 '提供住宿' 搜索结果数量：" << qres2.totalCount;
+    if (!qres2.pageData.isEmpty()) Presenter::printJobsLineByLine(qres2.pageData);
 
     TaskNS::PagingResult qres3 = PresenterTask::queryJobsWithPaging("工程", emptyFilters, "", true, 1, INT_MAX);
-    qDebug() << "查询 '工程' 搜索结果数量：" << qres3.allData.size();
-    if (!qres3.allData.isEmpty()) Presenter::printJobsLineByLine(qres3.pageData);
+    qDebug() << "查询 '工程' 搜索结果数量：" << qres3.totalCount;
+    if (!qres3.pageData.isEmpty()) Presenter::printJobsLineByLine(qres3.pageData);
+
+    // 测试5：SQL 下推 keyset 分页应与内存路径结果一致（数量与顺序）
+    qDebug() << "\n===== keyset 分页一致性测试 =====";
+    TaskNS::PagingResult memRes = PresenterTask::queryJobsWithPaging("工程", emptyFilters, "salaryMax", false, 1, testPageSize, false);
+    QVector<long long> keysetIds;
+    SQLNS::JobPage kpage = PresenterTask::queryJobsPage("工程", emptyFilters, "salaryMax", false, testPageSize);
+    const int keysetTotal = kpage.totalCount;
+    while (true) {
+        for (const auto &job : kpage.rows) keysetIds.append(job.jobId);
+        if (!kpage.hasMore) break;
+        kpage = PresenterTask::queryJobsPage("工程", emptyFilters, "salaryMax", false, testPageSize, kpage);
+    }
+    // 内存路径只物化首页，完整顺序从行号视图读取
+    bool sameOrder = (keysetIds.size() == memRes.view.size());
+    for (int i = 0; sameOrder && i < keysetIds.size(); ++i) sameOrder = (keysetIds[i] == memRes.view.jobId(i));
+    qDebug() << "keyset 总数:" << keysetTotal << "逐页合计:" << keysetIds.size() << "内存路径:" << memRes.view.size();
+    if (sameOrder && keysetTotal == keysetIds.size()) qDebug() << "✓ keyset 分页与内存路径一致";
+
+    // 测试6：列式存储的筛选/排序应与行式 Presenter::searchJobs / sortJobs 一致
+    qDebug() << "\n===== 列式存储一致性测试 =====";
+    JobStore store;
+    for (const auto &job : allJobs) store.append(job);
+    QMap<QString, QVector<QString>> storeFilters;
+    storeFilters.insert("cityName", {sampleCity});
+    storeFilters.insert("tagNames", {"C++", "Java"});
+    QVector<int> storeRows = store.filter(store.allRows(), storeFilters);
+    store.sort(storeRows, "salaryMin", false);
+    const QVector<SQLNS::JobInfoPrint> rowWise = Presenter::sortJobs(Presenter::searchJobs(allJobs, storeFilters), "salaryMin", false);
+    bool storeSame = (storeRows.size() == rowWise.size());
+    for (int i = 0; storeSame && i < storeRows.size(); ++i) storeSame = (store.jobId(storeRows[i]) == rowWise[i].jobId);
+    qDebug() << "列式命中:" << storeRows.size() << "行式命中:" << rowWise.size();
+    if (storeSame) qDebug() << "✓ 列式存储与行式实现一致";
+
+    // 预计算排序索引后：全排序与未预计算时一致，top-k 前缀与全排序前缀一致
+    store.buildSortIndex();
+    QVector<int> indexedRows = store.filter(store.allRows(), storeFilters);
+    QVector<int> topRows = indexedRows;
+    store.sort(indexedRows, "salaryMin", false);
+    const int topDone = store.sort(topRows, "salaryMin", false, 5);
+    if (indexedRows == storeRows && topRows.mid(0, topDone) == indexedRows.mid(0, topDone)) {
+        qDebug() << "✓ 预计算排序 / top-k 与逐次稳定排序一致";
+    }
+
+    // 月薪区间：区间索引（二分）与行式逐条换算比较一致
+    store.buildRangeIndex();
+    QMap<QString, QVector<QString>> salaryFilters;
+    salaryFilters.insert("monthlySalaryOverlap", {"8000-15000"});
+    salaryFilters.insert("monthlySalaryMin", {"5000"});
+    const QVector<int> rangeRows = store.filter(salaryFilters);
+    const QVector<SQLNS::JobInfoPrint> rangeRowWise = Presenter::searchJobs(allJobs, salaryFilters);
+    bool rangeSame = (rangeRows.size() == rangeRowWise.size());
+    for (int i = 0; rangeSame && i < rangeRows.size(); ++i) rangeSame = (store.jobId(rangeRows[i]) == rangeRowWise[i].jobId);
+    qDebug() << "月薪区间命中:" << rangeRows.size();
+    if (rangeSame) qDebug() << "✓ 区间索引与逐行换算一致";
+
+    // 时间列：按发布时间排序、N 天内发布 / HR 活跃筛选与行式实现一致
+    QMap<QString, QVector<QString>> recentFilters;
+    recentFilters.insert("postedWithinDays", {"30"});
+    recentFilters.insert("hrActiveWithinDays", {"7", "14"});
+    QVector<int> recentRows = store.filter(recentFilters);
+    store.sort(recentRows, "createTime", false);
+    const QVector<SQLNS::JobInfoPrint> recentRowWise = Presenter::sortJobs(Presenter::searchJobs(allJobs, recentFilters), "createTime", false);
+    bool recentSame = (recentRows.size() == recentRowWise.size());
+    for (int i = 0; recentSame && i < recentRows.size(); ++i) recentSame = (store.jobId(recentRows[i]) == recentRowWise[i].jobId);
+    qDebug() << "近期职位命中:" << recentRows.size();
+    if (recentSame) qDebug() << "✓ 时间列筛选 / 排序与行式实现一致";
+
+    // 近重复折叠：位图路径与行式一致，且每个近重复组恰好保留一条（规范职位）
+    QMap<QString, QVector<QString>> collapseFilters;
+    collapseFilters.insert("collapseDuplicates", {"1"});
+    const QVector<int> collapsedRows = store.filter(collapseFilters);
+    const QVector<SQLNS::JobInfoPrint> collapsedRowWise = Presenter::searchJobs(allJobs, collapseFilters);
+    bool collapseSame = (collapsedRows.size() == collapsedRowWise.size());
+    for (int i = 0; collapseSame && i < collapsedRows.size(); ++i) collapseSame = (store.jobId(collapsedRows[i]) == collapsedRowWise[i].jobId);
+    QSet<long long> groups;
+    for (const auto &job : allJobs) groups.insert(job.canonicalJobId != 0 ? job.canonicalJobId : job.jobId);
+    qDebug() << "折叠后职位数:" << collapsedRows.size() << "/" << store.size() << "近重复组数:" << groups.size();
+    if (collapseSame && collapsedRows.size() == groups.size()) qDebug() << "✓ 近重复折叠与行式实现一致";
+
+    // 全量位图路径（toVector）与带输入选择向量的路径（逐行 contains）应一致
+    QElapsedTimer facetTimer;
+    facetTimer.start();
+    const QVector<int> facetRows = store.filter(storeFilters);
+    const qint64 facetNs = facetTimer.nsecsElapsed();
+    const QVector<int> scanRows = store.filter(store.allRows(), storeFilters);
+    qDebug() << "位图筛选命中:" << facetRows.size() << "耗时(us):" << facetNs / 1000;
+    if (facetRows == scanRows) qDebug() << "✓ 全量位图筛选与选择向量筛选一致";
+
+    // 分面计数：城市计数不受城市自身条件约束，应等于去掉 cityName 条件后命中行中各城市的行数
+    const JobStore::FacetCounts counts = store.facetCounts(nullptr, storeFilters);
+    QMap<QString, QVector<QString>> withoutCity = storeFilters;
+    withoutCity.remove("cityName");
+    QMap<QString, int> expectedCity;
+    for (int r : store.filter(withoutCity)) expectedCity[store.row(r).cityName] += 1;
+    qDebug() << "城市分面取值数:" << counts.value("cityName").size();
+    if (counts.value("cityName") == expectedCity) qDebug() << "✓ 分面计数与逐行统计一致";
+
+    // 测试7：n-gram 索引候选 + 回查应与线性扫描命中同一集合
+    qDebug() << "\n===== n-gram 索引一致性测试 =====";
+    NgramIndex ngram;
+    for (const auto &job : allJobs) ngram.addJob(job.jobId, NgramIndex::searchableFields(job));
+    qDebug() << "文档数:" << ngram.documentCount() << "gram 数:" << ngram.gramCount();
+    for (const QString &q : {QString("工程"), QString("开发工程师"), QString("c++"), sampleCity}) {
+        if (q.size() < 2) continue;   // 单字符查询不走索引
+        const QVector<int> viaIndex = Presenter::searchRows(store, q, &ngram);
+        const QVector<int> viaScan = store.matchText(q);
+        qDebug() << "查询:" << q << "索引:" << viaIndex.size() << "扫描:" << viaScan.size();
+        if (viaIndex == viaScan) qDebug() << "✓ 索引结果与扫描一致";
+    }
 
     qDebug() << "[Test] PresenterTask 测试结束";
 }
\ No newline at end of file
@@ -0,0 +1,167 @@
+// test/test_search_benchmark.cpp
+#include "test.h"
+#include "presenter/presenter.h"
+#include "presenter/job_store.h"
+#include "presenter/ngram_index.h"
+#include "presenter/bm25_index.h"
+#include "presenter/segmenter.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <memory>
+
+namespace {
+
+const QStringList kTitles = {
+    "C++ 开发工程师", "后端开发工程师（Java）", "前端开发实习生", "算法工程师-推荐系统", "机器学习算法实习生",
+    "测试开发工程师", "数据分析师", "嵌入式软件工程师", "产品经理", "游戏客户端开发工程师",
+    "Go语言后端开发", "大模型推理优化工程师", "自动驾驶感知算法工程师", "数据开发工程师（数仓方向）", "运维开发工程师"};
+const QStringList kCompanies = {"字节跳动", "腾讯科技", "阿里巴巴", "美团", "京东集团", "网易游戏", "小米科技", "华为技术有限公司"};
+const QStringList kTags = {"C++", "Java", "Python", "Linux", "MySQL", "Redis", "机器学习", "深度学习",
+                           "分布式", "Vue", "React", "Qt", "推荐算法", "大模型", "数据分析", "Kafka"};
+const QStringList kRequirementLines = {
+    "熟悉C++17/Qt，了解SQLite与多线程编程，有良好的沟通能力；",
+    "掌握Java、Spring Boot，熟悉MySQL、Redis、Kafka等中间件，有高并发分布式系统经验者优先；",
+    "熟悉机器学习、深度学习基本算法，有推荐系统或搜索相关项目经验；",
+    "具备扎实的数据结构与算法基础，熟悉Linux操作系统与计算机网络；",
+    "有大模型训练或推理优化经验者优先，熟悉PyTorch；",
+    "负责产品需求分析与方案设计，具备数据分析能力与良好的团队合作精神；",
+    "熟悉Vue/React等前端框架，关注用户体验与交互设计；",
+    "计算机、软件工程等相关专业本科及以上学历，学习能力强，责任心强。"};
+
+// 基准用的岗位要求数据源：全部放在内存中
+class MemoryRequirements : public RequirementsSource {
+public:
+    explicit MemoryRequirements(const QVector<SQLNS::JobInfoPrint> &jobs) {
+        for (const auto &job : jobs) m_texts.insert(job.jobId, job.requirements);
+    }
+    QHash<long long, QString> fetch(const QVector<long long> &jobIds) const override {
+        QHash<long long, QString> out;
+        for (long long id : jobIds) {
+            auto it = m_texts.constFind(id);
+            if (it != m_texts.constEnd()) out.insert(id, it.value());
+        }
+        return out;
+    }
+    QSet<long long> matchAny(const QVector<QString> &needles) const override {
+        QSet<long long> ids;
+        for (auto it = m_texts.constBegin(); it != m_texts.constEnd(); ++it) {
+            for (const auto &n : needles) {
+                if (it.value().contains(n, Qt::CaseInsensitive)) { ids.insert(it.key()); break; }
+            }
+        }
+        return ids;
+    }
+
+private:
+    QHash<long long, QString> m_texts;
+};
+
+// 生成 count 条合成职位（标题 / 公司 / 标签 / 岗位要求按编号轮换组合）
+QVector<SQLNS::JobInfoPrint> makeJobs(int count) {
+    QVector<SQLNS::JobInfoPrint> jobs;
+    jobs.reserve(count);
+    for (int i = 1; i <= count; ++i) {
+        SQLNS::JobInfoPrint job;
+        job.jobId = i;
+        job.jobName = kTitles[i % kTitles.size()];
+        job.companyId = 1 + (i % kCompanies.size());
+        job.companyName = kCompanies[i % kCompanies.size()];
+        job.recruitTypeId = 1 + (i % 3);
+        job.recruitTypeName = QStringList({"校招", "实习", "社招"})[i % 3];
+        job.cityId = 1 + (i % 4);
+        job.cityName = QStringList({"北京", "上海", "深圳", "杭州"})[i % 4];
+        job.sourceId = 1;
+        job.sourceName = "bench";
+        job.salaryMin = 10 + (i % 20);
+        job.salaryMax = job.salaryMin + 10;
+        job.salarySlabId = 1 + (i % 6);
+        job.createEpoch = job.updateEpoch = job.hrLastLoginEpoch = 1765764000;
+        for (int k = 0; k < 3; ++k) {
+            job.tagIds.append((i + k * 5) % kTags.size());
+            job.tagNames.append(kTags[(i + k * 5) % kTags.size()]);
+        }
+        for (int k = 0; k < 3; ++k) job.requirements += kRequirementLines[(i * 7 + k * 3) % kRequirementLines.size()];
+        jobs.append(job);
+    }
+    return jobs;
+}
+
+// 对一组合成职位计时：建 n-gram / BM25 索引，再测若干查询的平均延迟（仅 n-gram 候选 vs 加 BM25 排序）
+void runSearchRound(int count) {
+    const QVector<SQLNS::JobInfoPrint> jobs = makeJobs(count);
+    JobStore store;
+    store.reserve(count);
+    for (const auto &job : jobs) store.append(job);
+    store.setRequirementsSource(std::make_shared<MemoryRequirements>(jobs));
+
+    QElapsedTimer timer;
+    timer.start();
+    NgramIndex ngram;
+    for (const auto &job : jobs) ngram.addJob(job.jobId, NgramIndex::searchableFields(job));
+    const qint64 ngramMs = timer.elapsed();
+
+    timer.restart();
+    Bm25Index bm25;
+    for (const auto &job : jobs) {
+        const QStringList fields = Bm25Index::fieldTexts(job);
+        bm25.addJob(job.jobId, fields, NgramIndex::signature(fields));
+    }
+    const qint64 bm25Ms = timer.elapsed();
+    qDebug().noquote() << QString("[index] jobs=%1 | n-gram %2 ms (%3 grams) | bm25 %4 ms (%5 terms)")
+                              .arg(count).arg(ngramMs).arg(ngram.gramCount()).arg(bm25Ms).arg(bm25.termCount());
+
+    const int kRepeat = 20;
+    for (const QString &q : {QString("开发工程师"), QString("推荐算法"), QString("机器学习"), QString("c++"), QString("大模型推理")}) {
+        QVector<int> plain, ranked;
+        timer.restart();
+        for (int r = 0; r < kRepeat; ++r) plain = Presenter::searchRows(store, q, &ngram);
+        const double plainUs = timer.nsecsElapsed() / 1000.0 / kRepeat;
+        timer.restart();
+        for (int r = 0; r < kRepeat; ++r) ranked = Presenter::searchRows(store, q, &ngram, &bm25);
+        const double rankedUs = timer.nsecsElapsed() / 1000.0 / kRepeat;
+        const QString top = ranked.isEmpty() ? QString("-") : store.row(ranked.first()).jobName;
+        qDebug().noquote() << QString("[query] jobs=%1 q=%2 | hits %3 | n-gram %4 us | +bm25 %5 us | top: %6")
+                                  .arg(count).arg(q).arg(ranked.size())
+                                  .arg(plainUs, 0, 'f', 0).arg(rankedUs, 0, 'f', 0).arg(top);
+        if (plain.size() != ranked.size()) qDebug() << "❌ 排序改变了命中数量:" << q;
+    }
+}
+
+} // namespace
+
+/**
+ * @brief 搜索基准
+ * 分词：词表加载耗时、切分吞吐与示例切分；
+ * 索引：不同职位数下 n-gram / BM25 建索引耗时，以及查询平均延迟（只取候选 vs 再按 BM25 排序）
+ */
+void test_search_benchmark() {
+    qDebug() << "\n========== 搜索基准 ==========\n";
+
+    QElapsedTimer timer;
+    timer.start();
+    const Segmenter &segmenter = Segmenter::shared();
+    qDebug().noquote() << QString("[segmenter] 词表 %1 词, 加载 + 构建 %2 ms")
+                              .arg(segmenter.wordCount()).arg(timer.elapsed());
+
+    for (const QString &text : {QString("熟悉C++/Qt与Go语言后端开发，有机器学习项目经验者优先"),
+                                QString("负责大模型推理优化与推荐算法的工程落地"),
+                                QString("计算机相关专业本科及以上学历")}) {
+        qDebug().noquote() << text << "->" << segmenter.segment(text).join(" / ");
+    }
+
+    const QVector<SQLNS::JobInfoPrint> sample = makeJobs(20000);
+    qint64 chars = 0;
+    int tokens = 0;
+    timer.restart();
+    for (const auto &job : sample) {
+        chars += job.jobName.size() + job.requirements.size();
+        tokens += segmenter.segment(job.jobName).size() + segmenter.segment(job.requirements).size();
+    }
+    const qint64 segmentMs = qMax<qint64>(timer.elapsed(), 1);
+    qDebug().noquote() << QString("[segmenter] %1 字符 -> %2 词, %3 ms (%4 字符/ms)")
+                              .arg(chars).arg(tokens).arg(segmentMs).arg(chars / segmentMs);
+
+    for (int count : {5000, 20000, 50000}) runSearchRound(count);
+
+    qDebug() << "\n✅ 搜索基准完成!\n";
+}
@@ -0,0 +1,104 @@
+// test/test_sql_benchmark.cpp
+#include "test.h"
+#include "db/sqlinterface.h"
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QElapsedTimer>
+
+namespace {
+
+// 生成 rowCount 条合成职位数据（每条 3 个标签），写入独立的基准库文件
+bool fillBenchmarkDb(SQLInterface &sql, int rowCount) {
+    if (!sql.createAllTables()) return false;
+    if (!sql.beginTransaction()) return false;
+
+    QVector<int> cityIds, tagIds;
+    const QStringList cities = {"北京", "上海", "深圳", "杭州", "广州", "成都", "南京", "武汉"};
+    for (const QString &c : cities) cityIds.append(sql.insertCity(c));
+    for (int t = 0; t < 64; ++t) tagIds.append(sql.insertTag(QString("bench-tag-%1").arg(t)));
+    for (int c = 1; c <= 200; ++c) sql.insertCompany(c, QString("Bench 公司%1").arg(c));
+
+    for (int i = 1; i <= rowCount; ++i) {
+        SQLNS::JobInfo job;
+        job.jobId = i;
+        job.jobName = QString("C++ 开发工程师 #%1").arg(i);
+        job.companyId = 1 + (i % 200);
+        job.recruitTypeId = 1 + (i % 3);
+        job.cityId = cityIds[i % cityIds.size()];
+        job.sourceId = 1 + (i % 5);
+        job.requirements = "熟悉C++17/Qt，了解SQLite与多线程编程，有良好的沟通能力";
+        job.salaryMin = 10 + (i % 20);
+        job.salaryMax = job.salaryMin + 10;
+        job.salarySlabId = 1 + (i % 6);
+        job.createTime = "2025-12-15 10:00:00";
+        job.updateTime = "2025-12-15 10:00:00";
+        job.hrLastLoginTime = "2025-12-15 09:00:00";
+        if (sql.insertJob(job) < 0) {
+            sql.rollbackTransaction();
+            return false;
+        }
+        for (int k = 0; k < 3; ++k) {
+            sql.insertJobTagMapping(job.jobId, tagIds[(i + k * 7) % tagIds.size()]);
+        }
+    }
+    return sql.commitTransaction();
+}
+
+// 以当前选定的存储后端对各行数分别计时一轮
+void runBenchmarkRound(const QString &backendName) {
+    const QVector<int> rowCounts = {1000, 5000, 20000, 50000};
+    for (int rows : rowCounts) {
+        const QString dbPath = QDir::temp().filePath(QString("crawler_bench_%1.db").arg(rows));
+        QFile::remove(dbPath);
+
+        SQLInterface sql;
+        if (!sql.connectSqlite(dbPath)) {
+            qDebug() << "❌ 无法创建基准库:" << dbPath;
+            continue;
+        }
+        QElapsedTimer timer;
+        timer.start();
+        if (!fillBenchmarkDb(sql, rows)) {
+            qDebug() << "❌ 生成数据失败, rows =" << rows;
+            sql.disconnect();
+            continue;
+        }
+        const qint64 fillMs = timer.elapsed();
+
+        timer.restart();
+        const int jobCount = sql.queryAllJobs().size();
+        const qint64 jobsMs = timer.elapsed();
+
+        timer.restart();
+        const int printCount = sql.queryAllJobsPrint().size();
+        const qint64 printMs = timer.elapsed();
+
+        qDebug().noquote() << QString("[%1] rows=%2 | fill %3 ms | queryAllJobs %4 条 %5 ms | queryAllJobsPrint %6 条 %7 ms")
+                                  .arg(backendName).arg(rows).arg(fillMs).arg(jobCount).arg(jobsMs).arg(printCount).arg(printMs);
+
+        sql.disconnect();
+        QFile::remove(dbPath);
+    }
+}
+
+} // namespace
+
+/**
+ * @brief SQLInterface 全量加载基准
+ * 对不同行数的合成库分别计时 queryAllJobs / queryAllJobsPrint，输出 行数 -> 耗时(ms)；
+ * 编译了原生 SQLite 后端时，QtSql 与原生后端各跑一遍便于对比
+ */
+void test_sql_benchmark() {
+    qDebug() << "\n========== SQLInterface 加载基准 ==========\n";
+
+    const SQLInterface::Backend previousBackend = SQLInterface::backend();
+    SQLInterface::setBackend(SQLInterface::Backend::QtSql);
+    runBenchmarkRound("qtsql");
+    if (SQLInterface::setBackend(SQLInterface::Backend::NativeSqlite)) {
+        runBenchmarkRound("native");
+    }
+    SQLInterface::setBackend(previousBackend);
+
+    qDebug() << "\n✅ SQLInterface 加载基准完成!\n";
+}
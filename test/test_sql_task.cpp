@@ -1,8 +1,14 @@
 #include "test.h"
 #include "tasks/sql_task.h"
 #include "db/sqlinterface.h"
+#include "network/job_crawler.h"
 #include <QDebug>
 #include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <algorithm>
 
 /**
  * @brief SqlTask单元测试
@@ -11,7 +17,11 @@
  *   1. 单条数据存储
  *   2. 批量数据存储
  *   3. 类型转换验证
- *   4. 数据库查询验证
+ *   4. 基础SQL操作
+ *   5. 数据一致性验证
+ *   6. 数据代数递增
+ *   7. 变化职位重新入库（行、标签与指纹同步更新）
+ *   8. 旧合成ID重映射后仍可按标签 / 公司名全文检索（独立临时库）
  */
 void test_sql_task_unit() {
     qDebug() << "\n========== SqlTask 单元测试 ==========\n";
@@ -47,7 +57,7 @@ void test_sql_task_unit() {
     mockJob1.hr_last_login = "2025-12-15 09:00:00";
     mockJob1.tag_ids = {1, 2, 3};
     
-    int jobId1 = sqlTask.storeJobData(mockJob1);
+    long long jobId1 = sqlTask.storeJobData(mockJob1);
     qDebug() << "✓ 存储结果: jobId =" << jobId1;
     
     if (jobId1 > 0) {
@@ -122,7 +132,7 @@ void test_sql_task_unit() {
     qDebug() << "\n[场景4] 基础SQL操作测试";
     
     // 测试insertCompany (一般ID)
-    int companyId = sqlTask.insertCompany(301, "UnitTest科技");
+    long long companyId = sqlTask.insertCompany(301, "UnitTest科技");
     qDebug() << "✓ insertCompany (一般ID):" << (companyId > 0 ? "成功" : "失败");
     
     // 测试insertCity (自增ID)
@@ -154,7 +164,107 @@ void test_sql_task_unit() {
     if (consistent) {
         qDebug() << "✓ 数据一致性检查通过";
     }
+
+    // === 数据代数 ===
+    qDebug() << "\n[场景6] 数据代数递增";
+    const qint64 generationBefore = sql.dataGeneration();
+    sqlTask.bumpDataGeneration();
+    const qint64 generationAfter = sql.dataGeneration();
+    qDebug() << "generation:" << generationBefore << "->" << generationAfter;
+    if (generationBefore >= 0 && generationAfter == generationBefore + 1) {
+        qDebug() << "✓ 写入后数据代数递增，读端缓存将失效";
+    }
+
+    // === 变化职位重新入库 ===
+    // 同一 jobId 的列表字段与标签变化后再次入库：行与标签集合必须被更新，指纹与行一致
+    qDebug() << "\n[场景7] 变化职位重新入库";
+    ::JobInfo changedJob = mockJob1;
+    changedJob.info_name = "C++ 高级开发工程师 (单元测试)";
+    changedJob.salary_max = 45.0;
+    changedJob.update_time = "2025-12-20 10:00:00";
+    changedJob.requirements.clear();  // 仅列表页数据：已入库的岗位要求应保留
+    changedJob.tag_ids = {1, 2, 4};     // 去掉标签 3、新增标签 4
+    const long long changedId = sqlTask.storeJobDataWithSource(changedJob, 1);
+    bool rowUpdated = false;
+    bool tagsReplaced = false;
+    for (const auto& dbJob : sql.queryAllJobs()) {
+        if (dbJob.jobId != changedId) continue;
+        rowUpdated = dbJob.jobName == QString::fromStdString(changedJob.info_name)
+                     && dbJob.salaryMax == changedJob.salary_max
+                     && dbJob.updateTime == QString::fromStdString(changedJob.update_time)
+                     && dbJob.createTime == QString::fromStdString(mockJob1.create_time)
+                     && dbJob.requirements == QString::fromStdString(mockJob1.requirements);
+        QVector<int> tags = dbJob.tagIds;
+        std::sort(tags.begin(), tags.end());
+        tagsReplaced = tags == QVector<int>({1, 2, 4});
+    }
+    bool fingerprintOk = false;
+    for (const auto& entry : sql.queryJobFingerprints(1)) {
+        if (entry.first == changedId) fingerprintOk = entry.second == job_fingerprint(changedJob);
+    }
+    if (changedId == mockJob1.info_id && rowUpdated && tagsReplaced && fingerprintOk) {
+        qDebug() << "✓ 变化职位的行与标签已更新（保留 createTime 与岗位要求），指纹与新内容一致";
+    } else {
+        qDebug() << "❌ 变化职位重新入库异常: jobId =" << changedId
+                 << " 行已更新:" << rowUpdated << " 标签已替换:" << tagsReplaced << " 指纹一致:" << fingerprintOk;
+    }
     
     sql.disconnect();
+
+    // ========== 场景8: 旧合成ID重映射后的全文检索 ==========
+    // 带标签的旧 ID 职位改写为稳定 ID 后，JobFts 仍须能按标签与公司名命中。
+    // 用独立临时库（本线程连接在上面已断开）：新建库时 Job 为空，迁移 12 不登记，待改写项手工写入
+    qDebug() << "\n[场景8] 旧合成ID重映射后的全文检索";
+    const QString remapDbPath = QDir::temp().filePath("crawler_remap_test.db");
+    QFile::remove(remapDbPath);
+    {
+        SQLInterface remapSql;
+        if (!remapSql.connectSqlite(remapDbPath) || !remapSql.createAllTables()) {
+            qDebug() << "❌ 临时库初始化失败";
+        } else if (!remapSql.hasFullTextIndex()) {
+            qDebug() << "⚠️  SQLite 不支持 FTS5 trigram，跳过";
+        } else {
+            SqlTask remapTask(&remapSql);
+            ::JobInfo legacyJob = mockJob1;
+            legacyJob.info_id = 777001;
+            legacyJob.company_id = 778001;
+            legacyJob.company_name = "RemapTest 重映射公司";
+            legacyJob.tag_names = {"重映射标签"};
+            legacyJob.tag_ids.clear();
+            remapTask.storeJobDataWithSource(legacyJob, 2);
+            {
+                QSqlDatabase raw = QSqlDatabase::addDatabase("QSQLITE", "remap_test_raw");
+                raw.setDatabaseName(remapDbPath);
+                if (raw.open()) {
+                    QSqlQuery(raw).exec("INSERT OR IGNORE INTO LegacyIdRemap(kind, legacyId) VALUES(0, 777001), (1, 778001)");
+                    raw.close();
+                }
+            }
+            QSqlDatabase::removeDatabase("remap_test_raw");
+
+            ::JobInfo stableJob = legacyJob;
+            stableJob.info_id = stable_synthetic_id("zhipin", "remap-test-job");
+            stableJob.legacy_info_id = legacyJob.info_id;
+            stableJob.company_id = stable_synthetic_id("zhipin", "remap-test-company");
+            stableJob.legacy_company_id = static_cast<int>(legacyJob.company_id);
+            const long long stableId = remapTask.storeJobDataWithSource(stableJob, 2);
+
+            const bool byTag = remapSql.searchJobIds("重映射标签").contains(stableId);
+            const bool byCompany = remapSql.searchJobIds("RemapTest").contains(stableId);
+            bool legacyGone = true;
+            for (const auto& dbJob : remapSql.queryAllJobs()) {
+                if (dbJob.jobId == legacyJob.info_id) legacyGone = false;
+            }
+            if (stableId == stableJob.info_id && legacyGone && byTag && byCompany) {
+                qDebug() << "✓ 旧ID行已改写为稳定ID，按标签与公司名均可检索";
+            } else {
+                qDebug() << "❌ 重映射后检索异常: 旧行已移除:" << legacyGone
+                         << " 标签命中:" << byTag << " 公司命中:" << byCompany;
+            }
+        }
+        remapSql.disconnect();
+    }
+    QFile::remove(remapDbPath);
+
     qDebug() << "\n✅ SqlTask 单元测试完成!\n";
 }